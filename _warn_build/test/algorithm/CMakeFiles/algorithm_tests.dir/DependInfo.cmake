@@ -0,0 +1,29 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/test/algorithm/src/closest_point.cpp" "test/algorithm/CMakeFiles/algorithm_tests.dir/src/closest_point.cpp.o" "gcc" "test/algorithm/CMakeFiles/algorithm_tests.dir/src/closest_point.cpp.o.d"
+  "/root/repo/test/algorithm/src/exact_orientation.cpp" "test/algorithm/CMakeFiles/algorithm_tests.dir/src/exact_orientation.cpp.o" "gcc" "test/algorithm/CMakeFiles/algorithm_tests.dir/src/exact_orientation.cpp.o.d"
+  "/root/repo/test/algorithm/src/magic_product.cpp" "test/algorithm/CMakeFiles/algorithm_tests.dir/src/magic_product.cpp.o" "gcc" "test/algorithm/CMakeFiles/algorithm_tests.dir/src/magic_product.cpp.o.d"
+  "/root/repo/test/algorithm/src/main.cpp" "test/algorithm/CMakeFiles/algorithm_tests.dir/src/main.cpp.o" "gcc" "test/algorithm/CMakeFiles/algorithm_tests.dir/src/main.cpp.o.d"
+  "/root/repo/test/algorithm/src/point_segment.cpp" "test/algorithm/CMakeFiles/algorithm_tests.dir/src/point_segment.cpp.o" "gcc" "test/algorithm/CMakeFiles/algorithm_tests.dir/src/point_segment.cpp.o.d"
+  "/root/repo/test/algorithm/src/point_triangle.cpp" "test/algorithm/CMakeFiles/algorithm_tests.dir/src/point_triangle.cpp.o" "gcc" "test/algorithm/CMakeFiles/algorithm_tests.dir/src/point_triangle.cpp.o.d"
+  "/root/repo/test/algorithm/src/segment_segment.cpp" "test/algorithm/CMakeFiles/algorithm_tests.dir/src/segment_segment.cpp.o" "gcc" "test/algorithm/CMakeFiles/algorithm_tests.dir/src/segment_segment.cpp.o.d"
+  "/root/repo/test/algorithm/src/segment_triangle.cpp" "test/algorithm/CMakeFiles/algorithm_tests.dir/src/segment_triangle.cpp.o" "gcc" "test/algorithm/CMakeFiles/algorithm_tests.dir/src/segment_triangle.cpp.o.d"
+  "/root/repo/test/algorithm/src/transform_triangles.cpp" "test/algorithm/CMakeFiles/algorithm_tests.dir/src/transform_triangles.cpp.o" "gcc" "test/algorithm/CMakeFiles/algorithm_tests.dir/src/transform_triangles.cpp.o.d"
+  "/root/repo/test/algorithm/src/triangle_block.cpp" "test/algorithm/CMakeFiles/algorithm_tests.dir/src/triangle_block.cpp.o" "gcc" "test/algorithm/CMakeFiles/algorithm_tests.dir/src/triangle_block.cpp.o.d"
+  "/root/repo/test/algorithm/src/triangle_triangle.cpp" "test/algorithm/CMakeFiles/algorithm_tests.dir/src/triangle_triangle.cpp.o" "gcc" "test/algorithm/CMakeFiles/algorithm_tests.dir/src/triangle_triangle.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
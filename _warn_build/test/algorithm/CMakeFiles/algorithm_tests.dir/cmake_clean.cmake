@@ -0,0 +1,32 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/algorithm_tests.dir/src/closest_point.cpp.o"
+  "CMakeFiles/algorithm_tests.dir/src/closest_point.cpp.o.d"
+  "CMakeFiles/algorithm_tests.dir/src/exact_orientation.cpp.o"
+  "CMakeFiles/algorithm_tests.dir/src/exact_orientation.cpp.o.d"
+  "CMakeFiles/algorithm_tests.dir/src/magic_product.cpp.o"
+  "CMakeFiles/algorithm_tests.dir/src/magic_product.cpp.o.d"
+  "CMakeFiles/algorithm_tests.dir/src/main.cpp.o"
+  "CMakeFiles/algorithm_tests.dir/src/main.cpp.o.d"
+  "CMakeFiles/algorithm_tests.dir/src/point_segment.cpp.o"
+  "CMakeFiles/algorithm_tests.dir/src/point_segment.cpp.o.d"
+  "CMakeFiles/algorithm_tests.dir/src/point_triangle.cpp.o"
+  "CMakeFiles/algorithm_tests.dir/src/point_triangle.cpp.o.d"
+  "CMakeFiles/algorithm_tests.dir/src/segment_segment.cpp.o"
+  "CMakeFiles/algorithm_tests.dir/src/segment_segment.cpp.o.d"
+  "CMakeFiles/algorithm_tests.dir/src/segment_triangle.cpp.o"
+  "CMakeFiles/algorithm_tests.dir/src/segment_triangle.cpp.o.d"
+  "CMakeFiles/algorithm_tests.dir/src/transform_triangles.cpp.o"
+  "CMakeFiles/algorithm_tests.dir/src/transform_triangles.cpp.o.d"
+  "CMakeFiles/algorithm_tests.dir/src/triangle_block.cpp.o"
+  "CMakeFiles/algorithm_tests.dir/src/triangle_block.cpp.o.d"
+  "CMakeFiles/algorithm_tests.dir/src/triangle_triangle.cpp.o"
+  "CMakeFiles/algorithm_tests.dir/src/triangle_triangle.cpp.o.d"
+  "algorithm_tests"
+  "algorithm_tests.pdb"
+  "algorithm_tests[1]_tests.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/algorithm_tests.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
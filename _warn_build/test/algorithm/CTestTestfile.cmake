@@ -0,0 +1,7 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test/algorithm
+# Build directory: /root/repo/_warn_build/test/algorithm
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+include("/root/repo/_warn_build/test/algorithm/algorithm_tests[1]_include.cmake")
@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_warn_build/test/algorithm/algorithm_tests[1]_tests.cmake")
+  include("/root/repo/_warn_build/test/algorithm/algorithm_tests[1]_tests.cmake")
+else()
+  add_test(algorithm_tests_NOT_BUILT algorithm_tests_NOT_BUILT)
+endif()
@@ -0,0 +1,89 @@
+add_test([=[Distance.Point_Segment]=]  /root/repo/_warn_build/test/algorithm/algorithm_tests [==[--gtest_filter=Distance.Point_Segment]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Distance.Point_Segment]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/algorithm SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Distance.Point_Triangle]=]  /root/repo/_warn_build/test/algorithm/algorithm_tests [==[--gtest_filter=Distance.Point_Triangle]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Distance.Point_Triangle]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/algorithm SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Exact_Orientation.2D_version]=]  /root/repo/_warn_build/test/algorithm/algorithm_tests [==[--gtest_filter=Exact_Orientation.2D_version]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Exact_Orientation.2D_version]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/algorithm SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Exact_Orientation.3D_version]=]  /root/repo/_warn_build/test/algorithm/algorithm_tests [==[--gtest_filter=Exact_Orientation.3D_version]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Exact_Orientation.3D_version]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/algorithm SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Exact_Orientation.Triangle_Triangle]=]  /root/repo/_warn_build/test/algorithm/algorithm_tests [==[--gtest_filter=Exact_Orientation.Triangle_Triangle]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Exact_Orientation.Triangle_Triangle]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/algorithm SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Exact_Orientation.Raw_Predicates]=]  /root/repo/_warn_build/test/algorithm/algorithm_tests [==[--gtest_filter=Exact_Orientation.Raw_Predicates]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Exact_Orientation.Raw_Predicates]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/algorithm SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Magic_Product.3D_version]=]  /root/repo/_warn_build/test/algorithm/algorithm_tests [==[--gtest_filter=Magic_Product.3D_version]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Magic_Product.3D_version]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/algorithm SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Magic_Product.Triangle_Plane]=]  /root/repo/_warn_build/test/algorithm/algorithm_tests [==[--gtest_filter=Magic_Product.Triangle_Plane]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Magic_Product.Triangle_Plane]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/algorithm SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Intersection.Point_Segment]=]  /root/repo/_warn_build/test/algorithm/algorithm_tests [==[--gtest_filter=Intersection.Point_Segment]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Intersection.Point_Segment]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/algorithm SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Intersection.Point_Triangle]=]  /root/repo/_warn_build/test/algorithm/algorithm_tests [==[--gtest_filter=Intersection.Point_Triangle]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Intersection.Point_Triangle]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/algorithm SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Intersection.Segment_Segment]=]  /root/repo/_warn_build/test/algorithm/algorithm_tests [==[--gtest_filter=Intersection.Segment_Segment]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Intersection.Segment_Segment]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/algorithm SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Intersection.Segment_Triangle]=]  /root/repo/_warn_build/test/algorithm/algorithm_tests [==[--gtest_filter=Intersection.Segment_Triangle]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Intersection.Segment_Triangle]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/algorithm SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Intersection.Triangle_Triangle_3D]=]  /root/repo/_warn_build/test/algorithm/algorithm_tests [==[--gtest_filter=Intersection.Triangle_Triangle_3D]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Intersection.Triangle_Triangle_3D]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/algorithm SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Intersection.Triangle_Triangle_2D_Easy_Cases]=]  /root/repo/_warn_build/test/algorithm/algorithm_tests [==[--gtest_filter=Intersection.Triangle_Triangle_2D_Easy_Cases]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Intersection.Triangle_Triangle_2D_Easy_Cases]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/algorithm SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Intersection.Triangle_Triangle_2D_R1]=]  /root/repo/_warn_build/test/algorithm/algorithm_tests [==[--gtest_filter=Intersection.Triangle_Triangle_2D_R1]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Intersection.Triangle_Triangle_2D_R1]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/algorithm SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Intersection.Triangle_Triangle_2D_R21]=]  /root/repo/_warn_build/test/algorithm/algorithm_tests [==[--gtest_filter=Intersection.Triangle_Triangle_2D_R21]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Intersection.Triangle_Triangle_2D_R21]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/algorithm SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Intersection.Triangle_Triangle_2D_R22_or_R25]=]  /root/repo/_warn_build/test/algorithm/algorithm_tests [==[--gtest_filter=Intersection.Triangle_Triangle_2D_R22_or_R25]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Intersection.Triangle_Triangle_2D_R22_or_R25]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/algorithm SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Intersection.Triangle_Triangle_2D_R24]=]  /root/repo/_warn_build/test/algorithm/algorithm_tests [==[--gtest_filter=Intersection.Triangle_Triangle_2D_R24]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Intersection.Triangle_Triangle_2D_R24]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/algorithm SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Intersection.Triangle_Triangle_2D_R22_or_R23]=]  /root/repo/_warn_build/test/algorithm/algorithm_tests [==[--gtest_filter=Intersection.Triangle_Triangle_2D_R22_or_R23]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Intersection.Triangle_Triangle_2D_R22_or_R23]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/algorithm SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Transform_Triangle.P_Above__Q_Above__R_On]=]  /root/repo/_warn_build/test/algorithm/algorithm_tests [==[--gtest_filter=Transform_Triangle.P_Above__Q_Above__R_On]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Transform_Triangle.P_Above__Q_Above__R_On]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/algorithm SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Transform_Triangle.P_Above__Q_Above__R_Below]=]  /root/repo/_warn_build/test/algorithm/algorithm_tests [==[--gtest_filter=Transform_Triangle.P_Above__Q_Above__R_Below]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Transform_Triangle.P_Above__Q_Above__R_Below]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/algorithm SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Transform_Triangle.P_Above__Q_On__R_Above]=]  /root/repo/_warn_build/test/algorithm/algorithm_tests [==[--gtest_filter=Transform_Triangle.P_Above__Q_On__R_Above]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Transform_Triangle.P_Above__Q_On__R_Above]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/algorithm SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Transform_Triangle.P_Above__Q_On__R_On]=]  /root/repo/_warn_build/test/algorithm/algorithm_tests [==[--gtest_filter=Transform_Triangle.P_Above__Q_On__R_On]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Transform_Triangle.P_Above__Q_On__R_On]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/algorithm SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Transform_Triangle.P_Above__Q_On__R_Below]=]  /root/repo/_warn_build/test/algorithm/algorithm_tests [==[--gtest_filter=Transform_Triangle.P_Above__Q_On__R_Below]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Transform_Triangle.P_Above__Q_On__R_Below]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/algorithm SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Transform_Triangle.P_Above__Q_Below__R_Above]=]  /root/repo/_warn_build/test/algorithm/algorithm_tests [==[--gtest_filter=Transform_Triangle.P_Above__Q_Below__R_Above]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Transform_Triangle.P_Above__Q_Below__R_Above]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/algorithm SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Transform_Triangle.P_Above__Q_Below__R_On]=]  /root/repo/_warn_build/test/algorithm/algorithm_tests [==[--gtest_filter=Transform_Triangle.P_Above__Q_Below__R_On]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Transform_Triangle.P_Above__Q_Below__R_On]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/algorithm SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Transform_Triangle.P_Above__Q_Below__R_Below]=]  /root/repo/_warn_build/test/algorithm/algorithm_tests [==[--gtest_filter=Transform_Triangle.P_Above__Q_Below__R_Below]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Transform_Triangle.P_Above__Q_Below__R_Below]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/algorithm SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Transform_Triangle.P_On__Q_Above__R_Above]=]  /root/repo/_warn_build/test/algorithm/algorithm_tests [==[--gtest_filter=Transform_Triangle.P_On__Q_Above__R_Above]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Transform_Triangle.P_On__Q_Above__R_Above]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/algorithm SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Transform_Triangle.P_On__Q_Above__R_On]=]  /root/repo/_warn_build/test/algorithm/algorithm_tests [==[--gtest_filter=Transform_Triangle.P_On__Q_Above__R_On]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Transform_Triangle.P_On__Q_Above__R_On]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/algorithm SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Transform_Triangle.P_On__Q_Above__R_Below]=]  /root/repo/_warn_build/test/algorithm/algorithm_tests [==[--gtest_filter=Transform_Triangle.P_On__Q_Above__R_Below]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Transform_Triangle.P_On__Q_Above__R_Below]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/algorithm SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Transform_Triangle.P_On__Q_On__R_Above]=]  /root/repo/_warn_build/test/algorithm/algorithm_tests [==[--gtest_filter=Transform_Triangle.P_On__Q_On__R_Above]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Transform_Triangle.P_On__Q_On__R_Above]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/algorithm SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Transform_Triangle.P_On__Q_On__R_Below]=]  /root/repo/_warn_build/test/algorithm/algorithm_tests [==[--gtest_filter=Transform_Triangle.P_On__Q_On__R_Below]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Transform_Triangle.P_On__Q_On__R_Below]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/algorithm SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Transform_Triangle.P_On__Q_Below__R_Above]=]  /root/repo/_warn_build/test/algorithm/algorithm_tests [==[--gtest_filter=Transform_Triangle.P_On__Q_Below__R_Above]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Transform_Triangle.P_On__Q_Below__R_Above]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/algorithm SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Transform_Triangle.P_On__Q_Below__R_On]=]  /root/repo/_warn_build/test/algorithm/algorithm_tests [==[--gtest_filter=Transform_Triangle.P_On__Q_Below__R_On]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Transform_Triangle.P_On__Q_Below__R_On]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/algorithm SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Transform_Triangle.P_On__Q_Below__R_Below]=]  /root/repo/_warn_build/test/algorithm/algorithm_tests [==[--gtest_filter=Transform_Triangle.P_On__Q_Below__R_Below]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Transform_Triangle.P_On__Q_Below__R_Below]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/algorithm SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Transform_Triangle.P_Below__Q_Above__R_Above]=]  /root/repo/_warn_build/test/algorithm/algorithm_tests [==[--gtest_filter=Transform_Triangle.P_Below__Q_Above__R_Above]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Transform_Triangle.P_Below__Q_Above__R_Above]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/algorithm SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Transform_Triangle.P_Below__Q_Above__R_On]=]  /root/repo/_warn_build/test/algorithm/algorithm_tests [==[--gtest_filter=Transform_Triangle.P_Below__Q_Above__R_On]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Transform_Triangle.P_Below__Q_Above__R_On]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/algorithm SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Transform_Triangle.P_Below__Q_Above__R_Below]=]  /root/repo/_warn_build/test/algorithm/algorithm_tests [==[--gtest_filter=Transform_Triangle.P_Below__Q_Above__R_Below]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Transform_Triangle.P_Below__Q_Above__R_Below]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/algorithm SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Transform_Triangle.P_Below__Q_On__R_Above]=]  /root/repo/_warn_build/test/algorithm/algorithm_tests [==[--gtest_filter=Transform_Triangle.P_Below__Q_On__R_Above]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Transform_Triangle.P_Below__Q_On__R_Above]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/algorithm SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Transform_Triangle.P_Below__Q_On__R_On]=]  /root/repo/_warn_build/test/algorithm/algorithm_tests [==[--gtest_filter=Transform_Triangle.P_Below__Q_On__R_On]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Transform_Triangle.P_Below__Q_On__R_On]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/algorithm SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Transform_Triangle.P_Below__Q_On__R_Below]=]  /root/repo/_warn_build/test/algorithm/algorithm_tests [==[--gtest_filter=Transform_Triangle.P_Below__Q_On__R_Below]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Transform_Triangle.P_Below__Q_On__R_Below]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/algorithm SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Transform_Triangle.P_Below__Q_Below__R_Above]=]  /root/repo/_warn_build/test/algorithm/algorithm_tests [==[--gtest_filter=Transform_Triangle.P_Below__Q_Below__R_Above]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Transform_Triangle.P_Below__Q_Below__R_Above]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/algorithm SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Transform_Triangle.P_Below__Q_Below__R_On]=]  /root/repo/_warn_build/test/algorithm/algorithm_tests [==[--gtest_filter=Transform_Triangle.P_Below__Q_Below__R_On]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Transform_Triangle.P_Below__Q_Below__R_On]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/algorithm SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Triangle_Block.Separated_By_Planes]=]  /root/repo/_warn_build/test/algorithm/algorithm_tests [==[--gtest_filter=Triangle_Block.Separated_By_Planes]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Triangle_Block.Separated_By_Planes]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/algorithm SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+set(  algorithm_tests_TESTS Distance.Point_Segment Distance.Point_Triangle Exact_Orientation.2D_version Exact_Orientation.3D_version Exact_Orientation.Triangle_Triangle Exact_Orientation.Raw_Predicates Magic_Product.3D_version Magic_Product.Triangle_Plane Intersection.Point_Segment Intersection.Point_Triangle Intersection.Segment_Segment Intersection.Segment_Triangle Intersection.Triangle_Triangle_3D Intersection.Triangle_Triangle_2D_Easy_Cases Intersection.Triangle_Triangle_2D_R1 Intersection.Triangle_Triangle_2D_R21 Intersection.Triangle_Triangle_2D_R22_or_R25 Intersection.Triangle_Triangle_2D_R24 Intersection.Triangle_Triangle_2D_R22_or_R23 Transform_Triangle.P_Above__Q_Above__R_On Transform_Triangle.P_Above__Q_Above__R_Below Transform_Triangle.P_Above__Q_On__R_Above Transform_Triangle.P_Above__Q_On__R_On Transform_Triangle.P_Above__Q_On__R_Below Transform_Triangle.P_Above__Q_Below__R_Above Transform_Triangle.P_Above__Q_Below__R_On Transform_Triangle.P_Above__Q_Below__R_Below Transform_Triangle.P_On__Q_Above__R_Above Transform_Triangle.P_On__Q_Above__R_On Transform_Triangle.P_On__Q_Above__R_Below Transform_Triangle.P_On__Q_On__R_Above Transform_Triangle.P_On__Q_On__R_Below Transform_Triangle.P_On__Q_Below__R_Above Transform_Triangle.P_On__Q_Below__R_On Transform_Triangle.P_On__Q_Below__R_Below Transform_Triangle.P_Below__Q_Above__R_Above Transform_Triangle.P_Below__Q_Above__R_On Transform_Triangle.P_Below__Q_Above__R_Below Transform_Triangle.P_Below__Q_On__R_Above Transform_Triangle.P_Below__Q_On__R_On Transform_Triangle.P_Below__Q_On__R_Below Transform_Triangle.P_Below__Q_Below__R_Above Transform_Triangle.P_Below__Q_Below__R_On Triangle_Block.Separated_By_Planes)
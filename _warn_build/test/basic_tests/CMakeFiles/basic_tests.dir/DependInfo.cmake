@@ -0,0 +1,28 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/test/basic_tests/src/collision_manager.cpp" "test/basic_tests/CMakeFiles/basic_tests.dir/src/collision_manager.cpp.o" "gcc" "test/basic_tests/CMakeFiles/basic_tests.dir/src/collision_manager.cpp.o.d"
+  "/root/repo/test/basic_tests/src/double_comparison.cpp" "test/basic_tests/CMakeFiles/basic_tests.dir/src/double_comparison.cpp.o" "gcc" "test/basic_tests/CMakeFiles/basic_tests.dir/src/double_comparison.cpp.o.d"
+  "/root/repo/test/basic_tests/src/main.cpp" "test/basic_tests/CMakeFiles/basic_tests.dir/src/main.cpp.o" "gcc" "test/basic_tests/CMakeFiles/basic_tests.dir/src/main.cpp.o.d"
+  "/root/repo/test/basic_tests/src/mpmc_queue.cpp" "test/basic_tests/CMakeFiles/basic_tests.dir/src/mpmc_queue.cpp.o" "gcc" "test/basic_tests/CMakeFiles/basic_tests.dir/src/mpmc_queue.cpp.o.d"
+  "/root/repo/test/basic_tests/src/octree_snapshot.cpp" "test/basic_tests/CMakeFiles/basic_tests.dir/src/octree_snapshot.cpp.o" "gcc" "test/basic_tests/CMakeFiles/basic_tests.dir/src/octree_snapshot.cpp.o.d"
+  "/root/repo/test/basic_tests/src/point.cpp" "test/basic_tests/CMakeFiles/basic_tests.dir/src/point.cpp.o" "gcc" "test/basic_tests/CMakeFiles/basic_tests.dir/src/point.cpp.o.d"
+  "/root/repo/test/basic_tests/src/result_sink.cpp" "test/basic_tests/CMakeFiles/basic_tests.dir/src/result_sink.cpp.o" "gcc" "test/basic_tests/CMakeFiles/basic_tests.dir/src/result_sink.cpp.o.d"
+  "/root/repo/test/basic_tests/src/segment.cpp" "test/basic_tests/CMakeFiles/basic_tests.dir/src/segment.cpp.o" "gcc" "test/basic_tests/CMakeFiles/basic_tests.dir/src/segment.cpp.o.d"
+  "/root/repo/test/basic_tests/src/triangle.cpp" "test/basic_tests/CMakeFiles/basic_tests.dir/src/triangle.cpp.o" "gcc" "test/basic_tests/CMakeFiles/basic_tests.dir/src/triangle.cpp.o.d"
+  "/root/repo/test/basic_tests/src/vector.cpp" "test/basic_tests/CMakeFiles/basic_tests.dir/src/vector.cpp.o" "gcc" "test/basic_tests/CMakeFiles/basic_tests.dir/src/vector.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
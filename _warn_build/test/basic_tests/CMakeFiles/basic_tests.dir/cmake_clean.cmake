@@ -0,0 +1,30 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/basic_tests.dir/src/collision_manager.cpp.o"
+  "CMakeFiles/basic_tests.dir/src/collision_manager.cpp.o.d"
+  "CMakeFiles/basic_tests.dir/src/double_comparison.cpp.o"
+  "CMakeFiles/basic_tests.dir/src/double_comparison.cpp.o.d"
+  "CMakeFiles/basic_tests.dir/src/main.cpp.o"
+  "CMakeFiles/basic_tests.dir/src/main.cpp.o.d"
+  "CMakeFiles/basic_tests.dir/src/mpmc_queue.cpp.o"
+  "CMakeFiles/basic_tests.dir/src/mpmc_queue.cpp.o.d"
+  "CMakeFiles/basic_tests.dir/src/octree_snapshot.cpp.o"
+  "CMakeFiles/basic_tests.dir/src/octree_snapshot.cpp.o.d"
+  "CMakeFiles/basic_tests.dir/src/point.cpp.o"
+  "CMakeFiles/basic_tests.dir/src/point.cpp.o.d"
+  "CMakeFiles/basic_tests.dir/src/result_sink.cpp.o"
+  "CMakeFiles/basic_tests.dir/src/result_sink.cpp.o.d"
+  "CMakeFiles/basic_tests.dir/src/segment.cpp.o"
+  "CMakeFiles/basic_tests.dir/src/segment.cpp.o.d"
+  "CMakeFiles/basic_tests.dir/src/triangle.cpp.o"
+  "CMakeFiles/basic_tests.dir/src/triangle.cpp.o.d"
+  "CMakeFiles/basic_tests.dir/src/vector.cpp.o"
+  "CMakeFiles/basic_tests.dir/src/vector.cpp.o.d"
+  "basic_tests"
+  "basic_tests.pdb"
+  "basic_tests[1]_tests.cmake"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/basic_tests.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,7 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test/basic_tests
+# Build directory: /root/repo/_warn_build/test/basic_tests
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+include("/root/repo/_warn_build/test/basic_tests/basic_tests[1]_include.cmake")
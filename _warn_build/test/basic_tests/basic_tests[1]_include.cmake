@@ -0,0 +1,5 @@
+if(EXISTS "/root/repo/_warn_build/test/basic_tests/basic_tests[1]_tests.cmake")
+  include("/root/repo/_warn_build/test/basic_tests/basic_tests[1]_tests.cmake")
+else()
+  add_test(basic_tests_NOT_BUILT basic_tests_NOT_BUILT)
+endif()
@@ -0,0 +1,135 @@
+add_test([=[Collision_Manager.Serial]=]  /root/repo/_warn_build/test/basic_tests/basic_tests [==[--gtest_filter=Collision_Manager.Serial]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Collision_Manager.Serial]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/basic_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Collision_Manager.Parallel]=]  /root/repo/_warn_build/test/basic_tests/basic_tests [==[--gtest_filter=Collision_Manager.Parallel]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Collision_Manager.Parallel]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/basic_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Collision_Manager.Pipeline]=]  /root/repo/_warn_build/test/basic_tests/basic_tests [==[--gtest_filter=Collision_Manager.Pipeline]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Collision_Manager.Pipeline]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/basic_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Collision_Manager.Set_Sink]=]  /root/repo/_warn_build/test/basic_tests/basic_tests [==[--gtest_filter=Collision_Manager.Set_Sink]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Collision_Manager.Set_Sink]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/basic_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Collision_Manager.Sweep_And_Prune]=]  /root/repo/_warn_build/test/basic_tests/basic_tests [==[--gtest_filter=Collision_Manager.Sweep_And_Prune]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Collision_Manager.Sweep_And_Prune]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/basic_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Collision_Manager.Sweep_And_Prune_Slabs]=]  /root/repo/_warn_build/test/basic_tests/basic_tests [==[--gtest_filter=Collision_Manager.Sweep_And_Prune_Slabs]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Collision_Manager.Sweep_And_Prune_Slabs]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/basic_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Collision_Manager.Sweep_And_Prune_Empty]=]  /root/repo/_warn_build/test/basic_tests/basic_tests [==[--gtest_filter=Collision_Manager.Sweep_And_Prune_Empty]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Collision_Manager.Sweep_And_Prune_Empty]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/basic_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Collision_Manager.BVH]=]  /root/repo/_warn_build/test/basic_tests/basic_tests [==[--gtest_filter=Collision_Manager.BVH]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Collision_Manager.BVH]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/basic_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Collision_Manager.Uniform_Grid]=]  /root/repo/_warn_build/test/basic_tests/basic_tests [==[--gtest_filter=Collision_Manager.Uniform_Grid]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Collision_Manager.Uniform_Grid]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/basic_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Collision_Manager.Uniform_Grid_No_Duplicates]=]  /root/repo/_warn_build/test/basic_tests/basic_tests [==[--gtest_filter=Collision_Manager.Uniform_Grid_No_Duplicates]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Collision_Manager.Uniform_Grid_No_Duplicates]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/basic_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Collision_Manager.Uniform_Grid_Oversized]=]  /root/repo/_warn_build/test/basic_tests/basic_tests [==[--gtest_filter=Collision_Manager.Uniform_Grid_Oversized]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Collision_Manager.Uniform_Grid_Oversized]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/basic_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Collision_Manager.Dynamic_Update]=]  /root/repo/_warn_build/test/basic_tests/basic_tests [==[--gtest_filter=Collision_Manager.Dynamic_Update]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Collision_Manager.Dynamic_Update]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/basic_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Collision_Manager.Dynamic_Remove]=]  /root/repo/_warn_build/test/basic_tests/basic_tests [==[--gtest_filter=Collision_Manager.Dynamic_Remove]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Collision_Manager.Dynamic_Remove]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/basic_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Collision_Manager.Dynamic_Out_Of_Bounds]=]  /root/repo/_warn_build/test/basic_tests/basic_tests [==[--gtest_filter=Collision_Manager.Dynamic_Out_Of_Bounds]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Collision_Manager.Dynamic_Out_Of_Bounds]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/basic_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Collision_Manager.Octree_Shape_Store]=]  /root/repo/_warn_build/test/basic_tests/basic_tests [==[--gtest_filter=Collision_Manager.Octree_Shape_Store]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Collision_Manager.Octree_Shape_Store]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/basic_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Collision_Manager.Pair_Callback]=]  /root/repo/_warn_build/test/basic_tests/basic_tests [==[--gtest_filter=Collision_Manager.Pair_Callback]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Collision_Manager.Pair_Callback]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/basic_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Collision_Manager.Pair_Stream]=]  /root/repo/_warn_build/test/basic_tests/basic_tests [==[--gtest_filter=Collision_Manager.Pair_Stream]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Collision_Manager.Pair_Stream]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/basic_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Collision_Manager.Any_Hit]=]  /root/repo/_warn_build/test/basic_tests/basic_tests [==[--gtest_filter=Collision_Manager.Any_Hit]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Collision_Manager.Any_Hit]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/basic_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Collision_Manager.Any_Hit_Dense]=]  /root/repo/_warn_build/test/basic_tests/basic_tests [==[--gtest_filter=Collision_Manager.Any_Hit_Dense]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Collision_Manager.Any_Hit_Dense]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/basic_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Collision_Manager.Loose_Octree]=]  /root/repo/_warn_build/test/basic_tests/basic_tests [==[--gtest_filter=Collision_Manager.Loose_Octree]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Collision_Manager.Loose_Octree]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/basic_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Collision_Manager.Loose_Octree_Depths]=]  /root/repo/_warn_build/test/basic_tests/basic_tests [==[--gtest_filter=Collision_Manager.Loose_Octree_Depths]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Collision_Manager.Loose_Octree_Depths]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/basic_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Collision_Manager.Adaptive_Octree]=]  /root/repo/_warn_build/test/basic_tests/basic_tests [==[--gtest_filter=Collision_Manager.Adaptive_Octree]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Collision_Manager.Adaptive_Octree]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/basic_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Collision_Manager.Adaptive_Octree_Sparse]=]  /root/repo/_warn_build/test/basic_tests/basic_tests [==[--gtest_filter=Collision_Manager.Adaptive_Octree_Sparse]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Collision_Manager.Adaptive_Octree_Sparse]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/basic_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Collision_Manager.Linear_Octree]=]  /root/repo/_warn_build/test/basic_tests/basic_tests [==[--gtest_filter=Collision_Manager.Linear_Octree]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Collision_Manager.Linear_Octree]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/basic_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Collision_Manager.Linear_Octree_Bulk]=]  /root/repo/_warn_build/test/basic_tests/basic_tests [==[--gtest_filter=Collision_Manager.Linear_Octree_Bulk]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Collision_Manager.Linear_Octree_Bulk]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/basic_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Collision_Manager.Shape_Record]=]  /root/repo/_warn_build/test/basic_tests/basic_tests [==[--gtest_filter=Collision_Manager.Shape_Record]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Collision_Manager.Shape_Record]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/basic_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Collision_Manager.Cross_Set]=]  /root/repo/_warn_build/test/basic_tests/basic_tests [==[--gtest_filter=Collision_Manager.Cross_Set]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Collision_Manager.Cross_Set]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/basic_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Collision_Manager.Ray_Cast]=]  /root/repo/_warn_build/test/basic_tests/basic_tests [==[--gtest_filter=Collision_Manager.Ray_Cast]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Collision_Manager.Ray_Cast]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/basic_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Collision_Manager.Ray_Packet]=]  /root/repo/_warn_build/test/basic_tests/basic_tests [==[--gtest_filter=Collision_Manager.Ray_Packet]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Collision_Manager.Ray_Packet]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/basic_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Collision_Manager.Nearest]=]  /root/repo/_warn_build/test/basic_tests/basic_tests [==[--gtest_filter=Collision_Manager.Nearest]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Collision_Manager.Nearest]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/basic_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Collision_Manager.Range_Query]=]  /root/repo/_warn_build/test/basic_tests/basic_tests [==[--gtest_filter=Collision_Manager.Range_Query]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Collision_Manager.Range_Query]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/basic_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Collision_Manager.Triangle_In_Box]=]  /root/repo/_warn_build/test/basic_tests/basic_tests [==[--gtest_filter=Collision_Manager.Triangle_In_Box]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Collision_Manager.Triangle_In_Box]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/basic_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Double_Comparison.Normalized]=]  /root/repo/_warn_build/test/basic_tests/basic_tests [==[--gtest_filter=Double_Comparison.Normalized]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Double_Comparison.Normalized]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/basic_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Double_Comparison.Subnormal]=]  /root/repo/_warn_build/test/basic_tests/basic_tests [==[--gtest_filter=Double_Comparison.Subnormal]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Double_Comparison.Subnormal]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/basic_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[MPMC_Queue.Capacity]=]  /root/repo/_warn_build/test/basic_tests/basic_tests [==[--gtest_filter=MPMC_Queue.Capacity]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[MPMC_Queue.Capacity]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/basic_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[MPMC_Queue.Concurrent]=]  /root/repo/_warn_build/test/basic_tests/basic_tests [==[--gtest_filter=MPMC_Queue.Concurrent]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[MPMC_Queue.Concurrent]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/basic_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Octree_Snapshot.Round_Trip]=]  /root/repo/_warn_build/test/basic_tests/basic_tests [==[--gtest_filter=Octree_Snapshot.Round_Trip]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Octree_Snapshot.Round_Trip]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/basic_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Octree_Snapshot.Validation]=]  /root/repo/_warn_build/test/basic_tests/basic_tests [==[--gtest_filter=Octree_Snapshot.Validation]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Octree_Snapshot.Validation]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/basic_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Octree_Snapshot.Scene_Stamp]=]  /root/repo/_warn_build/test/basic_tests/basic_tests [==[--gtest_filter=Octree_Snapshot.Scene_Stamp]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Octree_Snapshot.Scene_Stamp]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/basic_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Points.Equality]=]  /root/repo/_warn_build/test/basic_tests/basic_tests [==[--gtest_filter=Points.Equality]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Points.Equality]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/basic_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Points.Inequality]=]  /root/repo/_warn_build/test/basic_tests/basic_tests [==[--gtest_filter=Points.Inequality]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Points.Inequality]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/basic_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Points.Distance]=]  /root/repo/_warn_build/test/basic_tests/basic_tests [==[--gtest_filter=Points.Distance]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Points.Distance]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/basic_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Points.Validity]=]  /root/repo/_warn_build/test/basic_tests/basic_tests [==[--gtest_filter=Points.Validity]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Points.Validity]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/basic_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Points.Comparison_Policy]=]  /root/repo/_warn_build/test/basic_tests/basic_tests [==[--gtest_filter=Points.Comparison_Policy]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Points.Comparison_Policy]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/basic_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Result_Sink.Bitset]=]  /root/repo/_warn_build/test/basic_tests/basic_tests [==[--gtest_filter=Result_Sink.Bitset]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Result_Sink.Bitset]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/basic_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Result_Sink.Set]=]  /root/repo/_warn_build/test/basic_tests/basic_tests [==[--gtest_filter=Result_Sink.Set]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Result_Sink.Set]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/basic_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Result_Sink.Buffer]=]  /root/repo/_warn_build/test/basic_tests/basic_tests [==[--gtest_filter=Result_Sink.Buffer]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Result_Sink.Buffer]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/basic_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Result_Sink.Dump]=]  /root/repo/_warn_build/test/basic_tests/basic_tests [==[--gtest_filter=Result_Sink.Dump]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Result_Sink.Dump]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/basic_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Segments.Swap_Points]=]  /root/repo/_warn_build/test/basic_tests/basic_tests [==[--gtest_filter=Segments.Swap_Points]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Segments.Swap_Points]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/basic_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Segments.Is_Point]=]  /root/repo/_warn_build/test/basic_tests/basic_tests [==[--gtest_filter=Segments.Is_Point]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Segments.Is_Point]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/basic_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Triangles.Swap_QR]=]  /root/repo/_warn_build/test/basic_tests/basic_tests [==[--gtest_filter=Triangles.Swap_QR]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Triangles.Swap_QR]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/basic_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Triangles.Swap_Clockwise]=]  /root/repo/_warn_build/test/basic_tests/basic_tests [==[--gtest_filter=Triangles.Swap_Clockwise]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Triangles.Swap_Clockwise]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/basic_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Triangles.Swap_Counterclockwise]=]  /root/repo/_warn_build/test/basic_tests/basic_tests [==[--gtest_filter=Triangles.Swap_Counterclockwise]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Triangles.Swap_Counterclockwise]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/basic_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Triangles.Is_Point]=]  /root/repo/_warn_build/test/basic_tests/basic_tests [==[--gtest_filter=Triangles.Is_Point]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Triangles.Is_Point]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/basic_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Triangles.Is_Segment]=]  /root/repo/_warn_build/test/basic_tests/basic_tests [==[--gtest_filter=Triangles.Is_Segment]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Triangles.Is_Segment]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/basic_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Vectors.Equality]=]  /root/repo/_warn_build/test/basic_tests/basic_tests [==[--gtest_filter=Vectors.Equality]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Vectors.Equality]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/basic_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Vectors.Inequality]=]  /root/repo/_warn_build/test/basic_tests/basic_tests [==[--gtest_filter=Vectors.Inequality]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Vectors.Inequality]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/basic_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Vectors.Addition]=]  /root/repo/_warn_build/test/basic_tests/basic_tests [==[--gtest_filter=Vectors.Addition]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Vectors.Addition]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/basic_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Vectors.Subtraction]=]  /root/repo/_warn_build/test/basic_tests/basic_tests [==[--gtest_filter=Vectors.Subtraction]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Vectors.Subtraction]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/basic_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Vectors.Multiplication]=]  /root/repo/_warn_build/test/basic_tests/basic_tests [==[--gtest_filter=Vectors.Multiplication]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Vectors.Multiplication]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/basic_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Vectors.Inversion]=]  /root/repo/_warn_build/test/basic_tests/basic_tests [==[--gtest_filter=Vectors.Inversion]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Vectors.Inversion]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/basic_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Vectors.Module]=]  /root/repo/_warn_build/test/basic_tests/basic_tests [==[--gtest_filter=Vectors.Module]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Vectors.Module]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/basic_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Vectors.Is_Zero]=]  /root/repo/_warn_build/test/basic_tests/basic_tests [==[--gtest_filter=Vectors.Is_Zero]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Vectors.Is_Zero]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/basic_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Vectors.Scalar_Product]=]  /root/repo/_warn_build/test/basic_tests/basic_tests [==[--gtest_filter=Vectors.Scalar_Product]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Vectors.Scalar_Product]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/basic_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Vectors.Vector_Product]=]  /root/repo/_warn_build/test/basic_tests/basic_tests [==[--gtest_filter=Vectors.Vector_Product]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Vectors.Vector_Product]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/basic_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Vectors.Ctor_From_Points]=]  /root/repo/_warn_build/test/basic_tests/basic_tests [==[--gtest_filter=Vectors.Ctor_From_Points]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Vectors.Ctor_From_Points]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/basic_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+add_test([=[Vectors.Raw_Comparison]=]  /root/repo/_warn_build/test/basic_tests/basic_tests [==[--gtest_filter=Vectors.Raw_Comparison]==] --gtest_also_run_disabled_tests)
+set_tests_properties([=[Vectors.Raw_Comparison]=]  PROPERTIES WORKING_DIRECTORY /root/repo/_warn_build/test/basic_tests SKIP_REGULAR_EXPRESSION [==[\[  SKIPPED \]]==])
+set(  basic_tests_TESTS Collision_Manager.Serial Collision_Manager.Parallel Collision_Manager.Pipeline Collision_Manager.Set_Sink Collision_Manager.Sweep_And_Prune Collision_Manager.Sweep_And_Prune_Slabs Collision_Manager.Sweep_And_Prune_Empty Collision_Manager.BVH Collision_Manager.Uniform_Grid Collision_Manager.Uniform_Grid_No_Duplicates Collision_Manager.Uniform_Grid_Oversized Collision_Manager.Dynamic_Update Collision_Manager.Dynamic_Remove Collision_Manager.Dynamic_Out_Of_Bounds Collision_Manager.Octree_Shape_Store Collision_Manager.Pair_Callback Collision_Manager.Pair_Stream Collision_Manager.Any_Hit Collision_Manager.Any_Hit_Dense Collision_Manager.Loose_Octree Collision_Manager.Loose_Octree_Depths Collision_Manager.Adaptive_Octree Collision_Manager.Adaptive_Octree_Sparse Collision_Manager.Linear_Octree Collision_Manager.Linear_Octree_Bulk Collision_Manager.Shape_Record Collision_Manager.Cross_Set Collision_Manager.Ray_Cast Collision_Manager.Ray_Packet Collision_Manager.Nearest Collision_Manager.Range_Query Collision_Manager.Triangle_In_Box Double_Comparison.Normalized Double_Comparison.Subnormal MPMC_Queue.Capacity MPMC_Queue.Concurrent Octree_Snapshot.Round_Trip Octree_Snapshot.Validation Octree_Snapshot.Scene_Stamp Points.Equality Points.Inequality Points.Distance Points.Validity Points.Comparison_Policy Result_Sink.Bitset Result_Sink.Set Result_Sink.Buffer Result_Sink.Dump Segments.Swap_Points Segments.Is_Point Triangles.Swap_QR Triangles.Swap_Clockwise Triangles.Swap_Counterclockwise Triangles.Is_Point Triangles.Is_Segment Vectors.Equality Vectors.Inequality Vectors.Addition Vectors.Subtraction Vectors.Multiplication Vectors.Inversion Vectors.Module Vectors.Is_Zero Vectors.Scalar_Product Vectors.Vector_Product Vectors.Ctor_From_Points Vectors.Raw_Comparison)
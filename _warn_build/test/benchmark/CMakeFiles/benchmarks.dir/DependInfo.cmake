@@ -0,0 +1,21 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/test/benchmark/src/engines.cpp" "test/benchmark/CMakeFiles/benchmarks.dir/src/engines.cpp.o" "gcc" "test/benchmark/CMakeFiles/benchmarks.dir/src/engines.cpp.o.d"
+  "/root/repo/test/benchmark/src/kernels.cpp" "test/benchmark/CMakeFiles/benchmarks.dir/src/kernels.cpp.o" "gcc" "test/benchmark/CMakeFiles/benchmarks.dir/src/kernels.cpp.o.d"
+  "/root/repo/test/benchmark/src/main.cpp" "test/benchmark/CMakeFiles/benchmarks.dir/src/main.cpp.o" "gcc" "test/benchmark/CMakeFiles/benchmarks.dir/src/main.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/benchmarks.dir/src/engines.cpp.o"
+  "CMakeFiles/benchmarks.dir/src/engines.cpp.o.d"
+  "CMakeFiles/benchmarks.dir/src/kernels.cpp.o"
+  "CMakeFiles/benchmarks.dir/src/kernels.cpp.o.d"
+  "CMakeFiles/benchmarks.dir/src/main.cpp.o"
+  "CMakeFiles/benchmarks.dir/src/main.cpp.o.d"
+  "benchmarks"
+  "benchmarks.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/benchmarks.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
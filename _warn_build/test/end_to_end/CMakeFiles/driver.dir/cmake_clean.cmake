@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/driver.dir/src/driver.cpp.o"
+  "CMakeFiles/driver.dir/src/driver.cpp.o.d"
+  "driver"
+  "driver.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/driver.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/generator.dir/src/generator.cpp.o"
+  "CMakeFiles/generator.dir/src/generator.cpp.o.d"
+  "generator"
+  "generator.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/generator.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
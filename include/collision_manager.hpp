@@ -4,8 +4,17 @@
 #include <iostream>
 #include <vector>
 #include <iterator>
-#include <set>
 #include <memory>
+#include <thread>
+#include <stop_token>
+#include <atomic>
+#include <algorithm>
+#include <utility>
+#include <optional>
+#include <array>
+#include <span>
+#include <type_traits>
+#include <stdexcept>
 
 #include "point_point.hpp"
 #include "point_segment.hpp"
@@ -13,8 +22,15 @@
 #include "segment_segment.hpp"
 #include "segment_triangle.hpp"
 #include "triangle_triangle.hpp"
+#include "triangle_block.hpp"
+#include "triangle_plane.hpp"
+
+#include "mpmc_queue.hpp"
+#include "stream.hpp"
+#include "result_sink.hpp"
 
 #include "shape.hpp"
+#include "broad_phase.hpp"
 #include "octree.hpp"
 
 namespace yLab
@@ -23,71 +39,668 @@ namespace yLab
 namespace geometry
 {
 
-template<typename T, typename U = Indexed_Shape<T>>
+struct Invalid_Index final: public std::runtime_error
+{
+    Invalid_Index () : std::runtime_error{"The index of a shape is out of range of the scene"} {}
+};
+
+template<typename T, typename U = Indexed_Shape<T>, Broad_Phase B = Octree<T, U>,
+         Result_Sink S = Bitset_Sink>
+requires std::same_as<U, typename B::shape_type>
 class Collision_Manager final
 {
 public:
 
     using distance_type = T;
     using shape_type = U;
-    using node_type = typename Octree<distance_type, shape_type>::node_type;
+    using broad_phase_type = B;
+    using sink_type = S;
+    using size_type = std::size_t;
+
+    struct Index_Pair final
+    {
+        size_type first;
+        size_type second;
+    };
 
 private:
 
-    Octree<distance_type> octree_;
-    std::vector<node_type *> ancestor_stack_;
-    std::set<std::size_t> indexes_; // unique sorted indexes are contained
+    // Copies of shapes whose bounding volumes overlap: engines may pass shapes built only
+    // for the call of a visitor
+    struct Candidate_Pair final
+    {
+        std::optional<shape_type> first;
+        std::optional<shape_type> second;
+    };
+
+    using queue_type = MPMC_Queue<Candidate_Pair>;
+
+    using triangle_type = typename Primitive_Traits<distance_type>::triangle_type;
+    using plane_type = Triangle_Plane<distance_type>;
+    using plane_span = std::span<const plane_type>;
+
+    broad_phase_type broad_phase_;
+    size_type n_indexes_;
+    sink_type indexes_;
+    std::vector<size_type> n_intersections_; // filled on the first update of a dynamic scene
+
+    // Planes of triangles by their indexes, so that the narrow phase doesn't recompute them
+    // for every pair. The cache is optional: it's empty if the engine is given built, and
+    // then planes are computed by every test
+    std::vector<plane_type> planes_;
+
+    // Cross queries use the plane cache of the other scene
+    template<typename V, typename W, Broad_Phase C, Result_Sink R>
+    requires std::same_as<W, typename C::shape_type>
+    friend class Collision_Manager;
 
 public:
 
-    template<std::input_iterator it>
-    Collision_Manager (it first, it last) : octree_{first, last}
+    template<std::forward_iterator it>
+    Collision_Manager (it first, it last)
+                      : broad_phase_{first, last}, n_indexes_{max_index (first, last) + 1},
+                        indexes_{n_indexes_}, planes_{planes_of (first, last, n_indexes_)} {}
+
+    // Takes a built engine; n_indexes is the greatest index of a shape + 1
+    Collision_Manager (broad_phase_type &&broad_phase, size_type n_indexes)
+                      : broad_phase_{std::move (broad_phase)}, n_indexes_{n_indexes},
+                        indexes_{n_indexes_} {}
+
+    const broad_phase_type &broad_phase () const { return broad_phase_; }
+
+    void intersect_all ()
     {
-        auto n_shapes = octree_.size();
+        auto visit = intersecting_pairs_reporter ([this](std::size_t index)
+        {
+            indexes_.insert (index);
+        });
 
-        ancestor_stack_.reserve (n_shapes);
+        broad_phase_.for_each_candidate (visit);
+        visit.flush();
     }
 
-    void intersect_all () { intersect_all (std::addressof (octree_.root())); }
-
-    void show_intersecting () const
+    // The result doesn't depend on n_threads: every thread collects indexes in its own buffer
+    // and passes them to the shared sink in batches
+    void intersect_all (size_type n_threads)
     {
-        for (auto &&index : indexes_)
-            std::cout << index << " ";
-        std::cout << std::endl;
+        if (n_threads <= 1)
+        {
+            intersect_all ();
+            return;
+        }
+
+        run_tasks (n_threads, [this](auto &process)
+        {
+            Sink_Buffer buffer{indexes_};
+            auto visit = intersecting_pairs_reporter ([&buffer](std::size_t index)
+            {
+                buffer.insert (index);
+            });
+
+            process (visit);
+            visit.flush();
+        });
     }
 
-private:
+    /*
+     * Any-hit mode: the result is the same as the one of intersect_all (), but a pair is skipped
+     * before the narrow phase if both its shapes are already known to intersect something.
+     * Shapes found intersecting are flagged in a shared bitset at once rather than in batches.
+     * Returns the number of narrow phase tests run.
+     */
+    size_type intersect_any (size_type n_threads = 1)
+    {
+        Bitset_Sink flagged{n_indexes_};
+        std::atomic<size_type> n_tests{0};
+
+        auto work = [this, &flagged, &n_tests](auto &process)
+        {
+            size_type n_local_tests = 0;
 
-    void intersect_all (node_type *root)
+            auto visit = [&](const shape_type &shape_1, const shape_type &shape_2)
+            {
+                if (flagged.contains (shape_1.index()) && flagged.contains (shape_2.index()))
+                    return;
+
+                ++n_local_tests;
+                if (test_pair (shape_1, planes_, shape_2, planes_))
+                {
+                    flagged.insert (shape_1.index());
+                    flagged.insert (shape_2.index());
+                }
+            };
+
+            process (visit);
+            n_tests += n_local_tests;
+        };
+
+        if (n_threads <= 1)
+        {
+            auto process = [this](auto &visit) { broad_phase_.for_each_candidate (visit); };
+            work (process);
+        }
+        else
+            run_tasks (n_threads, work);
+
+        flagged.for_each ([this](size_type index) { indexes_.insert (index); });
+
+        return n_tests;
+    }
+
+    /*
+     * Broad and narrow phases run on separate threads. Producers run tasks of the broad phase
+     * engine and push pairs of shapes with overlapping bounding volumes into bounded lock-free
+     * queues (one per producer); consumers drain all queues and run exact intersection tests.
+     * As in the previous mode, the result doesn't depend on the number of threads.
+     */
+    void intersect_all (size_type n_producers, size_type n_consumers,
+                        size_type queue_capacity = default_queue_capacity_)
     {
-        ancestor_stack_.emplace_back (root);
+        n_producers = std::max (n_producers, size_type{1});
+        n_consumers = std::max (n_consumers, size_type{1});
+
+        auto tasks = broad_phase_.split (n_producers * tasks_per_thread_);
+        std::atomic<size_type> next_task{0};
 
-        for (auto n = 0; n != ancestor_stack_.size(); ++n)
+        std::vector<std::unique_ptr<queue_type>> queues;
+        queues.reserve (n_producers);
+        for (size_type i = 0; i != n_producers; ++i)
+            queues.push_back (std::make_unique<queue_type>(queue_capacity));
+
+        std::atomic<size_type> n_active_producers{n_producers};
+
+        auto producer = [&](size_type producer_i)
         {
-            for (auto &&shape_1 : ancestor_stack_[n]->shapes())
+            auto &queue = *queues[producer_i];
+            auto visit = [&queue](const shape_type &shape_1, const shape_type &shape_2)
             {
-                for (auto &&shape_2 : root->shapes())
+                if (are_overlapping (shape_1.bounding_volume(), shape_2.bounding_volume()))
                 {
-                    if (std::addressof (shape_1) == std::addressof (shape_2))
-                        break;
+                    Candidate_Pair pair{shape_1, shape_2};
+                    while (!queue.try_push (pair))
+                        std::this_thread::yield();
+                }
+            };
 
-                    if (are_intersecting (shape_1, shape_2))
+            for (auto task_i = next_task++; task_i < tasks.size(); task_i = next_task++)
+                broad_phase_.for_each_candidate (tasks[task_i], visit);
+
+            n_active_producers.fetch_sub (1, std::memory_order_release);
+        };
+
+        auto consumer = [&](size_type consumer_i)
+        {
+            Sink_Buffer buffer{indexes_};
+            Candidate_Pair pair;
+
+            for (auto queue_i = consumer_i % n_producers;; queue_i = (queue_i + 1) % n_producers)
+            {
+                // Producers are checked before the queues so that no pair pushed before
+                // the last producer had finished is missed
+                auto finished = (n_active_producers.load (std::memory_order_acquire) == 0);
+                auto found = false;
+
+                for (size_type i = 0; i != n_producers; ++i)
+                {
+                    auto &queue = *queues[(queue_i + i) % n_producers];
+
+                    while (queue.try_pop (pair))
                     {
-                        indexes_.emplace(shape_1.index());
-                        indexes_.emplace(shape_2.index());
+                        found = true;
+                        if (test_primitives (*pair.first, planes_, *pair.second, planes_))
+                        {
+                            buffer.insert (pair.first->index());
+                            buffer.insert (pair.second->index());
+                        }
                     }
                 }
+
+                if (!found)
+                {
+                    if (finished)
+                        break;
+                    std::this_thread::yield();
+                }
             }
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve (n_producers + n_consumers);
+
+        for (size_type i = 0; i != n_producers; ++i)
+            threads.emplace_back (producer, i);
+        for (size_type i = 0; i != n_consumers; ++i)
+            threads.emplace_back (consumer, i);
+
+        for (auto &thread : threads)
+            thread.join();
+    }
+
+    const sink_type &intersecting () const { return indexes_; }
+
+    // Streaming of intersecting pairs: every pair is passed once as soon as it's found.
+    // The order of pairs is unspecified
+
+    template<typename F>
+    void for_each_intersecting_pair (F callback) const
+    {
+        auto visit = intersecting_pairs_callback (callback, planes_);
+        broad_phase_.for_each_candidate (visit);
+        visit.flush();
+    }
+
+    // callback is called concurrently by n_threads threads
+    template<typename F>
+    void for_each_intersecting_pair (F callback, size_type n_threads) const
+    {
+        if (n_threads <= 1)
+        {
+            for_each_intersecting_pair (callback);
+            return;
         }
 
-        for (auto i = 0; i != 8; ++i)
+        run_tasks (n_threads, [this, &callback](auto &process)
         {
-            if (root->child(i))
-                intersect_all (root->child(i));
+            auto visit = intersecting_pairs_callback (callback, planes_);
+            process (visit);
+            visit.flush();
+        });
+    }
+
+    // Lazy range of pairs found by a background thread. The manager mustn't be modified
+    // or destroyed while the range exists. The broad phase runs task by task, so destroying
+    // the range stops the traversal after the current task; candidates found in the meantime
+    // skip the narrow phase
+    Stream<Index_Pair> intersecting_pairs (size_type queue_capacity = default_queue_capacity_) const
+    {
+        return Stream<Index_Pair>{[this](auto emit, std::stop_token stop)
+        {
+            auto report = [&emit](const Index_Pair &pair) { emit (pair); };
+            auto narrow_phase = intersecting_pairs_callback (report, planes_);
+
+            auto visit = [&](const shape_type &shape_1, const shape_type &shape_2)
+            {
+                if (!stop.stop_requested())
+                    narrow_phase (shape_1, shape_2);
+            };
+
+            for (auto &task : broad_phase_.split (stream_tasks_))
+            {
+                if (stop.stop_requested())
+                    return;
+
+                broad_phase_.for_each_candidate (task, visit);
+            }
+
+            narrow_phase.flush();
+        }, queue_capacity};
+    }
+
+    // Clash detection between two scenes built independently (e.g. piping against structure):
+    // only pairs with one shape from each scene are tested
+
+    // Indexes of the shapes of this scene intersecting shapes of other are added to the result
+    template<Broad_Phase C, Result_Sink R>
+    requires Cross_Broad_Phase<broad_phase_type, C>
+    void intersect_with (const Collision_Manager<T, U, C, R> &other)
+    {
+        Batched_Narrow_Phase visit{[this](const shape_type &shape, const shape_type &)
+        {
+            indexes_.insert (shape.index());
+        }, planes_, other.planes_};
+
+        broad_phase_.for_each_cross_candidate (other.broad_phase(), visit);
+        visit.flush();
+    }
+
+    // first is the index of a shape of this scene, second is the index of a shape of other
+    template<Broad_Phase C, Result_Sink R, typename F>
+    requires Cross_Broad_Phase<broad_phase_type, C>
+    void for_each_intersecting_pair (const Collision_Manager<T, U, C, R> &other, F callback) const
+    {
+        auto visit = intersecting_pairs_callback (callback, other.planes_);
+        broad_phase_.for_each_cross_candidate (other.broad_phase(), visit);
+        visit.flush();
+    }
+
+    // Dynamic scenes. Only pairs containing the moved or removed shape are retested; the number
+    // of intersections of every shape is kept so that the result stays correct without calling
+    // intersect_all () again. The first call counts intersections of all shapes
+
+    // new_shape has to have the same index as old_shape, or Invalid_Index is thrown. Returns
+    // false if there is no old_shape
+    bool update (const shape_type &old_shape, const shape_type &new_shape)
+    requires Dynamic_Broad_Phase<broad_phase_type>
+    {
+        if (new_shape.index() != old_shape.index())
+            throw Invalid_Index{};
+        check_index (old_shape.index());
+
+        count_intersections ();
+
+        if (!broad_phase_.update (old_shape, new_shape))
+            return false;
+
+        retest_neighbours (old_shape, -1);
+        retest_neighbours (new_shape, +1);
+
+        if (!planes_.empty())
+        {
+            if (auto tr = triangle_of (new_shape))
+                planes_[new_shape.index()] = plane_type{*tr};
         }
 
-        ancestor_stack_.pop_back();
+        return true;
+    }
+
+    bool remove (const shape_type &shape) requires Dynamic_Broad_Phase<broad_phase_type>
+    {
+        check_index (shape.index());
+
+        count_intersections ();
+
+        if (!broad_phase_.erase (shape))
+            return false;
+
+        retest_neighbours (shape, -1);
+
+        return true;
+    }
+
+    size_type n_intersections (size_type index) requires Dynamic_Broad_Phase<broad_phase_type>
+    {
+        check_index (index);
+
+        count_intersections ();
+        return n_intersections_[index];
+    }
+
+    void show_intersecting () const { indexes_.dump (std::cout); }
+
+private:
+
+    static constexpr size_type tasks_per_thread_ = 4;
+    static constexpr size_type stream_tasks_ = 64;
+    static constexpr size_type default_queue_capacity_ = 1 << 14;
+
+    template<std::forward_iterator it>
+    static std::size_t max_index (it first, it last)
+    {
+        std::size_t max = 0;
+        for (; first != last; ++first)
+            max = std::max (max, static_cast<std::size_t>(first->index()));
+
+        return max;
+    }
+
+    template<std::forward_iterator it>
+    static std::vector<plane_type> planes_of (it first, it last, size_type n_indexes)
+    {
+        std::vector<plane_type> planes (n_indexes);
+        for (; first != last; ++first)
+        {
+            if (auto tr = triangle_of (*first))
+                planes[first->index()] = plane_type{*tr};
+        }
+
+        return planes;
+    }
+
+    // Every thread calls work (process); process (visit) runs the tasks left with visit
+    template<typename F>
+    void run_tasks (size_type n_threads, F work) const
+    {
+        auto tasks = broad_phase_.split (n_threads * tasks_per_thread_);
+        std::atomic<size_type> next_task{0};
+
+        auto process = [this, &tasks, &next_task](auto &visit)
+        {
+            for (auto task_i = next_task++; task_i < tasks.size(); task_i = next_task++)
+                broad_phase_.for_each_candidate (tasks[task_i], visit);
+        };
+
+        auto worker = [&work, &process] { work (process); };
+
+        std::vector<std::thread> threads;
+        threads.reserve (n_threads - 1);
+
+        for (size_type i = 1; i != n_threads; ++i)
+            threads.emplace_back (worker);
+        worker();
+
+        for (auto &thread : threads)
+            thread.join();
+    }
+
+    // Indexes of a scene are fixed at construction: they size the counters and the sink
+    void check_index (size_type index) const
+    {
+        if (index >= n_indexes_)
+            throw Invalid_Index{};
+    }
+
+    void count_intersections ()
+    {
+        if (!n_intersections_.empty())
+            return;
+
+        n_intersections_.assign (n_indexes_, 0);
+
+        auto visit = [this](const shape_type &shape_1, const shape_type &shape_2)
+        {
+            if (test_pair (shape_1, planes_, shape_2, planes_))
+            {
+                ++n_intersections_[shape_1.index()];
+                ++n_intersections_[shape_2.index()];
+            }
+        };
+
+        broad_phase_.for_each_candidate (visit);
+
+        for (size_type index = 0; index != n_indexes_; ++index)
+        {
+            if (n_intersections_[index])
+                indexes_.insert (index);
+        }
+    }
+
+    // Adds (delta == 1) or subtracts (delta == -1) intersections of the shape
+    // with the shapes of the broad phase engine
+    void retest_neighbours (const shape_type &shape, int delta)
+    {
+        auto visit = [&](const shape_type &neighbour)
+        {
+            if (are_intersecting (shape, neighbour))
+            {
+                change_n_intersections (shape.index(), delta);
+                change_n_intersections (neighbour.index(), delta);
+            }
+        };
+
+        broad_phase_.for_each_neighbour (shape, visit);
+    }
+
+    void change_n_intersections (size_type index, int delta)
+    {
+        auto &n_intersections = n_intersections_[index];
+
+        if (delta > 0 && n_intersections++ == 0)
+            indexes_.insert (index);
+        else if (delta < 0 && --n_intersections == 0)
+            indexes_.erase (index);
+    }
+
+    // The shape may be of another type, e.g. Indexed_Shape the engine is built from
+    template<typename V>
+    static const triangle_type *triangle_of (const V &shape)
+    {
+        return detail::visit_primitive (shape, [](const auto &primitive) -> const triangle_type *
+        {
+            if constexpr (std::is_same_v<std::remove_cvref_t<decltype (primitive)>, triangle_type>)
+                return std::addressof (primitive);
+            else
+                return nullptr;
+        });
+    }
+
+    // The plane of the triangle of the shape: from the cache of its scene unless it's empty
+    static plane_type plane_of (const shape_type &shape, const triangle_type &tr,
+                                plane_span planes)
+    {
+        return planes.empty() ? plane_type{tr} : planes[shape.index()];
+    }
+
+    // are_primitives_intersecting () with planes of triangles taken from the caches of scenes
+    // of the shapes
+    static bool test_primitives (const shape_type &shape_1, plane_span planes_1,
+                                 const shape_type &shape_2, plane_span planes_2)
+    {
+        return detail::visit_primitive (shape_1, [&](const auto &primitive_1)
+        {
+            return detail::visit_primitive (shape_2, [&](const auto &primitive_2)
+            {
+                using type_1 = std::remove_cvref_t<decltype (primitive_1)>;
+                using type_2 = std::remove_cvref_t<decltype (primitive_2)>;
+                using segment_type = typename Primitive_Traits<distance_type>::segment_type;
+
+                constexpr auto is_triangle_1 = std::is_same_v<type_1, triangle_type>;
+                constexpr auto is_triangle_2 = std::is_same_v<type_2, triangle_type>;
+
+                if constexpr (is_triangle_1 && is_triangle_2)
+                    return are_intersecting (primitive_1,
+                                             plane_of (shape_1, primitive_1, planes_1),
+                                             primitive_2,
+                                             plane_of (shape_2, primitive_2, planes_2));
+                else if constexpr (std::is_same_v<type_1, segment_type> && is_triangle_2)
+                    return are_intersecting (primitive_1, primitive_2,
+                                             plane_of (shape_2, primitive_2, planes_2));
+                else if constexpr (is_triangle_1 && std::is_same_v<type_2, segment_type>)
+                    return are_intersecting (primitive_2, primitive_1,
+                                             plane_of (shape_1, primitive_1, planes_1));
+                else
+                    return are_intersecting (primitive_1, primitive_2);
+            });
+        });
+    }
+
+    // are_intersecting () with planes of triangles taken from the caches
+    static bool test_pair (const shape_type &shape_1, plane_span planes_1,
+                           const shape_type &shape_2, plane_span planes_2)
+    {
+        return are_overlapping (shape_1, shape_2) &&
+               test_primitives (shape_1, planes_1, shape_2, planes_2);
+    }
+
+    /*
+     * Narrow phase visitor calling on_intersection (shape_1, shape_2) for intersecting
+     * candidates. Consecutive candidates of two triangles that share the first shape (as
+     * a broad phase visits a shape against the shapes of a node) are gathered into a block:
+     * separated_by_planes () rejects most of them for the whole block at once and only the
+     * other lanes reach are_intersecting (). The plane of the first shape is taken once for
+     * all its candidates. planes_1 and planes_2 are the caches of the scenes of the first and
+     * the second shapes. flush () has to be called after the last candidate.
+     */
+    template<typename F>
+    class Batched_Narrow_Phase final
+    {
+        F on_intersection_;
+        plane_span planes_1_;
+        plane_span planes_2_;
+        std::optional<shape_type> first_;
+        plane_type first_plane_;
+        Triangle_Block<distance_type> block_;
+        std::vector<shape_type> seconds_;
+
+    public:
+
+        Batched_Narrow_Phase (F on_intersection, plane_span planes_1, plane_span planes_2)
+                             : on_intersection_{on_intersection}, planes_1_{planes_1},
+                               planes_2_{planes_2}
+        {
+            seconds_.reserve (block_.capacity());
+        }
+
+        // Shapes are copied: engines may pass shapes built only for the call
+        void operator() (const shape_type &shape_1, const shape_type &shape_2)
+        {
+            if (!first_ || first_->index() != shape_1.index())
+            {
+                flush();
+                first_.emplace (shape_1);
+                if (auto first_triangle = triangle_of (shape_1))
+                    first_plane_ = plane_of (shape_1, *first_triangle, planes_1_);
+            }
+
+            auto triangle_2 = triangle_of (*first_) ? triangle_of (shape_2) : nullptr;
+            if (!triangle_2)
+            {
+                if (test_pair (shape_1, planes_1_, shape_2, planes_2_))
+                    on_intersection_ (shape_1, shape_2);
+                return;
+            }
+
+            seconds_.push_back (shape_2);
+            block_.push_back (*triangle_2);
+
+            if (block_.full())
+                flush();
+        }
+
+        // Tests the candidates left in the block
+        void flush ()
+        {
+            if (block_.empty())
+                return;
+
+            // A single candidate isn't worth the whole block
+            auto separated = (block_.size() == 1) ? std::uint32_t{0}
+                                                  : detail::separated_by_planes (
+                                                        *triangle_of (*first_), block_);
+
+            for (std::size_t lane = 0; lane != block_.size(); ++lane)
+            {
+                if (!(separated & (std::uint32_t{1} << lane)))
+                    test_lane (lane);
+            }
+
+            block_.clear();
+            seconds_.clear();
+        }
+
+    private:
+
+        void test_lane (std::size_t lane)
+        {
+            auto &shape_2 = seconds_[lane];
+            auto &triangle_2 = *triangle_of (shape_2);
+
+            if (are_overlapping (*first_, shape_2) &&
+                are_intersecting (*triangle_of (*first_), first_plane_,
+                                  triangle_2, plane_of (shape_2, triangle_2, planes_2_)))
+                on_intersection_ (*first_, shape_2);
+        }
+    };
+
+    template<typename F>
+    auto intersecting_pairs_reporter (F report) const
+    {
+        return Batched_Narrow_Phase{[report](const shape_type &shape_1,
+                                             const shape_type &shape_2) mutable
+        {
+            report (shape_1.index());
+            report (shape_2.index());
+        }, planes_, planes_};
+    }
+
+    // planes_2 is the cache of the scene of the second shapes
+    template<typename F>
+    auto intersecting_pairs_callback (F &callback, plane_span planes_2) const
+    {
+        return Batched_Narrow_Phase{[&callback](const shape_type &shape_1,
+                                                const shape_type &shape_2)
+        {
+            callback (Index_Pair{shape_1.index(), shape_2.index()});
+        }, planes_, planes_2};
     }
 };
 
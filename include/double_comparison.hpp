@@ -3,6 +3,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <concepts>
 #include <type_traits>
 
 namespace yLab
@@ -65,6 +66,59 @@ constexpr bool greater_equal (T first, T second, T zero_diff = cmp_precision<T>:
     return (first > second) || are_equal (first, second, zero_diff, rel_diff);
 }
 
+/*
+ * Comparison policies of geometry types (Vector, points and the intersection tests built on
+ * them): when two values are equal and when their sum or difference is zero.
+ */
+
+// Values closer than cmp_precision are equal; sums and differences of such values snap to zero
+struct Tolerant final
+{
+    template<typename T>
+    static constexpr bool are_equal (T first, T second) { return cmp::are_equal (first, second); }
+
+    template<typename T>
+    static constexpr bool is_zero (T value) { return cmp::is_zero (value); }
+
+    template<typename T>
+    static constexpr T sum (T first, T second)
+    {
+        return cmp::are_equal (first, -second) ? T{} : first + second;
+    }
+
+    template<typename T>
+    static constexpr T difference (T first, T second)
+    {
+        return cmp::are_equal (first, second) ? T{} : first - second;
+    }
+};
+
+// Plain floating-point arithmetic and comparisons: no branches, so products of vectors compile
+// down to multiplications and additions (fused ones if the target has FMA and contraction is on)
+struct Raw final
+{
+    template<typename T>
+    static constexpr bool are_equal (T first, T second) { return first == second; }
+
+    template<typename T>
+    static constexpr bool is_zero (T value) { return value == T{}; }
+
+    template<typename T>
+    static constexpr T sum (T first, T second) { return first + second; }
+
+    template<typename T>
+    static constexpr T difference (T first, T second) { return first - second; }
+};
+
+template<typename C>
+concept Comparison_Policy = requires (double value)
+{
+    { C::are_equal (value, value) } -> std::same_as<bool>;
+    { C::is_zero (value) } -> std::same_as<bool>;
+    { C::sum (value, value) } -> std::same_as<double>;
+    { C::difference (value, value) } -> std::same_as<double>;
+};
+
 } // namespace cmp
 
 } // namespace yLab
@@ -0,0 +1,99 @@
+#ifndef INCLUDE_INTERSECTION_CLOSEST_POINT_HPP
+#define INCLUDE_INTERSECTION_CLOSEST_POINT_HPP
+
+#include <algorithm>
+
+#include "point.hpp"
+#include "segment.hpp"
+#include "triangle.hpp"
+#include "vector.hpp"
+
+namespace yLab::geometry
+{
+
+namespace detail
+{
+
+template<typename T>
+Point_3D<T> shift (const Point_3D<T> &pt, const Vector<T> &vec)
+{
+    return Point_3D<T>{pt.x() + vec.x_, pt.y() + vec.y_, pt.z() + vec.z_};
+}
+
+} // namespace detail
+
+template<typename T>
+Point_3D<T> closest_point (const Point_3D<T> &, const Point_3D<T> &other)
+{
+    return other;
+}
+
+template<typename T>
+Point_3D<T> closest_point (const Point_3D<T> &pt, const Segment<Point_3D<T>> &seg)
+{
+    Vector PQ{seg.P(), seg.Q()};
+    auto length_2 = PQ.norm();
+
+    if (length_2 == T{})
+        return seg.P();
+
+    auto t = std::clamp (scalar_product (Vector{seg.P(), pt}, PQ) / length_2, T{0}, T{1});
+    return detail::shift (seg.P(), t * PQ);
+}
+
+// The point of the triangle nearest to pt: the projection of pt on the plane of the triangle
+// if it lies inside, otherwise the nearest point of the edge or the vertex whose Voronoi
+// region contains pt
+template<typename T>
+Point_3D<T> closest_point (const Point_3D<T> &pt, const Triangle<Point_3D<T>> &tr)
+{
+    auto &A = tr.P();
+    auto &B = tr.Q();
+    auto &C = tr.R();
+
+    Vector AB{A, B};
+    Vector AC{A, C};
+
+    Vector AM{A, pt};
+    auto d_1 = scalar_product (AB, AM);
+    auto d_2 = scalar_product (AC, AM);
+    if (d_1 <= 0 && d_2 <= 0)
+        return A;
+
+    Vector BM{B, pt};
+    auto d_3 = scalar_product (AB, BM);
+    auto d_4 = scalar_product (AC, BM);
+    if (d_3 >= 0 && d_4 <= d_3)
+        return B;
+
+    auto v_C = d_1 * d_4 - d_3 * d_2;
+    if (v_C <= 0 && d_1 >= 0 && d_3 <= 0)
+        return detail::shift (A, d_1 / (d_1 - d_3) * AB);
+
+    Vector CM{C, pt};
+    auto d_5 = scalar_product (AB, CM);
+    auto d_6 = scalar_product (AC, CM);
+    if (d_6 >= 0 && d_5 <= d_6)
+        return C;
+
+    auto v_B = d_5 * d_2 - d_1 * d_6;
+    if (v_B <= 0 && d_2 >= 0 && d_6 <= 0)
+        return detail::shift (A, d_2 / (d_2 - d_6) * AC);
+
+    auto v_A = d_3 * d_6 - d_5 * d_4;
+    if (v_A <= 0 && d_4 - d_3 >= 0 && d_5 - d_6 >= 0)
+        return detail::shift (B, (d_4 - d_3) / ((d_4 - d_3) + (d_5 - d_6)) * Vector{B, C});
+
+    auto denominator = v_A + v_B + v_C;
+    return detail::shift (A, v_B / denominator * AB + v_C / denominator * AC);
+}
+
+template<typename T, typename Primitive>
+T squared_distance (const Point_3D<T> &pt, const Primitive &primitive)
+{
+    return Vector{pt, closest_point (pt, primitive)}.norm();
+}
+
+} // namespace yLab::geometry
+
+#endif // INCLUDE_INTERSECTION_CLOSEST_POINT_HPP
@@ -0,0 +1,237 @@
+#ifndef INCLUDE_INTERSECTION_EXACT_ORIENTATION_HPP
+#define INCLUDE_INTERSECTION_EXACT_ORIENTATION_HPP
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+#include "point.hpp"
+
+namespace yLab::geometry
+{
+
+namespace detail
+{
+
+/*
+ * Expansion arithmetic by J. R. Shewchuk ("Adaptive Precision Floating-Point Arithmetic and
+ * Fast Robust Geometric Predicates"): a real number is kept exactly as a sum of nonoverlapping
+ * components of T sorted by increasing magnitude. The sign of the number is the sign of the
+ * last component. Round-to-nearest arithmetic without extended precision is assumed.
+ */
+template<typename T, std::size_t N>
+struct Expansion final
+{
+    std::array<T, N> components{};
+    std::size_t size = 0;
+
+    void push_back (T component)
+    {
+        if (component != T{})
+            components[size++] = component;
+    }
+
+    // The sign of the exact value and its approximation
+    T estimate () const { return size ? components[size - 1] : T{}; }
+};
+
+// a + b == x + y exactly, where x is the rounded sum
+template<typename T>
+void two_sum (T a, T b, T &x, T &y)
+{
+    x = a + b;
+    auto b_virtual = x - a;
+    auto a_virtual = x - b_virtual;
+    y = (a - a_virtual) + (b - b_virtual);
+}
+
+// The same for |a| >= |b|
+template<typename T>
+void fast_two_sum (T a, T b, T &x, T &y)
+{
+    x = a + b;
+    y = b - (x - a);
+}
+
+template<typename T>
+void two_product (T a, T b, T &x, T &y)
+{
+    x = a * b;
+    y = std::fma (a, b, -x);
+}
+
+// a - b as an expansion of 2 components
+template<typename T>
+Expansion<T, 2> difference (T a, T b)
+{
+    T x, y;
+    two_sum (a, -b, x, y);
+
+    Expansion<T, 2> e;
+    e.push_back (y);
+    e.push_back (x);
+
+    return e;
+}
+
+// h += f by Grow-Expansion for every component of f; h has to have room for the result
+template<typename T, std::size_t M, std::size_t N>
+void add (Expansion<T, M> &h, const Expansion<T, N> &f)
+{
+    for (std::size_t j = 0; j != f.size; ++j)
+    {
+        auto Q = f.components[j];
+        std::size_t size = 0;
+
+        // Components are written in place: never ahead of the one being read
+        for (std::size_t i = 0; i != h.size; ++i)
+        {
+            T error;
+            two_sum (Q, h.components[i], Q, error);
+            if (error != T{})
+                h.components[size++] = error;
+        }
+
+        h.size = size;
+        h.push_back (Q);
+    }
+}
+
+template<typename T, std::size_t M, std::size_t N>
+Expansion<T, M + N> sum (const Expansion<T, M> &e, const Expansion<T, N> &f)
+{
+    Expansion<T, M + N> h;
+    add (h, e);
+    add (h, f);
+
+    return h;
+}
+
+template<typename T, std::size_t N>
+Expansion<T, N> negate (Expansion<T, N> e)
+{
+    for (std::size_t i = 0; i != e.size; ++i)
+        e.components[i] = -e.components[i];
+
+    return e;
+}
+
+// e * b (Scale-Expansion)
+template<typename T, std::size_t N>
+Expansion<T, 2 * N> scale (const Expansion<T, N> &e, T b)
+{
+    Expansion<T, 2 * N> h;
+    if (e.size == 0)
+        return h;
+
+    T Q, error;
+    two_product (e.components[0], b, Q, error);
+    h.push_back (error);
+
+    for (std::size_t i = 1; i != e.size; ++i)
+    {
+        T product, product_error, sum;
+        two_product (e.components[i], b, product, product_error);
+
+        two_sum (Q, product_error, sum, error);
+        h.push_back (error);
+
+        fast_two_sum (product, sum, Q, error);
+        h.push_back (error);
+    }
+    h.push_back (Q);
+
+    return h;
+}
+
+template<typename T, std::size_t M, std::size_t N>
+Expansion<T, 2 * M * N> product (const Expansion<T, M> &e, const Expansion<T, N> &f)
+{
+    Expansion<T, 2 * M * N> h;
+    for (std::size_t j = 0; j != f.size; ++j)
+        add (h, scale (e, f.components[j]));
+
+    return h;
+}
+
+// The unit roundoff of T: half of the machine epsilon
+template<typename T>
+constexpr T unit_roundoff = std::numeric_limits<T>::epsilon() / 2;
+
+/*
+ * The value of the product magic_product (P, Q, M) takes the sign of, with the sign computed
+ * exactly: the floating-point product is returned if the error bound proves its sign,
+ * otherwise the product is evaluated in expansion arithmetic.
+ */
+template<typename T>
+T orient_2d (const Point_2D<T> &P, const Point_2D<T> &Q, const Point_2D<T> &M)
+{
+    auto left = (P.x() - M.x()) * (Q.y() - M.y());
+    auto right = (P.y() - M.y()) * (Q.x() - M.x());
+    auto det = left - right;
+
+    constexpr auto epsilon = unit_roundoff<T>;
+    constexpr auto error_bound = (3 + 16 * epsilon) * epsilon;
+
+    if (std::abs (det) > error_bound * (std::abs (left) + std::abs (right)))
+        return det;
+
+    auto exact_left = product (difference (P.x(), M.x()), difference (Q.y(), M.y()));
+    auto exact_right = product (difference (P.y(), M.y()), difference (Q.x(), M.x()));
+
+    return sum (exact_left, negate (exact_right)).estimate();
+}
+
+// The same for the product of magic_product (P, Q, R, M)
+template<typename T>
+T orient_3d (const Point_3D<T> &P, const Point_3D<T> &Q, const Point_3D<T> &R,
+             const Point_3D<T> &M)
+{
+    std::array<T, 3> a{M.x() - P.x(), M.y() - P.y(), M.z() - P.z()};
+    std::array<T, 3> b{M.x() - Q.x(), M.y() - Q.y(), M.z() - Q.z()};
+    std::array<T, 3> c{M.x() - R.x(), M.y() - R.y(), M.z() - R.z()};
+
+    auto bc_12 = b[1] * c[2];
+    auto bc_21 = b[2] * c[1];
+    auto bc_02 = b[0] * c[2];
+    auto bc_20 = b[2] * c[0];
+    auto bc_01 = b[0] * c[1];
+    auto bc_10 = b[1] * c[0];
+
+    auto det = a[0] * (bc_12 - bc_21) - a[1] * (bc_02 - bc_20) + a[2] * (bc_01 - bc_10);
+
+    auto permanent = std::abs (a[0]) * (std::abs (bc_12) + std::abs (bc_21)) +
+                     std::abs (a[1]) * (std::abs (bc_02) + std::abs (bc_20)) +
+                     std::abs (a[2]) * (std::abs (bc_01) + std::abs (bc_10));
+
+    constexpr auto epsilon = unit_roundoff<T>;
+    constexpr auto error_bound = (7 + 56 * epsilon) * epsilon;
+
+    if (std::abs (det) > error_bound * permanent)
+        return det;
+
+    std::array<Expansion<T, 2>, 3> exact_a{difference (M.x(), P.x()), difference (M.y(), P.y()),
+                                           difference (M.z(), P.z())};
+    std::array<Expansion<T, 2>, 3> exact_b{difference (M.x(), Q.x()), difference (M.y(), Q.y()),
+                                           difference (M.z(), Q.z())};
+    std::array<Expansion<T, 2>, 3> exact_c{difference (M.x(), R.x()), difference (M.y(), R.y()),
+                                           difference (M.z(), R.z())};
+
+    auto minor = [&exact_b, &exact_c](unsigned i, unsigned j)
+    {
+        return sum (product (exact_b[i], exact_c[j]), negate (product (exact_b[j], exact_c[i])));
+    };
+
+    auto term_0 = product (exact_a[0], minor (1, 2));
+    auto term_1 = product (exact_a[1], minor (2, 0));
+    auto term_2 = product (exact_a[2], minor (0, 1));
+
+    return sum (sum (term_0, term_1), term_2).estimate();
+}
+
+} // namespace detail
+
+} // namespace yLab::geometry
+
+#endif // INCLUDE_INTERSECTION_EXACT_ORIENTATION_HPP
@@ -18,96 +18,101 @@ namespace detail
 
 // Segment-triangle intersection
 
-template<typename T>
+template<Orientation_Predicates Policy, typename T>
 bool test_intersection_R1 (const Segment<Point_2D<T>> &seg,
                            const Triangle<Point_2D<T>> &tr)
 {
-    if (magic_product (tr.R(), tr.P(), seg.Q()) == Loc_2D::Negative)
+    if (magic_product<Policy> (tr.R(), tr.P(), seg.Q()) == Loc_2D::Negative)
         return false;
     else
-        return (magic_product (seg.P(), tr.P(), seg.Q()) != Loc_2D::Negative &&
-                magic_product (seg.P(), tr.R(), seg.Q()) != Loc_2D::Positive);
+        return (magic_product<Policy> (seg.P(), tr.P(), seg.Q()) != Loc_2D::Negative &&
+                magic_product<Policy> (seg.P(), tr.R(), seg.Q()) != Loc_2D::Positive);
 }
 
-template<typename T>
+template<Orientation_Predicates Policy, typename T>
 bool test_intersection_R2 (const Segment<Point_2D<T>> &seg,
                            const Triangle<Point_2D<T>> &tr)
 {
-    if (magic_product (tr.R(), tr.P(), seg.Q()) == Loc_2D::Negative)
+    if (magic_product<Policy> (tr.R(), tr.P(), seg.Q()) == Loc_2D::Negative)
         return false;
     else
     {
-        return  (magic_product (seg.P(), tr.P(), seg.Q()) != Loc_2D::Negative &&
-                 magic_product (seg.P(), tr.Q(), seg.Q()) != Loc_2D::Positive &&
-                 magic_product (tr.Q(),  tr.R(), seg.Q()) != Loc_2D::Negative);
+        return  (magic_product<Policy> (seg.P(), tr.P(), seg.Q()) != Loc_2D::Negative &&
+                 magic_product<Policy> (seg.P(), tr.Q(), seg.Q()) != Loc_2D::Positive &&
+                 magic_product<Policy> (tr.Q(),  tr.R(), seg.Q()) != Loc_2D::Negative);
     }
 }
 
 // Triangle-triangle intersection
 
-template<typename T>
+template<Orientation_Predicates Policy, typename T>
 bool test_intersection_R1 (const Triangle<Point_2D<T>> &tr_1,
                            const Triangle<Point_2D<T>> &tr_2)
 {
-    if (magic_product (tr_2.R(), tr_2.P(), tr_1.Q()) == Loc_2D::Negative) // Q1 belongs to R11
+    // Q1 belongs to R11
+    if (magic_product<Policy> (tr_2.R(), tr_2.P(), tr_1.Q()) == Loc_2D::Negative)
     {
-        if (magic_product (tr_2.R(), tr_2.P(), tr_1.R()) == Loc_2D::Negative) // R1 belongs to R11
+        // R1 belongs to R11
+        if (magic_product<Policy> (tr_2.R(), tr_2.P(), tr_1.R()) == Loc_2D::Negative)
             return false;
         else
-            return (magic_product (tr_1.Q(), tr_2.R(), tr_1.R()) != Loc_2D::Positive &&
-                    magic_product (tr_1.P(), tr_2.P(), tr_1.R()) != Loc_2D::Negative);
+            return (magic_product<Policy> (tr_1.Q(), tr_2.R(), tr_1.R()) != Loc_2D::Positive &&
+                    magic_product<Policy> (tr_1.P(), tr_2.P(), tr_1.R()) != Loc_2D::Negative);
     }
     else
     {
-        if (magic_product (tr_1.P(), tr_2.R(), tr_1.Q()) == Loc_2D::Positive) // Q1 belongs to R12
+        // Q1 belongs to R12
+        if (magic_product<Policy> (tr_1.P(), tr_2.R(), tr_1.Q()) == Loc_2D::Positive)
             return false;
-        else if (magic_product (tr_1.P(), tr_2.P(), tr_1.Q()) != Loc_2D::Negative) // Q1 belongs to R13
+        // Q1 belongs to R13
+        else if (magic_product<Policy> (tr_1.P(), tr_2.P(), tr_1.Q()) != Loc_2D::Negative)
             return true;
         else // Q1 belongs to R14
-            return (magic_product (tr_1.P(), tr_2.P(), tr_1.R()) != Loc_2D::Negative &&
-                    magic_product (tr_1.Q(), tr_2.P(), tr_1.R()) != Loc_2D::Positive);
+            return (magic_product<Policy> (tr_1.P(), tr_2.P(), tr_1.R()) != Loc_2D::Negative &&
+                    magic_product<Policy> (tr_1.Q(), tr_2.P(), tr_1.R()) != Loc_2D::Positive);
     }
 }
 
-template<typename T>
+template<Orientation_Predicates Policy, typename T>
 bool test_intersection_R2 (const Triangle<Point_2D<T>> &tr_1,
                            const Triangle<Point_2D<T>> &tr_2)
 {
-    if (magic_product (tr_2.R(), tr_2.P(), tr_1.Q()) == Loc_2D::Negative) // Q1 in R21
+    if (magic_product<Policy> (tr_2.R(), tr_2.P(), tr_1.Q()) == Loc_2D::Negative) // Q1 in R21
     {
-        if (magic_product (tr_2.R(), tr_2.P(), tr_1.R()) == Loc_2D::Negative) // R1 in R21
+        if (magic_product<Policy> (tr_2.R(), tr_2.P(), tr_1.R()) == Loc_2D::Negative) // R1 in R21
             return false;
-        else if (magic_product (tr_2.R(), tr_1.Q(), tr_1.R()) != Loc_2D::Negative)
-            return magic_product (tr_1.P(), tr_2.P(), tr_1.R()) != Loc_2D::Negative;
+        else if (magic_product<Policy> (tr_2.R(), tr_1.Q(), tr_1.R()) != Loc_2D::Negative)
+            return magic_product<Policy> (tr_1.P(), tr_2.P(), tr_1.R()) != Loc_2D::Negative;
         else
-            return (magic_product (tr_2.Q(), tr_1.Q(), tr_1.R()) != Loc_2D::Negative &&
-                    magic_product (tr_2.Q(), tr_2.R(), tr_1.R()) != Loc_2D::Negative);
+            return (magic_product<Policy> (tr_2.Q(), tr_1.Q(), tr_1.R()) != Loc_2D::Negative &&
+                    magic_product<Policy> (tr_2.Q(), tr_2.R(), tr_1.R()) != Loc_2D::Negative);
     }
-    else if (magic_product (tr_2.Q(), tr_2.R(), tr_1.Q()) == Loc_2D::Negative) // Q1 in R22 or R25
+    // Q1 in R22 or R25
+    else if (magic_product<Policy> (tr_2.Q(), tr_2.R(), tr_1.Q()) == Loc_2D::Negative)
     {
-        if (magic_product (tr_1.P(), tr_2.Q(), tr_1.Q()) == Loc_2D::Negative) // Q1 in R25
+        if (magic_product<Policy> (tr_1.P(), tr_2.Q(), tr_1.Q()) == Loc_2D::Negative) // Q1 in R25
         {
-            return (magic_product (tr_2.Q(), tr_2.R(), tr_1.R()) != Loc_2D::Negative &&
-                    magic_product (tr_2.Q(), tr_1.Q(), tr_1.R()) != Loc_2D::Negative);
+            return (magic_product<Policy> (tr_2.Q(), tr_2.R(), tr_1.R()) != Loc_2D::Negative &&
+                    magic_product<Policy> (tr_2.Q(), tr_1.Q(), tr_1.R()) != Loc_2D::Negative);
         }
         else
             return false;
     }
-    else if (magic_product (tr_1.P(), tr_2.P(), tr_1.Q()) == Loc_2D::Negative) // Q1 in R24
+    else if (magic_product<Policy> (tr_1.P(), tr_2.P(), tr_1.Q()) == Loc_2D::Negative) // Q1 in R24
     {
-        return (magic_product (tr_1.P(), tr_2.P(), tr_1.R()) != Loc_2D::Negative &&
-                magic_product (tr_1.Q(), tr_2.P(), tr_1.R()) != Loc_2D::Positive);
+        return (magic_product<Policy> (tr_1.P(), tr_2.P(), tr_1.R()) != Loc_2D::Negative &&
+                magic_product<Policy> (tr_1.Q(), tr_2.P(), tr_1.R()) != Loc_2D::Positive);
     }
     else
-        return magic_product (tr_1.P(), tr_2.Q(), tr_1.Q()) != Loc_2D::Positive;
+        return magic_product<Policy> (tr_1.P(), tr_2.Q(), tr_1.Q()) != Loc_2D::Positive;
 }
 
-template<typename T, typename Primitive_T>
+template<Orientation_Predicates Policy = Tolerant_Predicates, typename T, typename Primitive_T>
 bool are_intersecting_2D (Primitive_T &other, Triangle<Point_2D<T>> &tr)
 {
-    auto P1_wrt_P2Q2 = magic_product (tr.P(), tr.Q(), other.P());
-    auto P1_wrt_Q2R2 = magic_product (tr.Q(), tr.R(), other.P());
-    auto P1_wrt_R2P2 = magic_product (tr.R(), tr.P(), other.P());
+    auto P1_wrt_P2Q2 = magic_product<Policy> (tr.P(), tr.Q(), other.P());
+    auto P1_wrt_Q2R2 = magic_product<Policy> (tr.Q(), tr.R(), other.P());
+    auto P1_wrt_R2P2 = magic_product<Policy> (tr.R(), tr.P(), other.P());
 
     auto P1_loc = deduce_pt_location (P1_wrt_P2Q2, P1_wrt_Q2R2, P1_wrt_R2P2);
 
@@ -126,7 +131,7 @@ bool are_intersecting_2D (Primitive_T &other, Triangle<Point_2D<T>> &tr)
             else if (P1_wrt_Q2R2 == Loc_2D::Negative)
                 tr.swap_clockwise();
 
-            return test_intersection_R1 (other, tr);
+            return test_intersection_R1<Policy> (other, tr);
 
         case Pt_Wrt_Tr::In_R2:
 
@@ -135,7 +140,7 @@ bool are_intersecting_2D (Primitive_T &other, Triangle<Point_2D<T>> &tr)
             else if (P1_wrt_Q2R2 == Loc_2D::Positive)
                 tr.swap_counterclockwise();
 
-            return test_intersection_R2 (other, tr);
+            return test_intersection_R2<Policy> (other, tr);
 
         default:
             throw std::runtime_error ("Something bad happened");
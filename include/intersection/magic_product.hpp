@@ -1,8 +1,12 @@
 #ifndef INCLUDE_INTERSECTION_MAGIC_PRODUCT_HPP
 #define INCLUDE_INTERSECTION_MAGIC_PRODUCT_HPP
 
+#include <array>
+#include <concepts>
+
 #include "double_comparison.hpp"
 #include "point.hpp"
+#include "exact_orientation.hpp"
 
 namespace yLab::geometry
 {
@@ -17,6 +21,128 @@ enum class Loc_2D
     Positive = 1
 };
 
+enum class Loc_3D
+{
+    Below = -1,
+    On    = 0,
+    Above = 1
+};
+
+// The sign of a product of magic_product (): zero as decided by the comparison policy C
+template<cmp::Comparison_Policy C = cmp::Tolerant, typename T>
+Loc_3D location (T product)
+{
+    if (C::is_zero (product))
+        return Loc_3D::On;
+    else if (product > T{})
+        return Loc_3D::Above;
+    else
+        return Loc_3D::Below;
+}
+
+constexpr Loc_3D opposite (Loc_3D loc) { return static_cast<Loc_3D>(-static_cast<int>(loc)); }
+
+// Loc_2D or Loc_3D of an exact sign
+template<typename Loc, typename T>
+constexpr Loc sign_of (T value) { return static_cast<Loc>((value > T{}) - (value < T{})); }
+
+} // namespace detail
+
+/*
+ * Predicates of the intersection tests: the signs of the products of magic_product (). They're
+ * selected by the first template parameter of magic_product () and are_intersecting ().
+ * The comparison policy of a predicate policy is the one of the Vector and point tests.
+ */
+
+// Signs of the products computed in floating-point arithmetic with zero decided by C
+template<cmp::Comparison_Policy C>
+struct Rounded_Predicates final
+{
+    using comparison_policy = C;
+
+    // Orientations with respect to a triangle may be taken from its Triangle_Plane
+    static constexpr bool uses_planes = true;
+
+    template<typename T>
+    static detail::Loc_2D orientation (const Point_2D<T> &P, const Point_2D<T> &Q,
+                                       const Point_2D<T> &M)
+    {
+        auto product = (P.x() - M.x()) * (Q.y() - M.y()) - (P.y() - M.y()) * (Q.x() - M.x());
+
+        if (C::is_zero (product))
+            return detail::Loc_2D::Neutral;
+        else
+            return detail::sign_of<detail::Loc_2D> (product);
+    }
+
+    template<typename T>
+    static detail::Loc_3D orientation (const Point_3D<T> &P, const Point_3D<T> &Q,
+                                       const Point_3D<T> &R, const Point_3D<T> &M)
+    {
+        auto elem_21 = M.x() - Q.x();
+        auto elem_22 = M.y() - Q.y();
+        auto elem_23 = M.z() - Q.z();
+
+        auto elem_31 = M.x() - R.x();
+        auto elem_32 = M.y() - R.y();
+        auto elem_33 = M.z() - R.z();
+
+        auto product = (M.x() - P.x()) * (elem_22 * elem_33 - elem_23 * elem_32) -
+                       (M.y() - P.y()) * (elem_21 * elem_33 - elem_23 * elem_31) +
+                       (M.z() - P.z()) * (elem_21 * elem_32 - elem_22 * elem_31);
+
+        return detail::location<C> (product);
+    }
+};
+
+// Products closer to zero than the tolerance of cmp are zero
+using Tolerant_Predicates = Rounded_Predicates<cmp::Tolerant>;
+
+// Products are taken as computed: the cheapest predicates, but rounding errors decide the signs
+// of nearly degenerate configurations
+using Raw_Predicates = Rounded_Predicates<cmp::Raw>;
+
+/*
+ * Exact signs of the products of the coordinates as given: a product is zero only if
+ * the points are exactly collinear (coplanar). Most products are decided by a floating-point
+ * error bound; the rest are evaluated in expansion arithmetic (see exact_orientation.hpp).
+ */
+struct Exact_Predicates final
+{
+    // Vector and point tests are rounded: they keep the tolerance of cmp
+    using comparison_policy = cmp::Tolerant;
+
+    // Planes are rounded, so orientations are computed by the vertices
+    static constexpr bool uses_planes = false;
+
+    template<typename T>
+    static detail::Loc_2D orientation (const Point_2D<T> &P, const Point_2D<T> &Q,
+                                       const Point_2D<T> &M)
+    {
+        return detail::sign_of<detail::Loc_2D> (detail::orient_2d (P, Q, M));
+    }
+
+    template<typename T>
+    static detail::Loc_3D orientation (const Point_3D<T> &P, const Point_3D<T> &Q,
+                                       const Point_3D<T> &R, const Point_3D<T> &M)
+    {
+        return detail::sign_of<detail::Loc_3D> (detail::orient_3d (P, Q, R, M));
+    }
+};
+
+template<typename P>
+concept Orientation_Predicates = requires (const Point_2D<double> &pt_2d,
+                                           const Point_3D<double> &pt_3d)
+{
+    requires cmp::Comparison_Policy<typename P::comparison_policy>;
+    { P::uses_planes } -> std::convertible_to<bool>;
+    { P::orientation (pt_2d, pt_2d, pt_2d) } -> std::same_as<detail::Loc_2D>;
+    { P::orientation (pt_3d, pt_3d, pt_3d, pt_3d) } -> std::same_as<detail::Loc_3D>;
+};
+
+namespace detail
+{
+
 /*
  * Let P, Q, M be three points in R^2.
  *
@@ -25,26 +151,12 @@ enum class Loc_2D
  * negative if P, Q, M (in this very order) locate in clockwise order,
  * neutral if P, Q, M locate on the same line.
  */
-template<typename T>
+template<Orientation_Predicates Policy = Tolerant_Predicates, typename T>
 Loc_2D magic_product (const Point_2D<T> &P, const Point_2D<T> &Q, const Point_2D<T> &M)
 {
-    auto product = (P.x() - M.x()) * (Q.y() - M.y()) - (P.y() - M.y()) * (Q.x() - M.x());
-
-    if (cmp::is_zero (product))
-        return Loc_2D::Neutral;
-    else if (cmp::greater (product, T{}))
-        return Loc_2D::Positive;
-    else
-        return Loc_2D::Negative;
+    return Policy::orientation (P, Q, M);
 }
 
-enum class Loc_3D
-{
-    Below = -1,
-    On    = 0,
-    Above = 1
-};
-
 /*
  * Let P, Q, R (in this very order) and M be points in R^3.
  *
@@ -54,28 +166,51 @@ enum class Loc_3D
  * v_QM is a vector with initial point Q and terminal point M,
  * v_RM is a vector with initial point R and terminal point M.
  */
-template<typename T>
+template<Orientation_Predicates Policy = Tolerant_Predicates, typename T>
 Loc_3D magic_product (const Point_3D<T> &P, const Point_3D<T> &Q,
                       const Point_3D<T> &R, const Point_3D<T> &M)
 {
-    auto elem_21 = M.x() - Q.x();
-    auto elem_22 = M.y() - Q.y();
-    auto elem_23 = M.z() - Q.z();
+    return Policy::orientation (P, Q, R, M);
+}
 
-    auto elem_31 = M.x() - R.x();
-    auto elem_32 = M.y() - R.y();
-    auto elem_33 = M.z() - R.z();
 
-    auto product = (M.x() - P.x()) * (elem_22 * elem_33 - elem_23 * elem_32) -
-                   (M.y() - P.y()) * (elem_21 * elem_33 - elem_23 * elem_31) +
-                   (M.z() - P.z()) * (elem_21 * elem_32 - elem_22 * elem_31);
+// The product of magic_product (P, Q, R, M) before its sign is taken
+template<typename T>
+T triple_product (const std::array<T, 3> &P, const std::array<T, 3> &Q,
+                  const std::array<T, 3> &R, const std::array<T, 3> &M)
+{
+    auto elem_21 = M[0] - Q[0];
+    auto elem_22 = M[1] - Q[1];
+    auto elem_23 = M[2] - Q[2];
+
+    auto elem_31 = M[0] - R[0];
+    auto elem_32 = M[1] - R[1];
+    auto elem_33 = M[2] - R[2];
 
-    if (cmp::is_zero (product))
-        return Loc_3D::On;
-    else if (cmp::greater (product, T{}))
-        return Loc_3D::Above;
-    else
-        return Loc_3D::Below;
+    return (M[0] - P[0]) * (elem_22 * elem_33 - elem_23 * elem_32) -
+           (M[1] - P[1]) * (elem_21 * elem_33 - elem_23 * elem_31) +
+           (M[2] - P[2]) * (elem_21 * elem_32 - elem_22 * elem_31);
+}
+
+// The normal (Q - P) x (R - P) of the plane of P, Q, R: magic_product (P, Q, R, M) is the sign
+// of plane_product (normal, P, M)
+template<typename T>
+std::array<T, 3> plane_normal (const std::array<T, 3> &P, const std::array<T, 3> &Q,
+                               const std::array<T, 3> &R)
+{
+    std::array<T, 3> PQ{Q[0] - P[0], Q[1] - P[1], Q[2] - P[2]};
+    std::array<T, 3> PR{R[0] - P[0], R[1] - P[1], R[2] - P[2]};
+
+    return {PQ[1] * PR[2] - PQ[2] * PR[1],
+            PQ[2] * PR[0] - PQ[0] * PR[2],
+            PQ[0] * PR[1] - PQ[1] * PR[0]};
+}
+
+template<typename T>
+T plane_product (const std::array<T, 3> &normal, const std::array<T, 3> &P,
+                 const std::array<T, 3> &M)
+{
+    return normal[0] * (M[0] - P[0]) + normal[1] * (M[1] - P[1]) + normal[2] * (M[2] - P[2]);
 }
 
 } // namespace detail
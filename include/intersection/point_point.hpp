@@ -3,13 +3,15 @@
 
 #include "point.hpp"
 
+#include "magic_product.hpp"
+
 namespace yLab::geometry
 {
 
-template<typename T>
+template<Orientation_Predicates Policy = Tolerant_Predicates, typename T>
 bool are_intersecting (const Point_3D<T> &pt_1, const Point_3D<T> &pt_2)
 {
-    return pt_1 == pt_2;
+    return are_equal<typename Policy::comparison_policy> (pt_1, pt_2);
 }
 
 } // yLab::geometry
@@ -5,28 +5,32 @@
 #include "segment.hpp"
 #include "vector.hpp"
 
+#include "magic_product.hpp"
+
 namespace yLab::geometry
 {
 
-template<typename T>
+template<Orientation_Predicates Policy = Tolerant_Predicates, typename T>
 bool are_intersecting (const Point_3D<T> &pt, const Segment<Point_3D<T>> &seg)
 {
-    Vector PQ{seg.P(), seg.Q()};
-    Vector PM{seg.P(), pt};
+    using vector_type = Vector<T, typename Policy::comparison_policy>;
+
+    vector_type PQ{seg.P(), seg.Q()};
+    vector_type PM{seg.P(), pt};
 
     if (are_collinear (PQ, PM))
     {
-        Vector QM{seg.Q(), pt};
+        vector_type QM{seg.Q(), pt};
         return are_antiparallel (PM, QM);
     }
     else
         return false;
 }
 
-template<typename T>
+template<Orientation_Predicates Policy = Tolerant_Predicates, typename T>
 bool are_intersecting (const Segment<Point_3D<T>> &seg, const Point_3D<T> &pt)
 {
-    return are_intersecting (pt, seg);
+    return are_intersecting<Policy> (pt, seg);
 }
 
 } // yLab::geometry
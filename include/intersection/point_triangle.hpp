@@ -55,22 +55,22 @@ inline constexpr Pt_Wrt_Tr deduce_pt_location (Loc_2D loc_1, Loc_2D loc_2, Loc_2
 
 } // namespace detail
 
-template<typename T>
+template<Orientation_Predicates Policy = Tolerant_Predicates, typename T>
 bool are_intersecting (const Point_3D<T> &pt, const Triangle<Point_3D<T>> &tr)
 {
     using detail::Loc_3D;
     using detail::Pt_Wrt_Tr;
     using detail::magic_product;
 
-    auto pt_loc = magic_product (tr.P(), tr.Q(), tr.R(), pt);
+    auto pt_loc = magic_product<Policy> (tr.P(), tr.Q(), tr.R(), pt);
 
     if (pt_loc == Loc_3D::On)
     {
         auto [pt_2d, tr_2d] = detail::space_transformation (pt, tr);
 
-        auto pt_wrt_PQ = magic_product (tr_2d.P(), tr_2d.Q(), pt_2d);
-        auto pt_wrt_QR = magic_product (tr_2d.Q(), tr_2d.R(), pt_2d);
-        auto pt_wrt_RP = magic_product (tr_2d.R(), tr_2d.P(), pt_2d);
+        auto pt_wrt_PQ = magic_product<Policy> (tr_2d.P(), tr_2d.Q(), pt_2d);
+        auto pt_wrt_QR = magic_product<Policy> (tr_2d.Q(), tr_2d.R(), pt_2d);
+        auto pt_wrt_RP = magic_product<Policy> (tr_2d.R(), tr_2d.P(), pt_2d);
 
         auto pt_loc = detail::deduce_pt_location (pt_wrt_PQ, pt_wrt_QR, pt_wrt_RP);
 
@@ -80,10 +80,10 @@ bool are_intersecting (const Point_3D<T> &pt, const Triangle<Point_3D<T>> &tr)
         return false;
 }
 
-template<typename T>
+template<Orientation_Predicates Policy = Tolerant_Predicates, typename T>
 bool are_intersecting (const Triangle<Point_3D<T>> &tr, const Point_3D<T> &pt)
 {
-    return are_intersecting (pt, tr);
+    return are_intersecting<Policy> (pt, tr);
 }
 
 } // namespace yLab::geometry
@@ -10,14 +10,15 @@
 namespace yLab::geometry
 {
 
-template<typename T>
+template<Orientation_Predicates Policy = Tolerant_Predicates, typename T>
 bool are_intersecting (const Segment<Point_3D<T>> &seg_1, const Segment<Point_3D<T>> &seg_2)
 {
     using detail::magic_product;
+    using vector_type = Vector<T, typename Policy::comparison_policy>;
 
-    Vector P1_Q1{seg_1.P(), seg_1.Q()};
-    Vector P2_Q2{seg_2.P(), seg_2.Q()};
-    Vector P1_Q2{seg_1.P(), seg_2.Q()};
+    vector_type P1_Q1{seg_1.P(), seg_1.Q()};
+    vector_type P2_Q2{seg_2.P(), seg_2.Q()};
+    vector_type P1_Q2{seg_1.P(), seg_2.Q()};
 
     if (!are_coplanar (P1_Q1, P2_Q2, P1_Q2))
         return false;
@@ -25,7 +26,7 @@ bool are_intersecting (const Segment<Point_3D<T>> &seg_1, const Segment<Point_3D
     {
         if (are_collinear (P1_Q1, P1_Q2))
         {
-            Vector P2_Q1{seg_2.P(), seg_1.Q()};
+            vector_type P2_Q1{seg_2.P(), seg_1.Q()};
 
             if (are_parallel (P1_Q1, P2_Q2))
                 return are_parallel (P1_Q2, P2_Q1);
@@ -39,8 +40,8 @@ bool are_intersecting (const Segment<Point_3D<T>> &seg_1, const Segment<Point_3D
     {
         auto [seg_1_2d, seg_2_2d] = detail::space_transformation (seg_1, seg_2);
 
-        auto P2_wrt_P1Q1 = magic_product (seg_1_2d.P(), seg_1_2d.Q(), seg_2_2d.P());
-        auto Q2_wrt_P1Q1 = magic_product (seg_1_2d.P(), seg_1_2d.Q(), seg_2_2d.Q());
+        auto P2_wrt_P1Q1 = magic_product<Policy> (seg_1_2d.P(), seg_1_2d.Q(), seg_2_2d.P());
+        auto Q2_wrt_P1Q1 = magic_product<Policy> (seg_1_2d.P(), seg_1_2d.Q(), seg_2_2d.Q());
 
         auto mult_1 = static_cast<int>(P2_wrt_P1Q1) * static_cast<int>(Q2_wrt_P1Q1);
 
@@ -48,8 +49,8 @@ bool are_intersecting (const Segment<Point_3D<T>> &seg_1, const Segment<Point_3D
             return false;
         else
         {
-            auto P1_wrt_P2Q2 = magic_product (seg_2_2d.P(), seg_2_2d.Q(), seg_1_2d.P());
-            auto Q1_wrt_P2Q2 = magic_product (seg_2_2d.P(), seg_2_2d.Q(), seg_1_2d.Q());
+            auto P1_wrt_P2Q2 = magic_product<Policy> (seg_2_2d.P(), seg_2_2d.Q(), seg_1_2d.P());
+            auto Q1_wrt_P2Q2 = magic_product<Policy> (seg_2_2d.P(), seg_2_2d.Q(), seg_1_2d.Q());
 
             auto mult_2 = static_cast<int>(P1_wrt_P2Q2) * static_cast<int>(Q1_wrt_P2Q2);
 
@@ -7,30 +7,34 @@
 #include "magic_product.hpp"
 #include "space_to_plane.hpp"
 #include "intersection_2D.hpp"
+#include "triangle_plane.hpp"
 
 namespace yLab::geometry
 {
 
-template<typename T>
-bool are_intersecting (const Segment<Point_3D<T>> &seg, const Triangle<Point_3D<T>> &tr)
+// plane is the plane of tr, e.g. cached for shapes tested many times
+template<Orientation_Predicates Policy = Tolerant_Predicates, typename T>
+bool are_intersecting (const Segment<Point_3D<T>> &seg, const Triangle<Point_3D<T>> &tr,
+                       const Triangle_Plane<T> &plane)
 {
     using detail::Loc_2D;
     using detail::Loc_3D;
     using detail::magic_product;
 
-    auto P1_loc = magic_product (tr.P(), tr.Q(), tr.R(), seg.P());
-    auto Q1_loc = magic_product (tr.P(), tr.Q(), tr.R(), seg.Q());
+    auto P1_loc = magic_product<Policy> (tr, plane, seg.P());
+    auto Q1_loc = magic_product<Policy> (tr, plane, seg.Q());
 
     if (P1_loc == Q1_loc)
     {
         if (P1_loc == Loc_3D::On)
         {
-            auto [seg_2d, tr_2d] = detail::space_transformation (seg, tr);
+            auto seg_2d = detail::project_segment (seg, plane.axis);
+            auto tr_2d = detail::project_triangle (tr, plane.axis);
 
-            if (magic_product (tr_2d.P(), tr_2d.Q(), tr_2d.R()) != Loc_2D::Positive)
+            if (magic_product<Policy> (tr_2d.P(), tr_2d.Q(), tr_2d.R()) != Loc_2D::Positive)
                 tr_2d.swap_QR();
 
-            return detail::are_intersecting_2D (seg_2d, tr_2d);
+            return detail::are_intersecting_2D<Policy> (seg_2d, tr_2d);
         }
         else
             return false;
@@ -38,19 +42,29 @@ bool are_intersecting (const Segment<Point_3D<T>> &seg, const Triangle<Point_3D<
     else
     {
         auto seg_copy = seg;
-        if (magic_product (tr.P(), tr.Q(), tr.R(), seg_copy.Q()) != Loc_3D::Below)
+        if (Q1_loc != Loc_3D::Below)
             seg_copy.swap_points();
 
-        return (magic_product (seg_copy.P(), tr.P(), tr.Q(), seg_copy.Q()) != Loc_3D::Above &&
-                magic_product (seg_copy.P(), tr.Q(), tr.R(), seg_copy.Q()) != Loc_3D::Above &&
-                magic_product (seg_copy.P(), tr.R(), tr.P(), seg_copy.Q()) != Loc_3D::Above);
+        auto is_not_above = [&seg_copy](const Point_3D<T> &A, const Point_3D<T> &B)
+        {
+            return magic_product<Policy> (seg_copy.P(), A, B, seg_copy.Q()) != Loc_3D::Above;
+        };
+
+        return (is_not_above (tr.P(), tr.Q()) && is_not_above (tr.Q(), tr.R()) &&
+                is_not_above (tr.R(), tr.P()));
     }
 }
 
-template<typename T>
+template<Orientation_Predicates Policy = Tolerant_Predicates, typename T>
+bool are_intersecting (const Segment<Point_3D<T>> &seg, const Triangle<Point_3D<T>> &tr)
+{
+    return are_intersecting<Policy> (seg, tr, Triangle_Plane<T>{tr});
+}
+
+template<Orientation_Predicates Policy = Tolerant_Predicates, typename T>
 bool are_intersecting (const Triangle<Point_3D<T>> &tr, const Segment<Point_3D<T>> &seg)
 {
-    return are_intersecting (seg, tr);
+    return are_intersecting<Policy> (seg, tr);
 }
 
 } // namespace yLab::geometry
@@ -18,8 +18,8 @@ namespace detail
 
 enum class Axes { x, y, z };
 
-template<typename T>
-Axes deduce_coordinate_to_set_zero (const Vector<T> &norm)
+template<typename T, typename C>
+Axes deduce_coordinate_to_set_zero (const Vector<T, C> &norm)
 {
     auto x = std::abs (norm.x_);
     auto y = std::abs (norm.y_);
@@ -0,0 +1,519 @@
+#ifndef INCLUDE_INTERSECTION_TRIANGLE_BLOCK_HPP
+#define INCLUDE_INTERSECTION_TRIANGLE_BLOCK_HPP
+
+#include <array>
+#include <algorithm>
+#include <limits>
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+
+#if defined (__AVX__) || defined (__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include "double_comparison.hpp"
+#include "point.hpp"
+#include "triangle.hpp"
+#include "magic_product.hpp"
+
+namespace yLab::geometry
+{
+
+/*
+ * Up to N triangles stored by coordinates: every coordinate of every vertex is an array
+ * of N values (lanes), so that one triangle is tested against the whole block with SIMD
+ * instructions (see detail::Simd_Lanes).
+ */
+template<typename T, std::size_t N = 8>
+requires (N > 0 && N <= 32)
+class Triangle_Block final
+{
+public:
+
+    using distance_type = T;
+    using triangle_type = Triangle<Point_3D<distance_type>>;
+    using lanes_type = std::array<distance_type, N>;
+    using size_type = std::size_t;
+
+    static constexpr size_type capacity () noexcept { return N; }
+
+private:
+
+    std::array<lanes_type, 9> coordinates_{};
+    size_type size_ = 0;
+
+public:
+
+    size_type size () const noexcept { return size_; }
+    bool empty () const noexcept { return size_ == 0; }
+    bool full () const noexcept { return size_ == N; }
+
+    void clear () noexcept { size_ = 0; }
+
+    void push_back (const triangle_type &tr)
+    {
+        for (auto vertex = 0u; vertex != 3; ++vertex)
+            for (auto axis = 0u; axis != 3; ++axis)
+                coordinates_[3 * vertex + axis][size_] = tr.begin()[vertex][axis];
+
+        ++size_;
+    }
+
+    // Coordinate axis of vertex (0 for P, 1 for Q, 2 for R) of all lanes
+    const lanes_type &coordinates (unsigned vertex, unsigned axis) const
+    {
+        return coordinates_[3 * vertex + axis];
+    }
+};
+
+namespace detail
+{
+
+/*
+ * Registers of the widest instruction set enabled at compile time: 8 floats or 4 doubles
+ * with AVX (e.g. -mavx2 or -march=native), 4 floats or 2 doubles with SSE2, which every
+ * x86-64 target has. Other targets and types have no specialisation and use plain loops.
+ * Products are computed in the order of plane_normal () and plane_product ().
+ */
+template<typename T>
+struct Simd_Lanes;
+
+#if defined (__AVX__)
+
+template<>
+struct Simd_Lanes<float> final
+{
+    using register_type = __m256;
+    static constexpr std::size_t width = 8;
+
+    static register_type load (const float *lanes) { return _mm256_loadu_ps (lanes); }
+    static register_type broadcast (float value) { return _mm256_set1_ps (value); }
+
+    static register_type add (register_type a, register_type b) { return _mm256_add_ps (a, b); }
+    static register_type sub (register_type a, register_type b) { return _mm256_sub_ps (a, b); }
+    static register_type mul (register_type a, register_type b) { return _mm256_mul_ps (a, b); }
+    static register_type min (register_type a, register_type b) { return _mm256_min_ps (a, b); }
+    static register_type max (register_type a, register_type b) { return _mm256_max_ps (a, b); }
+    static register_type abs (register_type a)
+    {
+        return _mm256_andnot_ps (_mm256_set1_ps (-0.0f), a);
+    }
+
+    static register_type greater_equal (register_type a, register_type b)
+    {
+        return _mm256_cmp_ps (a, b, _CMP_GE_OQ);
+    }
+    static register_type greater (register_type a, register_type b)
+    {
+        return _mm256_cmp_ps (a, b, _CMP_GT_OQ);
+    }
+
+    static register_type bit_or (register_type a, register_type b) { return _mm256_or_ps (a, b); }
+    static register_type bit_and (register_type a, register_type b)
+    {
+        return _mm256_and_ps (a, b);
+    }
+    static register_type and_not (register_type a, register_type b) // ~a & b
+    {
+        return _mm256_andnot_ps (a, b);
+    }
+
+    static std::uint32_t mask (register_type a) { return _mm256_movemask_ps (a); }
+};
+
+template<>
+struct Simd_Lanes<double> final
+{
+    using register_type = __m256d;
+    static constexpr std::size_t width = 4;
+
+    static register_type load (const double *lanes) { return _mm256_loadu_pd (lanes); }
+    static register_type broadcast (double value) { return _mm256_set1_pd (value); }
+
+    static register_type add (register_type a, register_type b) { return _mm256_add_pd (a, b); }
+    static register_type sub (register_type a, register_type b) { return _mm256_sub_pd (a, b); }
+    static register_type mul (register_type a, register_type b) { return _mm256_mul_pd (a, b); }
+    static register_type min (register_type a, register_type b) { return _mm256_min_pd (a, b); }
+    static register_type max (register_type a, register_type b) { return _mm256_max_pd (a, b); }
+    static register_type abs (register_type a)
+    {
+        return _mm256_andnot_pd (_mm256_set1_pd (-0.0), a);
+    }
+
+    static register_type greater_equal (register_type a, register_type b)
+    {
+        return _mm256_cmp_pd (a, b, _CMP_GE_OQ);
+    }
+    static register_type greater (register_type a, register_type b)
+    {
+        return _mm256_cmp_pd (a, b, _CMP_GT_OQ);
+    }
+
+    static register_type bit_or (register_type a, register_type b) { return _mm256_or_pd (a, b); }
+    static register_type bit_and (register_type a, register_type b)
+    {
+        return _mm256_and_pd (a, b);
+    }
+    static register_type and_not (register_type a, register_type b) // ~a & b
+    {
+        return _mm256_andnot_pd (a, b);
+    }
+
+    static std::uint32_t mask (register_type a) { return _mm256_movemask_pd (a); }
+};
+
+#elif defined (__SSE2__)
+
+template<>
+struct Simd_Lanes<float> final
+{
+    using register_type = __m128;
+    static constexpr std::size_t width = 4;
+
+    static register_type load (const float *lanes) { return _mm_loadu_ps (lanes); }
+    static register_type broadcast (float value) { return _mm_set1_ps (value); }
+
+    static register_type add (register_type a, register_type b) { return _mm_add_ps (a, b); }
+    static register_type sub (register_type a, register_type b) { return _mm_sub_ps (a, b); }
+    static register_type mul (register_type a, register_type b) { return _mm_mul_ps (a, b); }
+    static register_type min (register_type a, register_type b) { return _mm_min_ps (a, b); }
+    static register_type max (register_type a, register_type b) { return _mm_max_ps (a, b); }
+    static register_type abs (register_type a)
+    {
+        return _mm_andnot_ps (_mm_set1_ps (-0.0f), a);
+    }
+
+    static register_type greater_equal (register_type a, register_type b)
+    {
+        return _mm_cmpge_ps (a, b);
+    }
+    static register_type greater (register_type a, register_type b) { return _mm_cmpgt_ps (a, b); }
+
+    static register_type bit_or (register_type a, register_type b) { return _mm_or_ps (a, b); }
+    static register_type bit_and (register_type a, register_type b) { return _mm_and_ps (a, b); }
+    static register_type and_not (register_type a, register_type b) // ~a & b
+    {
+        return _mm_andnot_ps (a, b);
+    }
+
+    static std::uint32_t mask (register_type a) { return _mm_movemask_ps (a); }
+};
+
+template<>
+struct Simd_Lanes<double> final
+{
+    using register_type = __m128d;
+    static constexpr std::size_t width = 2;
+
+    static register_type load (const double *lanes) { return _mm_loadu_pd (lanes); }
+    static register_type broadcast (double value) { return _mm_set1_pd (value); }
+
+    static register_type add (register_type a, register_type b) { return _mm_add_pd (a, b); }
+    static register_type sub (register_type a, register_type b) { return _mm_sub_pd (a, b); }
+    static register_type mul (register_type a, register_type b) { return _mm_mul_pd (a, b); }
+    static register_type min (register_type a, register_type b) { return _mm_min_pd (a, b); }
+    static register_type max (register_type a, register_type b) { return _mm_max_pd (a, b); }
+    static register_type abs (register_type a)
+    {
+        return _mm_andnot_pd (_mm_set1_pd (-0.0), a);
+    }
+
+    static register_type greater_equal (register_type a, register_type b)
+    {
+        return _mm_cmpge_pd (a, b);
+    }
+    static register_type greater (register_type a, register_type b) { return _mm_cmpgt_pd (a, b); }
+
+    static register_type bit_or (register_type a, register_type b) { return _mm_or_pd (a, b); }
+    static register_type bit_and (register_type a, register_type b) { return _mm_and_pd (a, b); }
+    static register_type and_not (register_type a, register_type b) // ~a & b
+    {
+        return _mm_andnot_pd (a, b);
+    }
+
+    static std::uint32_t mask (register_type a) { return _mm_movemask_pd (a); }
+};
+
+#endif
+
+// The compiler may contract multiplies and adds of the scalar code and of the registers
+#if defined (__FMA__)
+inline constexpr bool has_fused_multiply_add = true;
+#else
+inline constexpr bool has_fused_multiply_add = false;
+#endif
+
+// Blocks of N lanes of type T fill whole registers of Simd_Lanes<T>
+template<typename T, std::size_t N>
+concept Has_Simd_Lanes = requires { Simd_Lanes<T>::width; } && (N % Simd_Lanes<T>::width == 0);
+
+/*
+ * separated_by_planes () for a register of lanes at a time.
+ * Without FMA every lane is rounded as the scalar code is. With FMA (e.g. -march=native)
+ * either code may be contracted, so every product gets a bound of the rounding error of
+ * either computation, and a lane is only separated if it is separated for all the products
+ * within those bounds. The lanes left are a few lanes touching the planes, which the full
+ * test handles as before.
+ */
+template<typename T, std::size_t N>
+requires Has_Simd_Lanes<T, N>
+std::uint32_t separated_by_planes_simd (const Triangle<Point_3D<T>> &tr,
+                                        const Triangle_Block<T, N> &block)
+{
+    using lanes = Simd_Lanes<T>;
+    using register_type = typename lanes::register_type;
+
+    // Registers can't be template arguments without losing their alignment attributes
+    struct vector_type final
+    {
+        register_type coordinates[3];
+
+        register_type operator[] (std::size_t i) const { return coordinates[i]; }
+    };
+
+    struct Product final
+    {
+        register_type value;
+        register_type error;
+    };
+
+    struct Classes final
+    {
+        register_type is_aside;
+        register_type is_on;
+        register_type is_off; // isn't On
+    };
+
+    constexpr auto epsilon = cmp::cmp_precision<T>::epsilon;
+
+    // Either computation is within 8 units of roundoff of the exact product times the sum of
+    // the magnitudes of its terms, so two of them differ by at most 16; the scale doubles that
+    constexpr auto error_scale = 16 * std::numeric_limits<T>::epsilon();
+
+    using point_type = std::array<T, 3>;
+
+    point_type A{tr.P().x(), tr.P().y(), tr.P().z()};
+    point_type B{tr.Q().x(), tr.Q().y(), tr.Q().z()};
+    point_type C{tr.R().x(), tr.R().y(), tr.R().z()};
+
+    auto tr_normal = plane_normal (A, B, C);
+
+    // Sums of the magnitudes of the terms of the coordinates of the normal of tr
+    point_type AB{B[0] - A[0], B[1] - A[1], B[2] - A[2]};
+    point_type AC{C[0] - A[0], C[1] - A[1], C[2] - A[2]};
+    point_type tr_magnitude{std::abs (AB[1] * AC[2]) + std::abs (AB[2] * AC[1]),
+                            std::abs (AB[2] * AC[0]) + std::abs (AB[0] * AC[2]),
+                            std::abs (AB[0] * AC[1]) + std::abs (AB[1] * AC[0])};
+
+    auto broadcast = [](const point_type &v)
+    {
+        return vector_type{{lanes::broadcast (v[0]), lanes::broadcast (v[1]),
+                            lanes::broadcast (v[2])}};
+    };
+
+    auto tr_A = broadcast (A);
+    auto tr_B = broadcast (B);
+    auto tr_C = broadcast (C);
+    auto tr_N = broadcast (tr_normal);
+    auto tr_N_magnitude = broadcast (tr_magnitude);
+
+    auto plus_epsilon = lanes::broadcast (epsilon);
+    auto minus_epsilon = lanes::broadcast (-epsilon);
+    auto scale = lanes::broadcast (error_scale);
+
+    auto difference = [](const vector_type &lhs, const vector_type &rhs)
+    {
+        return vector_type{{lanes::sub (lhs[0], rhs[0]), lanes::sub (lhs[1], rhs[1]),
+                            lanes::sub (lhs[2], rhs[2])}};
+    };
+
+    // plane_product (normal, P, M) and the bound of its error
+    auto product = [&](const vector_type &normal, const vector_type &magnitude,
+                       const vector_type &P, const vector_type &M)
+    {
+        auto PM = difference (M, P);
+
+        auto value = lanes::add (lanes::add (lanes::mul (normal[0], PM[0]),
+                                             lanes::mul (normal[1], PM[1])),
+                                 lanes::mul (normal[2], PM[2]));
+        auto error = lanes::add (lanes::add (lanes::mul (magnitude[0], lanes::abs (PM[0])),
+                                             lanes::mul (magnitude[1], lanes::abs (PM[1]))),
+                                 lanes::mul (magnitude[2], lanes::abs (PM[2])));
+
+        return Product{value, lanes::mul (scale, error)};
+    };
+
+    // Whether the 3 products are surely all at least epsilon or all at most -epsilon,
+    // surely all within epsilon of 0 and surely not all within epsilon of 0
+    auto classify = [&](const Product &product_0, const Product &product_1,
+                        const Product &product_2)
+    {
+        auto min = lanes::min (lanes::min (product_0.value, product_1.value), product_2.value);
+        auto max = lanes::max (lanes::max (product_0.value, product_1.value), product_2.value);
+
+        // Without FMA the bounds are dropped along with the computation of the errors
+        auto outer = plus_epsilon;
+        auto minus_outer = minus_epsilon;
+        auto inner = plus_epsilon;
+        auto minus_inner = minus_epsilon;
+
+        if constexpr (has_fused_multiply_add)
+        {
+            auto error = lanes::max (lanes::max (product_0.error, product_1.error),
+                                     product_2.error);
+
+            outer = lanes::add (plus_epsilon, error);
+            minus_outer = lanes::sub (minus_epsilon, error);
+            inner = lanes::sub (plus_epsilon, error);
+            minus_inner = lanes::add (minus_epsilon, error);
+        }
+
+        return Classes{lanes::bit_or (lanes::greater_equal (min, outer),
+                                      lanes::greater_equal (minus_outer, max)),
+                       lanes::bit_and (lanes::greater (min, minus_inner),
+                                       lanes::greater (inner, max)),
+                       lanes::bit_or (lanes::greater_equal (max, outer),
+                                      lanes::greater_equal (minus_outer, min))};
+    };
+
+    std::uint32_t separated = 0;
+
+    // All N lanes are tested, so that the loop is unrolled; the lanes past the size are dropped
+    for (std::size_t first = 0; first != N; first += lanes::width)
+    {
+        auto vertex = [&block, first](unsigned i)
+        {
+            return vector_type{{lanes::load (block.coordinates (i, 0).data() + first),
+                                lanes::load (block.coordinates (i, 1).data() + first),
+                                lanes::load (block.coordinates (i, 2).data() + first)}};
+        };
+
+        auto P = vertex (0);
+        auto Q = vertex (1);
+        auto R = vertex (2);
+
+        auto PQ = difference (Q, P);
+        auto PR = difference (R, P);
+
+        // plane_normal (P, Q, R) and the sums of the magnitudes of its terms
+        register_type terms[3][2] = {{lanes::mul (PQ[1], PR[2]), lanes::mul (PQ[2], PR[1])},
+                                     {lanes::mul (PQ[2], PR[0]), lanes::mul (PQ[0], PR[2])},
+                                     {lanes::mul (PQ[0], PR[1]), lanes::mul (PQ[1], PR[0])}};
+
+        vector_type lane_normal{{lanes::sub (terms[0][0], terms[0][1]),
+                                 lanes::sub (terms[1][0], terms[1][1]),
+                                 lanes::sub (terms[2][0], terms[2][1])}};
+        vector_type lane_magnitude{{
+            lanes::add (lanes::abs (terms[0][0]), lanes::abs (terms[0][1])),
+            lanes::add (lanes::abs (terms[1][0]), lanes::abs (terms[1][1])),
+            lanes::add (lanes::abs (terms[2][0]), lanes::abs (terms[2][1]))}};
+
+        auto tr_classes = classify (product (lane_normal, lane_magnitude, P, tr_A),
+                                    product (lane_normal, lane_magnitude, P, tr_B),
+                                    product (lane_normal, lane_magnitude, P, tr_C));
+        auto lane_classes = classify (product (tr_N, tr_N_magnitude, tr_A, P),
+                                      product (tr_N, tr_N_magnitude, tr_A, Q),
+                                      product (tr_N, tr_N_magnitude, tr_A, R));
+
+        // Coplanar triangles (all vertices of tr are On) need the 2D test
+        auto is_separated = lanes::bit_or (
+            tr_classes.is_aside,
+            lanes::bit_and (tr_classes.is_off, lanes::bit_or (lane_classes.is_aside,
+                                                              lane_classes.is_on)));
+
+        separated |= lanes::mask (is_separated) << first;
+    }
+
+    return separated & static_cast<std::uint32_t>((std::uint64_t{1} << block.size()) - 1);
+}
+
+/*
+ * The first stage of are_intersecting (tr, block[i]) for all lanes at once: the lanes whose
+ * plane has tr strictly on one side of it or whose vertices are all on one side of the plane
+ * of tr. The orientations are computed as Triangle_Plane does, so every returned lane is
+ * rejected by planes in are_intersecting () too; the other lanes need the full test.
+ */
+template<typename T, std::size_t N>
+std::uint32_t separated_by_planes (const Triangle<Point_3D<T>> &tr,
+                                   const Triangle_Block<T, N> &block)
+{
+    if constexpr (Has_Simd_Lanes<T, N>)
+        return separated_by_planes_simd (tr, block);
+
+    constexpr auto epsilon = cmp::cmp_precision<T>::epsilon;
+
+    using point_type = std::array<T, 3>;
+
+    point_type A{tr.P().x(), tr.P().y(), tr.P().z()};
+    point_type B{tr.Q().x(), tr.Q().y(), tr.Q().z()};
+    point_type C{tr.R().x(), tr.R().y(), tr.R().z()};
+
+    auto &Px = block.coordinates (0, 0);
+    auto &Py = block.coordinates (0, 1);
+    auto &Pz = block.coordinates (0, 2);
+    auto &Qx = block.coordinates (1, 0);
+    auto &Qy = block.coordinates (1, 1);
+    auto &Qz = block.coordinates (1, 2);
+    auto &Rx = block.coordinates (2, 0);
+    auto &Ry = block.coordinates (2, 1);
+    auto &Rz = block.coordinates (2, 2);
+
+    auto tr_normal = plane_normal (A, B, C);
+
+    // Orientations of the vertices of tr with respect to the plane of the lane and vice versa
+    std::array<std::array<T, N>, 3> tr_products;
+    std::array<std::array<T, N>, 3> lane_products;
+
+    for (std::size_t lane = 0; lane != N; ++lane)
+    {
+        point_type P{Px[lane], Py[lane], Pz[lane]};
+        point_type Q{Qx[lane], Qy[lane], Qz[lane]};
+        point_type R{Rx[lane], Ry[lane], Rz[lane]};
+
+        auto lane_normal = plane_normal (P, Q, R);
+
+        tr_products[0][lane] = plane_product (lane_normal, P, A);
+        tr_products[1][lane] = plane_product (lane_normal, P, B);
+        tr_products[2][lane] = plane_product (lane_normal, P, C);
+
+        lane_products[0][lane] = plane_product (tr_normal, A, P);
+        lane_products[1][lane] = plane_product (tr_normal, A, Q);
+        lane_products[2][lane] = plane_product (tr_normal, A, R);
+    }
+
+    // Three products have the same Loc_3D if they are all Above, all Below or all On.
+    // The classification is kept apart from the products and free of branches, so that
+    // both loops vectorise
+    std::array<T, N> is_separated;
+
+    for (std::size_t lane = 0; lane != N; ++lane)
+    {
+        auto tr_min = std::min ({tr_products[0][lane], tr_products[1][lane], tr_products[2][lane]});
+        auto tr_max = std::max ({tr_products[0][lane], tr_products[1][lane], tr_products[2][lane]});
+        auto lane_min = std::min ({lane_products[0][lane], lane_products[1][lane],
+                                   lane_products[2][lane]});
+        auto lane_max = std::max ({lane_products[0][lane], lane_products[1][lane],
+                                   lane_products[2][lane]});
+
+        auto is_tr_aside = (tr_min >= epsilon) | (tr_max <= -epsilon);
+        auto is_tr_on = (tr_min > -epsilon) & (tr_max < epsilon);
+        auto is_lane_aside = (lane_min >= epsilon) | (lane_max <= -epsilon) |
+                             ((lane_min > -epsilon) & (lane_max < epsilon));
+
+        // Coplanar triangles (all vertices of tr are On) need the 2D test
+        is_separated[lane] = T(is_tr_aside | ((!is_tr_on) & is_lane_aside));
+    }
+
+    std::uint32_t separated = 0;
+    for (std::size_t lane = 0; lane != block.size(); ++lane)
+        separated |= std::uint32_t{is_separated[lane] != 0} << lane;
+
+    return separated;
+}
+
+} // namespace detail
+
+} // namespace yLab::geometry
+
+#endif // INCLUDE_INTERSECTION_TRIANGLE_BLOCK_HPP
@@ -0,0 +1,74 @@
+#ifndef INCLUDE_INTERSECTION_TRIANGLE_PLANE_HPP
+#define INCLUDE_INTERSECTION_TRIANGLE_PLANE_HPP
+
+#include <array>
+
+#include "point.hpp"
+#include "triangle.hpp"
+#include "vector.hpp"
+
+#include "magic_product.hpp"
+#include "space_to_plane.hpp"
+
+namespace yLab::geometry
+{
+
+/*
+ * The plane of a triangle computed once: the location of a point with respect to the triangle
+ * costs one dot product instead of a 3x3 determinant. The plane is kept as the normal and
+ * the vertex P rather than the normal and an offset: normal * (M - P) has the precision
+ * of magic_product (), while normal * M - offset cancels for shapes far from the origin.
+ */
+template<typename T>
+struct Triangle_Plane final
+{
+    std::array<T, 3> normal{};
+    std::array<T, 3> origin{};
+    detail::Axes axis = detail::Axes::z; // the coordinate to set zero in 2D tests
+
+    Triangle_Plane () = default;
+
+    explicit Triangle_Plane (const Triangle<Point_3D<T>> &tr)
+                            : normal{detail::plane_normal (coordinates (tr.P()),
+                                                           coordinates (tr.Q()),
+                                                           coordinates (tr.R()))},
+                              origin{coordinates (tr.P())},
+                              axis{detail::deduce_coordinate_to_set_zero (
+                                       Vector<T>{normal[0], normal[1], normal[2]})} {}
+
+    static std::array<T, 3> coordinates (const Point_3D<T> &pt)
+    {
+        return {pt.x(), pt.y(), pt.z()};
+    }
+};
+
+namespace detail
+{
+
+// The same as magic_product<Policy> (tr.P(), tr.Q(), tr.R(), M) for the plane of tr
+template<Orientation_Predicates Policy = Tolerant_Predicates, typename T>
+requires Policy::uses_planes
+Loc_3D magic_product (const Triangle_Plane<T> &plane, const Point_3D<T> &M)
+{
+    using comparison_policy = typename Policy::comparison_policy;
+
+    return location<comparison_policy> (plane_product (plane.normal, plane.origin,
+                                                       Triangle_Plane<T>::coordinates (M)));
+}
+
+// magic_product (tr.P(), tr.Q(), tr.R(), M) by the plane of tr if the policy uses planes
+template<Orientation_Predicates Policy = Tolerant_Predicates, typename T>
+Loc_3D magic_product (const Triangle<Point_3D<T>> &tr, const Triangle_Plane<T> &plane,
+                      const Point_3D<T> &M)
+{
+    if constexpr (Policy::uses_planes)
+        return magic_product<Policy> (plane, M);
+    else
+        return magic_product<Policy> (tr.P(), tr.Q(), tr.R(), M);
+}
+
+} // namespace detail
+
+} // namespace yLab::geometry
+
+#endif // INCLUDE_INTERSECTION_TRIANGLE_PLANE_HPP
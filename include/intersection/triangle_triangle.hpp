@@ -8,6 +8,7 @@
 #include "magic_product.hpp"
 #include "space_to_plane.hpp"
 #include "intersection_2D.hpp"
+#include "triangle_plane.hpp"
 
 namespace yLab::geometry
 {
@@ -15,22 +16,33 @@ namespace yLab::geometry
 namespace detail
 {
 
-template<typename T>
+template<Orientation_Predicates Policy = Tolerant_Predicates, typename T>
 std::tuple<Loc_3D, Loc_3D, Loc_3D> compute_relative_location (const Triangle<Point_3D<T>> &tr_1,
-                                                              const Triangle<Point_3D<T>> &tr_2)
+                                                              const Triangle<Point_3D<T>> &tr_2,
+                                                              const Triangle_Plane<T> &plane_2)
 {
-    auto P1_loc = magic_product (tr_2.P(), tr_2.Q(), tr_2.R(), tr_1.P());
-    auto Q1_loc = magic_product (tr_2.P(), tr_2.Q(), tr_2.R(), tr_1.Q());
-    auto R1_loc = magic_product (tr_2.P(), tr_2.Q(), tr_2.R(), tr_1.R());
+    auto P1_loc = magic_product<Policy> (tr_2, plane_2, tr_1.P());
+    auto Q1_loc = magic_product<Policy> (tr_2, plane_2, tr_1.Q());
+    auto R1_loc = magic_product<Policy> (tr_2, plane_2, tr_1.R());
 
     return std::tuple{P1_loc, Q1_loc, R1_loc};
 }
 
-// P2_loc doesn't change; Q2_loc and R2_loc don't change or they are swapped
+template<Orientation_Predicates Policy = Tolerant_Predicates, typename T>
+std::tuple<Loc_3D, Loc_3D, Loc_3D> compute_relative_location (const Triangle<Point_3D<T>> &tr_1,
+                                                              const Triangle<Point_3D<T>> &tr_2)
+{
+    return compute_relative_location<Policy> (tr_1, tr_2, Triangle_Plane<T>{tr_2});
+}
+
+// P2_loc doesn't change; Q2_loc and R2_loc don't change or they are swapped. Returns true
+// if Q and R of tr_2 are swapped, which turns the normal of tr_2 over
 template<typename T>
-auto transform_triangles (Triangle<Point_3D<T>> &tr_1, Loc_3D P1_loc, Loc_3D Q1_loc, Loc_3D R1_loc,
+bool transform_triangles (Triangle<Point_3D<T>> &tr_1, Loc_3D P1_loc, Loc_3D Q1_loc, Loc_3D R1_loc,
                           Triangle<Point_3D<T>> &tr_2)
 {
+    auto is_swapped = false;
+
     switch (P1_loc)
     {
         case Loc_3D::Above:
@@ -38,12 +50,12 @@ auto transform_triangles (Triangle<Point_3D<T>> &tr_1, Loc_3D P1_loc, Loc_3D Q1_
             if (Q1_loc == Loc_3D::Above && R1_loc != Loc_3D::Above)
             {
                 tr_1.swap_clockwise();
-                tr_2.swap_QR();
+                is_swapped = true;
             }
             else if (Q1_loc != Loc_3D::Above && R1_loc == Loc_3D::Above)
             {
                 tr_1.swap_counterclockwise();
-                tr_2.swap_QR();
+                is_swapped = true;
             }
 
             break;
@@ -53,7 +65,7 @@ auto transform_triangles (Triangle<Point_3D<T>> &tr_1, Loc_3D P1_loc, Loc_3D Q1_
             if (Q1_loc == Loc_3D::Above)
             {
                 if (R1_loc == Loc_3D::Above)
-                    tr_2.swap_QR();
+                    is_swapped = true;
                 else
                     tr_1.swap_counterclockwise();
             }
@@ -62,12 +74,12 @@ auto transform_triangles (Triangle<Point_3D<T>> &tr_1, Loc_3D P1_loc, Loc_3D Q1_
             else if (Q1_loc == Loc_3D::On && R1_loc == Loc_3D::Below)
             {
                 tr_1.swap_clockwise();
-                tr_2.swap_QR();
+                is_swapped = true;
             }
             else if (Q1_loc == Loc_3D::Below && R1_loc == Loc_3D::On)
             {
                 tr_1.swap_counterclockwise();
-                tr_2.swap_QR();
+                is_swapped = true;
             }
 
             break;
@@ -75,42 +87,63 @@ auto transform_triangles (Triangle<Point_3D<T>> &tr_1, Loc_3D P1_loc, Loc_3D Q1_
         case Loc_3D::Below:
 
             if (Q1_loc == R1_loc)
-                tr_2.swap_QR();
+                is_swapped = true;
             else if (Q1_loc == Loc_3D::Below)
                 tr_1.swap_clockwise();
             else if (R1_loc == Loc_3D::Below)
                 tr_1.swap_counterclockwise();
             else
-                tr_2.swap_QR();
+                is_swapped = true;
 
             break;
     }
+
+    if (is_swapped)
+        tr_2.swap_QR();
+
+    return is_swapped;
 }
 
-template<typename T>
-bool are_intersecting_3D (Triangle<Point_3D<T>> tr_1, Triangle<Point_3D<T>> tr_2,
+// The planes keep the orientation of the triangles given: swapping Q and R of a triangle turns
+// its plane over
+template<Orientation_Predicates Policy, typename T>
+bool are_intersecting_3D (Triangle<Point_3D<T>> tr_1, const Triangle_Plane<T> &plane_1,
+                          Triangle<Point_3D<T>> tr_2, const Triangle_Plane<T> &plane_2,
                           Loc_3D P1_loc, Loc_3D Q1_loc, Loc_3D R1_loc)
 {
-    auto [P2_loc, Q2_loc, R2_loc] = detail::compute_relative_location (tr_2, tr_1);
+    auto [P2_loc, Q2_loc, R2_loc] = detail::compute_relative_location<Policy> (tr_2, tr_1, plane_1);
 
     if (P2_loc == Q2_loc && Q2_loc == R2_loc)
         return false;
     else
     {
-        transform_triangles (tr_1, P1_loc, Q1_loc, R1_loc, tr_2);
-        P1_loc = magic_product (tr_2.P(), tr_2.Q(), tr_2.R(), tr_1.P());
-        Q2_loc = magic_product (tr_1.P(), tr_1.Q(), tr_1.R(), tr_2.Q());
-        R2_loc = magic_product (tr_1.P(), tr_1.Q(), tr_1.R(), tr_2.R());
+        // The location of M with respect to tr whose plane is turned over or not
+        auto locate = [](const Triangle<Point_3D<T>> &tr, const Triangle_Plane<T> &plane,
+                         bool is_turned_over, const Point_3D<T> &M)
+        {
+            if constexpr (Policy::uses_planes)
+            {
+                auto loc = magic_product<Policy> (plane, M);
+                return is_turned_over ? opposite (loc) : loc;
+            }
+            else
+                return magic_product<Policy> (tr.P(), tr.Q(), tr.R(), M);
+        };
+
+        auto is_2_turned_over = transform_triangles (tr_1, P1_loc, Q1_loc, R1_loc, tr_2);
+        P1_loc = locate (tr_2, plane_2, is_2_turned_over, tr_1.P());
+        Q2_loc = locate (tr_1, plane_1, false, tr_2.Q());
+        R2_loc = locate (tr_1, plane_1, false, tr_2.R());
 
-        transform_triangles (tr_2, P2_loc, Q2_loc, R2_loc, tr_1);
-        P2_loc = magic_product (tr_1.P(), tr_1.Q(), tr_1.R(), tr_2.P());
+        auto is_1_turned_over = transform_triangles (tr_2, P2_loc, Q2_loc, R2_loc, tr_1);
+        P2_loc = locate (tr_1, plane_1, is_1_turned_over, tr_2.P());
 
         if (P1_loc == Loc_3D::On && P2_loc == Loc_3D::On)
-            return (tr_1.P() == tr_2.P());
+            return are_equal<typename Policy::comparison_policy> (tr_1.P(), tr_2.P());
         else
         {
-            auto KJ_mut_pos = magic_product (tr_1.P(), tr_1.Q(), tr_2.P(), tr_2.Q());
-            auto LI_mut_pos = magic_product (tr_1.P(), tr_1.R(), tr_2.P(), tr_2.R());
+            auto KJ_mut_pos = magic_product<Policy> (tr_1.P(), tr_1.Q(), tr_2.P(), tr_2.Q());
+            auto LI_mut_pos = magic_product<Policy> (tr_1.P(), tr_1.R(), tr_2.P(), tr_2.R());
 
             return (LI_mut_pos != Loc_3D::Below && KJ_mut_pos != Loc_3D::Above);
         }
@@ -119,34 +152,44 @@ bool are_intersecting_3D (Triangle<Point_3D<T>> tr_1, Triangle<Point_3D<T>> tr_2
 
 } // namespace detail
 
-template<typename T>
-bool are_intersecting (const Triangle<Point_3D<T>> &tr_1, const Triangle<Point_3D<T>> &tr_2)
+// plane_1 and plane_2 are the planes of tr_1 and tr_2, e.g. cached for shapes tested many times
+template<Orientation_Predicates Policy = Tolerant_Predicates, typename T>
+bool are_intersecting (const Triangle<Point_3D<T>> &tr_1, const Triangle_Plane<T> &plane_1,
+                       const Triangle<Point_3D<T>> &tr_2, const Triangle_Plane<T> &plane_2)
 {
     using detail::Loc_2D;
     using detail::Loc_3D;
     using detail::magic_product;
 
-    auto [P1_loc, Q1_loc, R1_loc] = detail::compute_relative_location (tr_1, tr_2);
+    auto [P1_loc, Q1_loc, R1_loc] = detail::compute_relative_location<Policy> (tr_1, tr_2, plane_2);
 
     if (P1_loc == Q1_loc && Q1_loc == R1_loc)
     {
         if (P1_loc == Loc_3D::On)
         {
-            auto [tr_1_2d, tr_2_2d] = detail::space_transformation (tr_1, tr_2);
+            auto tr_1_2d = detail::project_triangle (tr_1, plane_1.axis);
+            auto tr_2_2d = detail::project_triangle (tr_2, plane_1.axis);
 
-            if (magic_product (tr_1_2d.P(), tr_1_2d.Q(), tr_1_2d.R()) != Loc_2D::Positive)
+            if (magic_product<Policy> (tr_1_2d.P(), tr_1_2d.Q(), tr_1_2d.R()) != Loc_2D::Positive)
                 tr_1_2d.swap_QR();
 
-            if (magic_product (tr_2_2d.P(), tr_2_2d.Q(), tr_2_2d.R()) != Loc_2D::Positive)
+            if (magic_product<Policy> (tr_2_2d.P(), tr_2_2d.Q(), tr_2_2d.R()) != Loc_2D::Positive)
                 tr_2_2d.swap_QR ();
 
-            return detail::are_intersecting_2D (tr_1_2d, tr_2_2d);
+            return detail::are_intersecting_2D<Policy> (tr_1_2d, tr_2_2d);
         }
         else
             return false;
     }
     else
-        return detail::are_intersecting_3D (tr_1, tr_2, P1_loc, Q1_loc, R1_loc);
+        return detail::are_intersecting_3D<Policy> (tr_1, plane_1, tr_2, plane_2,
+                                                    P1_loc, Q1_loc, R1_loc);
+}
+
+template<Orientation_Predicates Policy = Tolerant_Predicates, typename T>
+bool are_intersecting (const Triangle<Point_3D<T>> &tr_1, const Triangle<Point_3D<T>> &tr_2)
+{
+    return are_intersecting<Policy> (tr_1, Triangle_Plane<T>{tr_1}, tr_2, Triangle_Plane<T>{tr_2});
 }
 
 } // namespace yLab::geometry
@@ -0,0 +1,119 @@
+#ifndef INCLUDE_MPMC_QUEUE_HPP
+#define INCLUDE_MPMC_QUEUE_HPP
+
+#include <atomic>
+#include <algorithm>
+#include <memory>
+#include <bit>
+#include <cstddef>
+#include <type_traits>
+
+namespace yLab
+{
+
+/*
+ * Bounded lock-free multi-producer multi-consumer queue by D. Vyukov.
+ *
+ * Every cell has a sequence number telling whether the cell is ready to be written by the
+ * producer with ticket pos (sequence == pos) or read by the consumer with ticket pos
+ * (sequence == pos + 1). Producers and consumers only contend on their own position counter.
+ */
+template<typename T>
+requires std::is_trivially_copyable_v<T>
+class MPMC_Queue final
+{
+public:
+
+    using value_type = T;
+    using size_type = std::size_t;
+
+private:
+
+    static constexpr size_type cache_line_size_ = 64;
+
+    struct Cell final
+    {
+        std::atomic<size_type> sequence;
+        value_type data;
+    };
+
+    std::unique_ptr<Cell[]> buffer_;
+    size_type mask_;
+
+    alignas(cache_line_size_) std::atomic<size_type> enqueue_pos_{0};
+    alignas(cache_line_size_) std::atomic<size_type> dequeue_pos_{0};
+
+public:
+
+    // Capacity is rounded up to the nearest power of 2
+    explicit MPMC_Queue (size_type capacity)
+                        : mask_{std::bit_ceil (std::max (capacity, size_type{2})) - 1}
+    {
+        buffer_ = std::make_unique<Cell[]>(mask_ + 1);
+
+        for (size_type i = 0; i <= mask_; ++i)
+            buffer_[i].sequence.store (i, std::memory_order_relaxed);
+    }
+
+    MPMC_Queue (const MPMC_Queue &) = delete;
+    MPMC_Queue &operator= (const MPMC_Queue &) = delete;
+
+    size_type capacity () const noexcept { return mask_ + 1; }
+
+    bool try_push (const value_type &value)
+    {
+        auto pos = enqueue_pos_.load (std::memory_order_relaxed);
+
+        for (;;)
+        {
+            auto &cell = buffer_[pos & mask_];
+            auto sequence = cell.sequence.load (std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+
+            if (diff == 0)
+            {
+                if (enqueue_pos_.compare_exchange_weak (pos, pos + 1, std::memory_order_relaxed))
+                {
+                    cell.data = value;
+                    cell.sequence.store (pos + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0)
+                return false; // the queue is full
+            else
+                pos = enqueue_pos_.load (std::memory_order_relaxed);
+        }
+    }
+
+    bool try_pop (value_type &value)
+    {
+        auto pos = dequeue_pos_.load (std::memory_order_relaxed);
+
+        for (;;)
+        {
+            auto &cell = buffer_[pos & mask_];
+            auto sequence = cell.sequence.load (std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(sequence) -
+                        static_cast<std::ptrdiff_t>(pos + 1);
+
+            if (diff == 0)
+            {
+                if (dequeue_pos_.compare_exchange_weak (pos, pos + 1, std::memory_order_relaxed))
+                {
+                    value = cell.data;
+                    cell.sequence.store (pos + mask_ + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0)
+                return false; // the queue is empty
+            else
+                pos = dequeue_pos_.load (std::memory_order_relaxed);
+        }
+    }
+};
+
+} // namespace yLab
+
+#endif // INCLUDE_MPMC_QUEUE_HPP
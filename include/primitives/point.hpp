@@ -39,12 +39,16 @@ public:
     bool is_valid () const { return !std::isnan(x()) && !std::isnan(y()); }
 };
 
-template<typename T>
-bool operator== (const Point_2D<T> &lhs, const Point_2D<T> &rhs)
+// Points are equal if all their coordinates are equal by the comparison policy C
+template<cmp::Comparison_Policy C = cmp::Tolerant, typename T>
+bool are_equal (const Point_2D<T> &lhs, const Point_2D<T> &rhs)
 {
-    return (cmp::are_equal (lhs.x(), rhs.x()) && cmp::are_equal (lhs.y(), rhs.y()));
+    return (C::are_equal (lhs.x(), rhs.x()) && C::are_equal (lhs.y(), rhs.y()));
 }
 
+template<typename T>
+bool operator== (const Point_2D<T> &lhs, const Point_2D<T> &rhs) { return are_equal (lhs, rhs); }
+
 template<typename T>
 T distance (const Point_2D<T> &first, const Point_2D<T> &second)
 {
@@ -99,13 +103,16 @@ public:
     bool is_valid () const { return !std::isnan(x()) && !std::isnan(y()) && !std::isnan(z()); }
 };
 
-template<typename T>
-bool operator== (const Point_3D<T> &lhs, const Point_3D<T> &rhs)
+template<cmp::Comparison_Policy C = cmp::Tolerant, typename T>
+bool are_equal (const Point_3D<T> &lhs, const Point_3D<T> &rhs)
 {
-    return (cmp::are_equal (lhs.x(), rhs.x()) && cmp::are_equal (lhs.y(), rhs.y()) &&
-            cmp::are_equal (lhs.z(), rhs.z()));
+    return (C::are_equal (lhs.x(), rhs.x()) && C::are_equal (lhs.y(), rhs.y()) &&
+            C::are_equal (lhs.z(), rhs.z()));
 }
 
+template<typename T>
+bool operator== (const Point_3D<T> &lhs, const Point_3D<T> &rhs) { return are_equal (lhs, rhs); }
+
 template<typename T>
 T distance (const Point_3D<T> &first, const Point_3D<T> &second)
 {
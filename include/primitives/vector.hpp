@@ -14,10 +14,16 @@ namespace yLab
 namespace geometry
 {
 
-template<typename T>
+/*
+ * The comparison policy C decides when components are equal: cmp::Tolerant snaps the results
+ * of arithmetic on nearly equal components to zero, cmp::Raw leaves them as computed.
+ */
+template<typename T, cmp::Comparison_Policy C = cmp::Tolerant>
 requires std::is_floating_point_v<T>
 struct Vector final
 {
+    using comparison_policy = C;
+
     T x_, y_;
     T z_ = T{};
 
@@ -26,25 +32,25 @@ struct Vector final
     Vector (const Point_3D<T> &pt) : x_ {pt.x()}, y_{pt.y()}, z_{pt.z()} {}
 
     Vector (const Point_3D<T> &first, const Point_3D<T> &second)
-           : x_ {cmp::are_equal (first.x(), second.x()) ? T{} : second.x() - first.x()},
-             y_ {cmp::are_equal (first.y(), second.y()) ? T{} : second.y() - first.y()},
-             z_ {cmp::are_equal (first.z(), second.z()) ? T{} : second.z() - first.z()} {}
+           : x_ {C::difference (second.x(), first.x())},
+             y_ {C::difference (second.y(), first.y())},
+             z_ {C::difference (second.z(), first.z())} {}
 
     Vector (const Point_2D<T> &first, const Point_2D<T> &second)
-           : x_ {cmp::are_equal (first.x(), second.x()) ? T{} : second.x() - first.x()},
-             y_ {cmp::are_equal (first.y(), second.y()) ? T{} : second.y() - first.y()} {}
+           : x_ {C::difference (second.x(), first.x())},
+             y_ {C::difference (second.y(), first.y())} {}
 
     bool operator== (const Vector &other) const
     {
-        return (cmp::are_equal (x_, other.x_) && cmp::are_equal (y_, other.y_) &&
-                cmp::are_equal (z_, other.z_));
+        return (C::are_equal (x_, other.x_) && C::are_equal (y_, other.y_) &&
+                C::are_equal (z_, other.z_));
     }
 
     Vector &operator+= (const Vector &rhs)
     {
-        x_ = cmp::are_equal (x_, -rhs.x_) ? T{} : x_ + rhs.x_;
-        y_ = cmp::are_equal (y_, -rhs.y_) ? T{} : y_ + rhs.y_;
-        z_ = cmp::are_equal (z_, -rhs.z_) ? T{} : z_ + rhs.z_;
+        x_ = C::sum (x_, rhs.x_);
+        y_ = C::sum (y_, rhs.y_);
+        z_ = C::sum (z_, rhs.z_);
 
         return *this;
     }
@@ -57,9 +63,9 @@ struct Vector final
 
     Vector &operator-= (const Vector &rhs)
     {
-        x_ = cmp::are_equal (x_, rhs.x_) ? T{} : x_ - rhs.x_;
-        y_ = cmp::are_equal (y_, rhs.y_) ? T{} : y_ - rhs.y_;
-        z_ = cmp::are_equal (z_, rhs.z_) ? T{} : z_ - rhs.z_;
+        x_ = C::difference (x_, rhs.x_);
+        y_ = C::difference (y_, rhs.y_);
+        z_ = C::difference (z_, rhs.z_);
 
         return *this;
     }
@@ -102,103 +108,102 @@ struct Vector final
 
     bool is_zero () const
     {
-        return (cmp::is_zero (x_) && cmp::is_zero (y_) && cmp::is_zero (z_));
+        return (C::is_zero (x_) && C::is_zero (y_) && C::is_zero (z_));
     }
 };
 
-template<typename T>
-Vector<T> operator* (const Vector<T> &vec, T coeff)
+template<typename T, typename C>
+Vector<T, C> operator* (const Vector<T, C> &vec, T coeff)
 {
     auto product = vec;
     return (product *= coeff);
 }
 
-template<typename T>
-Vector<T> operator* (T coeff, const Vector<T> &vec) { return vec * coeff; }
+template<typename T, typename C>
+Vector<T, C> operator* (T coeff, const Vector<T, C> &vec) { return vec * coeff; }
 
 // Products
 
-template<typename T>
-T scalar_product (const Vector<T> &lhs, const Vector<T> &rhs)
+template<typename T, typename C>
+T scalar_product (const Vector<T, C> &lhs, const Vector<T, C> &rhs)
 {
     auto xx = lhs.x_ * rhs.x_;
     auto yy = lhs.y_ * rhs.y_;
     auto zz = lhs.z_ * rhs.z_;
 
-    auto tmp_product = cmp::are_equal (xx, -yy) ? T{} : xx + yy;
-    auto product     = cmp::are_equal (tmp_product, -zz) ? T{} : tmp_product + zz;
-
-    return product;
+    return C::sum (C::sum (xx, yy), zz);
 }
 
-template<typename T>
-Vector<T> vector_product (const Vector<T> &lhs, const Vector<T> &rhs)
+template<typename T, typename C>
+Vector<T, C> vector_product (const Vector<T, C> &lhs, const Vector<T, C> &rhs)
 {
     auto ly_rz     = lhs.y_ * rhs.z_;
     auto lz_ry     = lhs.z_ * rhs.y_;
-    auto product_1 = cmp::are_equal (ly_rz, lz_ry) ? T{} : ly_rz - lz_ry;
+    auto product_1 = C::difference (ly_rz, lz_ry);
 
     auto lz_rx     = lhs.z_ * rhs.x_;
     auto lx_rz     = lhs.x_ * rhs.z_;
-    auto product_2 = cmp::are_equal (lz_rx, lx_rz) ? T{} : lz_rx - lx_rz;
+    auto product_2 = C::difference (lz_rx, lx_rz);
 
     auto lx_ry     = lhs.x_ * rhs.y_;
     auto ly_rx     = lhs.y_ * rhs.x_;
-    auto product_3 = cmp::are_equal (lx_ry, ly_rx) ? T{} : lx_ry - ly_rx;
+    auto product_3 = C::difference (lx_ry, ly_rx);
 
-    return Vector<T>{product_1, product_2, product_3};
+    return Vector<T, C>{product_1, product_2, product_3};
 }
 
-template<typename T>
-T triple_product (const Vector<T> &first, const Vector<T> &second, const Vector<T> &third)
+template<typename T, typename C>
+T triple_product (const Vector<T, C> &first, const Vector<T, C> &second,
+                  const Vector<T, C> &third)
 {
     return scalar_product (first, vector_product (second, third));
 }
 
 // Mutual orientation
 
-template<typename T>
-bool are_collinear (const Vector<T> &first, const Vector<T> &second)
+template<typename T, typename C>
+bool are_collinear (const Vector<T, C> &first, const Vector<T, C> &second)
 {
     return vector_product (first, second).is_zero ();
 }
 
-template<typename T>
-bool are_parallel (const Vector<T> &first, const Vector<T> &second)
+template<typename T, typename C>
+bool are_parallel (const Vector<T, C> &first, const Vector<T, C> &second)
 {
     auto sp = scalar_product (first, second);
-    return cmp::are_equal (sp, first.module() * second.module());
+    return C::are_equal (sp, first.module() * second.module());
 }
 
-template<typename T>
-bool are_antiparallel (const Vector<T> &first, const Vector<T> &second)
+template<typename T, typename C>
+bool are_antiparallel (const Vector<T, C> &first, const Vector<T, C> &second)
 {
     auto sp = scalar_product (first, second);
-    return cmp::are_equal (-sp, first.module() * second.module());
+    return C::are_equal (-sp, first.module() * second.module());
 }
 
-template<typename T>
-bool are_coplanar (const Vector<T> &first, const Vector<T> &second, const Vector<T> &third)
+template<typename T, typename C>
+bool are_coplanar (const Vector<T, C> &first, const Vector<T, C> &second,
+                   const Vector<T, C> &third)
 {
-    return cmp::is_zero (triple_product (first, second, third));
+    return C::is_zero (triple_product (first, second, third));
 }
 
-template<typename T>
-bool are_orthogonal (const Vector<T> &first, const Vector<T> &second)
+template<typename T, typename C>
+bool are_orthogonal (const Vector<T, C> &first, const Vector<T, C> &second)
 {
-    return cmp::is_zero (scalar_product (first, second));
+    return C::is_zero (scalar_product (first, second));
 }
 
 // Printing
 
-template<typename T>
-void dump (std::ostream &os, Vector<T> &vec)
+template<typename T, typename C>
+void dump (std::ostream &os, Vector<T, C> &vec)
 {
     os << "(" << vec.x_ << ", " << vec.y_ << ", " << vec.z_ << ")";
 }
 
-template<typename T>
-std::ostream &operator<< (std::ostream &os, Vector<T> &vec)
+template<typename T, typename C>
+std::ostream &operator<< (std::ostream &os, Vector<T, C> &vec)
 {
     dump (os, vec);
     return os;
@@ -0,0 +1,256 @@
+#ifndef INCLUDE_RESULT_SINK_HPP
+#define INCLUDE_RESULT_SINK_HPP
+
+#include <atomic>
+#include <vector>
+#include <set>
+#include <mutex>
+#include <bit>
+#include <charconv>
+#include <ostream>
+#include <iterator>
+#include <concepts>
+#include <cstdint>
+#include <cstddef>
+
+namespace yLab
+{
+
+/*
+ * A result sink collects indexes of intersecting shapes. insert () may be called concurrently;
+ * indexes () and dump () return/print the indexes in ascending order without duplicates.
+ * erase () is used when shapes of a dynamic scene stop intersecting.
+ */
+template<typename S>
+concept Result_Sink = requires (S &sink, const S &const_sink, std::size_t index, std::ostream &os)
+{
+    requires std::constructible_from<S, std::size_t>;
+
+    sink.insert (index);
+    sink.erase (index);
+    { const_sink.contains (index) } -> std::same_as<bool>;
+    { const_sink.indexes () } -> std::same_as<std::vector<std::size_t>>;
+    const_sink.dump (os);
+};
+
+namespace detail
+{
+
+// Prints indexes separated by spaces and followed by a new line
+template<std::input_iterator it>
+void dump_indexes (std::ostream &os, it first, it last)
+{
+    constexpr std::size_t chunk_size = 1 << 16;
+    constexpr std::size_t max_index_length = 21; // 20 digits of 2^64 and a space
+
+    std::vector<char> chunk (chunk_size);
+    auto end = chunk.data();
+
+    for (; first != last; ++first)
+    {
+        // Leaves room for the final '\n' too
+        if (end + max_index_length + 1 > chunk.data() + chunk_size)
+        {
+            os.write (chunk.data(), end - chunk.data());
+            end = chunk.data();
+        }
+
+        end = std::to_chars (end, chunk.data() + chunk_size, *first).ptr;
+        *end++ = ' ';
+    }
+
+    *end++ = '\n';
+    os.write (chunk.data(), end - chunk.data());
+    os.flush();
+}
+
+} // namespace detail
+
+// Dense set of indexes in [0; n_indexes). Insertion is a single atomic or
+class Bitset_Sink final
+{
+public:
+
+    using size_type = std::size_t;
+    using word_type = std::uint64_t;
+
+private:
+
+    static constexpr size_type word_bits_ = 64;
+
+    std::vector<std::atomic<word_type>> words_;
+
+public:
+
+    explicit Bitset_Sink (size_type n_indexes)
+                         : words_((n_indexes + word_bits_ - 1) / word_bits_) {}
+
+    void insert (size_type index)
+    {
+        auto &word = words_[index / word_bits_];
+        auto bit = word_type{1} << (index % word_bits_);
+
+        // Most indexes are reported many times: plain load is much cheaper than atomic or
+        if (!(word.load (std::memory_order_relaxed) & bit))
+            word.fetch_or (bit, std::memory_order_relaxed);
+    }
+
+    template<std::input_iterator it>
+    void insert (it first, it last)
+    {
+        for (; first != last; ++first)
+            insert (*first);
+    }
+
+    void erase (size_type index)
+    {
+        auto bit = word_type{1} << (index % word_bits_);
+        words_[index / word_bits_].fetch_and (~bit, std::memory_order_relaxed);
+    }
+
+    bool contains (size_type index) const
+    {
+        auto bit = word_type{1} << (index % word_bits_);
+        return words_[index / word_bits_].load (std::memory_order_relaxed) & bit;
+    }
+
+    size_type size () const
+    {
+        size_type count = 0;
+        for (auto &word : words_)
+            count += std::popcount (word.load (std::memory_order_relaxed));
+
+        return count;
+    }
+
+    template<typename F>
+    void for_each (F f) const
+    {
+        for (size_type word_i = 0; word_i != words_.size(); ++word_i)
+        {
+            auto word = words_[word_i].load (std::memory_order_relaxed);
+
+            for (; word; word &= word - 1)
+                f (word_i * word_bits_ + std::countr_zero (word));
+        }
+    }
+
+    std::vector<size_type> indexes () const
+    {
+        std::vector<size_type> result;
+        result.reserve (size());
+        for_each ([&result](size_type index){ result.push_back (index); });
+
+        return result;
+    }
+
+    void dump (std::ostream &os) const
+    {
+        auto result = indexes();
+        detail::dump_indexes (os, result.begin(), result.end());
+    }
+};
+
+// Sparse set of indexes. Suitable for indexes that are not dense
+class Set_Sink final
+{
+public:
+
+    using size_type = std::size_t;
+
+private:
+
+    std::set<size_type> indexes_;
+    mutable std::mutex mutex_;
+
+public:
+
+    explicit Set_Sink (size_type) {}
+
+    void insert (size_type index)
+    {
+        std::lock_guard lock{mutex_};
+        indexes_.insert (index);
+    }
+
+    template<std::input_iterator it>
+    void insert (it first, it last)
+    {
+        std::lock_guard lock{mutex_};
+        indexes_.insert (first, last);
+    }
+
+    void erase (size_type index)
+    {
+        std::lock_guard lock{mutex_};
+        indexes_.erase (index);
+    }
+
+    bool contains (size_type index) const
+    {
+        std::lock_guard lock{mutex_};
+        return indexes_.contains (index);
+    }
+
+    size_type size () const
+    {
+        std::lock_guard lock{mutex_};
+        return indexes_.size();
+    }
+
+    std::vector<size_type> indexes () const
+    {
+        std::lock_guard lock{mutex_};
+        return std::vector<size_type>(indexes_.begin(), indexes_.end());
+    }
+
+    void dump (std::ostream &os) const
+    {
+        std::lock_guard lock{mutex_};
+        detail::dump_indexes (os, indexes_.begin(), indexes_.end());
+    }
+};
+
+// Thread-local buffer that passes indexes to the shared sink in batches
+template<Result_Sink S>
+class Sink_Buffer final
+{
+public:
+
+    using sink_type = S;
+    using size_type = std::size_t;
+
+private:
+
+    static constexpr size_type capacity_ = 1024;
+
+    sink_type &sink_;
+    std::vector<size_type> buffer_;
+
+public:
+
+    explicit Sink_Buffer (sink_type &sink) : sink_{sink} { buffer_.reserve (capacity_); }
+
+    Sink_Buffer (const Sink_Buffer &) = delete;
+    Sink_Buffer &operator= (const Sink_Buffer &) = delete;
+
+    ~Sink_Buffer () { flush(); }
+
+    void insert (size_type index)
+    {
+        if (buffer_.size() == capacity_)
+            flush();
+
+        buffer_.push_back (index);
+    }
+
+    void flush ()
+    {
+        sink_.insert (buffer_.begin(), buffer_.end());
+        buffer_.clear();
+    }
+};
+
+} // namespace yLab
+
+#endif // INCLUDE_RESULT_SINK_HPP
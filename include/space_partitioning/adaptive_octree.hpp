@@ -0,0 +1,413 @@
+#ifndef INCLUDE_SPACE_PARTITIONING_ADAPTIVE_OCTREE_HPP
+#define INCLUDE_SPACE_PARTITIONING_ADAPTIVE_OCTREE_HPP
+
+#include <vector>
+#include <array>
+#include <unordered_map>
+#include <iterator>
+#include <algorithm>
+#include <numeric>
+#include <limits>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+
+#include "double_comparison.hpp"
+#include "shape.hpp"
+#include "shape_store.hpp"
+
+namespace yLab
+{
+
+namespace geometry
+{
+
+/*
+ * Octree that only splits nodes holding more than max_shapes_per_node shapes. Nodes are
+ * identified by location codes: the code of the root is 1, the code of child i of a node
+ * is (code << 3 | i). Nodes live in one array and are found by their codes with a hash table,
+ * so only occupied parts of the space take memory and the tree may be up to max_height ()
+ * levels deep. As in Octree, a shape crossing a central plane of a node stays in this node
+ * and shapes are kept in a Shape_Store that nodes refer to by slots.
+ */
+template<typename T, typename U = Indexed_Shape<T>>
+class Adaptive_Octree final
+{
+public:
+
+    using distance_type = T;
+    using shape_type = U;
+    using size_type = std::size_t;
+    using index_type = std::uint32_t;
+    using code_type = std::uint64_t;
+    using store_type = Shape_Store<distance_type, shape_type>;
+    using slot_type = typename store_type::slot_type;
+
+    struct Node final
+    {
+        code_type code;
+        std::uint8_t children = 0; // bit i is set if child i exists
+        bool is_split = false;
+        std::vector<slot_type> shapes;
+
+        explicit Node (code_type node_code) : code{node_code} {}
+
+        size_type depth () const noexcept { return (std::bit_width (code) - 1) / 3; }
+    };
+
+    // A part of the tree that may be processed independently of the others. If descend is false,
+    // only shapes of the last node of the path are tested against their ancestors
+    struct Task final
+    {
+        std::vector<index_type> path; // from the root to the subroot inclusive
+        bool descend;
+    };
+
+    using node_type = Node;
+    using task_type = Task;
+
+    static constexpr size_type default_max_shapes_per_node () noexcept { return 8; }
+    static constexpr size_type max_height () noexcept { return 21; } // 1 + 3 * 21 bits of code
+
+private:
+
+    // Space of a node; it's carried down descents instead of being decoded from the code
+    struct Cube final
+    {
+        std::array<distance_type, 3> center;
+        distance_type halfwidth;
+
+        Cube child (unsigned octant) const
+        {
+            Cube cube{center, halfwidth / 2};
+            for (auto i = 0; i != 3; ++i)
+                cube.center[i] += (octant & (1u << i)) ? cube.halfwidth : -cube.halfwidth;
+
+            return cube;
+        }
+    };
+
+    std::vector<node_type> nodes_;
+    std::unordered_map<code_type, index_type> node_indexes_;
+    store_type store_;
+
+    std::array<distance_type, 3> center_;
+    distance_type halfwidth_;
+    size_type max_shapes_per_node_;
+    size_type height_ = 1;
+
+public:
+
+    template<std::forward_iterator it>
+    Adaptive_Octree (it first, it last,
+                     size_type max_shapes_per_node = default_max_shapes_per_node())
+                    : max_shapes_per_node_{std::max (max_shapes_per_node, size_type{1})}
+    {
+        calculate_octree_parameters (first, last);
+
+        nodes_.push_back (node_type{1});
+        node_indexes_.emplace (1, 0);
+
+        for (; first != last; ++first)
+            insert (*first);
+
+        group_shapes_by_nodes ();
+    }
+
+    size_type size () const noexcept { return nodes_.size(); }
+    size_type height () const noexcept { return height_; }
+    size_type max_shapes_per_node () const noexcept { return max_shapes_per_node_; }
+
+    const node_type &root () const { return nodes_.front(); }
+
+    // Index of the node with given location code or size () if there is no such node
+    size_type find (code_type code) const
+    {
+        auto it = node_indexes_.find (code);
+        return (it == node_indexes_.end()) ? size() : it->second;
+    }
+
+    const node_type &node (size_type node_i) const { return nodes_[node_i]; }
+
+    // Shapes of the tree; nodes refer to them by slots
+    const store_type &store () const { return store_; }
+
+    // The number of shapes stored in nodes of every depth; the root has depth 0
+    std::vector<size_type> depth_histogram () const
+    {
+        std::vector<size_type> histogram (height_);
+        for (auto &node : nodes_)
+            histogram[node.depth()] += node.shapes.size();
+
+        return histogram;
+    }
+
+    // Modifiers
+
+    void insert (const shape_type &shape)
+    {
+        auto slot = store_.insert (shape);
+        index_type node_i = 0;
+        Cube cube{center_, halfwidth_};
+
+        while (nodes_[node_i].is_split)
+        {
+            auto octant = find_octant (cube, slot);
+            if (octant == no_octant_)
+                break;
+
+            node_i = child (node_i, octant);
+            cube = cube.child (octant);
+        }
+
+        nodes_[node_i].shapes.push_back (slot);
+        try_split (node_i, cube);
+    }
+
+    // Broad phase
+
+    // Breadth-first descent until there are enough subtrees to keep all threads busy.
+    // Every node above the final frontier becomes a task of its own
+    std::vector<task_type> split (size_type min_n_tasks) const
+    {
+        std::vector<task_type> frontier;
+        std::vector<task_type> tasks;
+
+        frontier.push_back (task_type{{0}, true});
+
+        while (frontier.size() < min_n_tasks)
+        {
+            std::vector<task_type> next_frontier;
+
+            for (auto &task : frontier)
+            {
+                for_each_child (task.path.back(), [&](index_type child_i)
+                {
+                    auto path = task.path;
+                    path.push_back (child_i);
+                    next_frontier.push_back (task_type{std::move (path), true});
+                });
+            }
+
+            if (next_frontier.empty())
+                break;
+
+            for (auto &task : frontier)
+            {
+                task.descend = false;
+                tasks.push_back (std::move (task));
+            }
+
+            frontier = std::move (next_frontier);
+        }
+
+        // Deeper nodes go first (see for_each_candidate ())
+        std::move (tasks.rbegin(), tasks.rend(), std::back_inserter (frontier));
+
+        return frontier;
+    }
+
+    // The same order of traversal as in Octree: nodes in post-order, ancestors from the nearest one
+    template<typename F>
+    void for_each_candidate (F &visit) const
+    {
+        std::vector<index_type> ancestor_stack;
+        ancestor_stack.reserve (height());
+        ancestor_stack.push_back (0);
+
+        for_each_candidate_in_subtree (ancestor_stack, visit);
+    }
+
+    template<typename F>
+    void for_each_candidate (const task_type &task, F &visit) const
+    {
+        if (task.descend)
+        {
+            auto ancestor_stack = task.path;
+            for_each_candidate_in_subtree (ancestor_stack, visit);
+        }
+        else
+            for_each_candidate_in_node (task.path, visit);
+    }
+
+private:
+
+    static constexpr unsigned no_octant_ = 8;
+
+    template<typename F>
+    void for_each_child (index_type node_i, F f) const
+    {
+        auto &node = nodes_[node_i];
+
+        for (auto i = 0u; i != 8; ++i)
+            if (node.children & (1u << i))
+                f (node_indexes_.find ((node.code << 3) | i)->second);
+    }
+
+    template<typename F>
+    void for_each_candidate_in_node (const std::vector<index_type> &path, F &visit) const
+    {
+        auto &node = nodes_[path.back()];
+
+        for (auto ancestor_it = path.rbegin(); ancestor_it != path.rend(); ++ancestor_it)
+        {
+            for (auto slot_1 : nodes_[*ancestor_it].shapes)
+            {
+                for (auto slot_2 : node.shapes)
+                {
+                    if (slot_1 == slot_2)
+                        break;
+
+                    if (store_.are_overlapping (slot_1, slot_2))
+                        visit (store_[slot_1], store_[slot_2]);
+                }
+            }
+        }
+    }
+
+    template<typename F>
+    void for_each_candidate_in_subtree (std::vector<index_type> &ancestor_stack, F &visit) const
+    {
+        for_each_child (ancestor_stack.back(), [&](index_type child_i)
+        {
+            ancestor_stack.push_back (child_i);
+            for_each_candidate_in_subtree (ancestor_stack, visit);
+            ancestor_stack.pop_back();
+        });
+
+        for_each_candidate_in_node (ancestor_stack, visit);
+    }
+
+    // Shapes of every node get consecutive slots (see Octree)
+    void group_shapes_by_nodes ()
+    {
+        std::vector<slot_type> order;
+        order.reserve (store_.size());
+
+        for (auto &node : nodes_)
+        {
+            for (auto &slot : node.shapes)
+            {
+                auto new_slot = static_cast<slot_type>(order.size());
+                order.push_back (slot);
+                slot = new_slot;
+            }
+        }
+
+        store_.reorder (order);
+    }
+
+    template<std::forward_iterator it>
+    void calculate_octree_parameters (it first, it last)
+    {
+        constexpr auto inf = std::numeric_limits<distance_type>::infinity();
+
+        std::array<distance_type, 3> min{inf, inf, inf};
+        std::array<distance_type, 3> max{-inf, -inf, -inf};
+
+        for (; first != last; ++first)
+        {
+            for (auto i = 0; i != 3; ++i)
+            {
+                min[i] = std::min (min[i], first->left_bound (i));
+                max[i] = std::max (max[i], first->right_bound (i));
+            }
+        }
+
+        if (min[0] > max[0])
+        {
+            center_ = {};
+            halfwidth_ = 1;
+            return;
+        }
+
+        halfwidth_ = distance_type{};
+        for (auto i = 0; i != 3; ++i)
+        {
+            center_[i] = std::midpoint (min[i], max[i]);
+            halfwidth_ = std::max (halfwidth_, (max[i] - min[i]) / 2);
+        }
+    }
+
+    // The octant of the node the shape lies in entirely or no_octant_
+    // if the shape crosses one of the central planes
+    unsigned find_octant (const Cube &cube, slot_type slot) const
+    {
+        auto shape = store_[slot];
+        auto &center = cube.center;
+        const auto &bounding_volume = shape.bounding_volume();
+        auto octant = 0u;
+
+        for (auto i = 0; i != 3; ++i)
+        {
+            auto delta = bounding_volume.center()[i] - center[i];
+
+            if (cmp::less (std::abs (delta), bounding_volume.halfwidth (i)))
+                return no_octant_;
+
+            if (cmp::greater (delta, distance_type{}))
+                octant |= (1u << i);
+        }
+
+        return octant;
+    }
+
+    // Returns the index of the child allocating it if necessary
+    index_type child (index_type node_i, unsigned octant)
+    {
+        auto code = (nodes_[node_i].code << 3) | octant;
+
+        if (nodes_[node_i].children & (1u << octant))
+            return node_indexes_.find (code)->second;
+
+        auto child_i = static_cast<index_type>(nodes_.size());
+
+        nodes_[node_i].children |= (1u << octant);
+        nodes_.push_back (node_type{code});
+        node_indexes_.emplace (code, child_i);
+        height_ = std::max (height_, nodes_.back().depth() + 1);
+
+        return child_i;
+    }
+
+    // Shapes that don't cross central planes are moved to the children
+    void try_split (index_type node_i, const Cube &cube)
+    {
+        auto &node = nodes_[node_i];
+
+        if (node.is_split || node.shapes.size() <= max_shapes_per_node_ ||
+            node.depth() + 1 >= max_height())
+            return;
+
+        node.is_split = true;
+
+        auto slots = std::move (node.shapes);
+        nodes_[node_i].shapes.clear();
+
+        auto touched = 0u; // bit i is set if child i has got shapes
+
+        for (auto slot : slots)
+        {
+            auto octant = find_octant (cube, slot);
+
+            if (octant == no_octant_)
+                nodes_[node_i].shapes.push_back (slot);
+            else
+            {
+                nodes_[child (node_i, octant)].shapes.push_back (slot);
+                touched |= (1u << octant);
+            }
+        }
+
+        for (auto octant = 0u; octant != 8; ++octant)
+            if (touched & (1u << octant))
+                try_split (child (node_i, octant), cube.child (octant));
+    }
+};
+
+} // namespace geometry
+
+} // namespace yLab
+
+#endif // INCLUDE_SPACE_PARTITIONING_ADAPTIVE_OCTREE_HPP
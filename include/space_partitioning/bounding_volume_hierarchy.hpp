@@ -0,0 +1,451 @@
+#ifndef INCLUDE_SPACE_PARTITIONING_BOUNDING_VOLUME_HIERARCHY_HPP
+#define INCLUDE_SPACE_PARTITIONING_BOUNDING_VOLUME_HIERARCHY_HPP
+
+#include <vector>
+#include <array>
+#include <iterator>
+#include <algorithm>
+#include <numeric>
+#include <limits>
+#include <cstdint>
+#include <cstddef>
+
+#include "double_comparison.hpp"
+#include "shape.hpp"
+
+namespace yLab
+{
+
+namespace geometry
+{
+
+/*
+ * Bounding volume hierarchy built with binned surface area heuristic. Nodes are stored
+ * in depth-first order in one array: the left child of an interior node immediately follows
+ * it, the index of the right child is stored in the node. Leaves refer to contiguous ranges
+ * of shapes which are reordered accordingly.
+ */
+template<typename T, typename U = Indexed_Shape<T>>
+class BVH final
+{
+public:
+
+    using distance_type = T;
+    using shape_type = U;
+    using size_type = std::size_t;
+    using index_type = std::uint32_t;
+
+    struct Box final
+    {
+        std::array<distance_type, 3> min;
+        std::array<distance_type, 3> max;
+    };
+
+    struct Node final
+    {
+        Box box;
+        index_type offset; // first shape of a leaf or right child of an interior node
+        index_type count;  // 0 for interior nodes
+
+        bool is_leaf () const noexcept { return count != 0; }
+    };
+
+    // Pairs of shapes from nodes first and second are visited; if first == second,
+    // pairs of shapes from the subtree of this node are visited
+    struct Task final
+    {
+        index_type first;
+        index_type second;
+    };
+
+    using node_type = Node;
+    using task_type = Task;
+
+private:
+
+    static constexpr size_type n_bins_ = 16;
+    static constexpr size_type max_leaf_size_ = 4;
+    static constexpr distance_type traversal_cost_ = 1;
+
+    std::vector<shape_type> shapes_;
+    std::vector<Box> boxes_;
+    std::vector<node_type> nodes_;
+    size_type height_ = 0;
+
+public:
+
+    template<std::forward_iterator it>
+    BVH (it first, it last)
+    {
+        std::vector<shape_type> shapes (first, last);
+        auto n_shapes = static_cast<size_type>(shapes.size());
+
+        std::vector<Box> boxes;
+        std::vector<std::array<distance_type, 3>> centroids;
+        boxes.reserve (n_shapes);
+        centroids.reserve (n_shapes);
+
+        for (auto &shape : shapes)
+        {
+            auto &box = boxes.emplace_back (Box{{shape.left_bound (0), shape.left_bound (1),
+                                                 shape.left_bound (2)},
+                                                {shape.right_bound (0), shape.right_bound (1),
+                                                 shape.right_bound (2)}});
+
+            centroids.push_back ({(box.min[0] + box.max[0]) / 2, (box.min[1] + box.max[1]) / 2,
+                                  (box.min[2] + box.max[2]) / 2});
+        }
+
+        std::vector<index_type> order (n_shapes);
+        std::iota (order.begin(), order.end(), index_type{0});
+
+        if (n_shapes)
+        {
+            nodes_.reserve (2 * n_shapes);
+            build (order, boxes, centroids, 0, n_shapes, 1);
+        }
+
+        shapes_.reserve (n_shapes);
+        boxes_.reserve (n_shapes);
+
+        for (auto i : order)
+        {
+            shapes_.push_back (shapes[i]);
+            boxes_.push_back (boxes[i]);
+        }
+    }
+
+    size_type size () const noexcept { return shapes_.size(); }
+    size_type height () const noexcept { return height_; }
+
+    const std::vector<node_type> &nodes () const { return nodes_; }
+
+    // Broad phase
+
+    // Self-traversal tasks are split into the traversals of both children and
+    // the traversal of the pair of children; pairs of nodes are split into pairs of children
+    std::vector<task_type> split (size_type min_n_tasks) const
+    {
+        std::vector<task_type> tasks;
+        if (nodes_.empty())
+            return tasks;
+
+        tasks.push_back (task_type{0, 0});
+
+        for (auto expanded = true; expanded && tasks.size() < min_n_tasks;)
+        {
+            std::vector<task_type> next_tasks;
+            expanded = false;
+
+            for (auto &task : tasks)
+            {
+                auto &first = nodes_[task.first];
+                auto &second = nodes_[task.second];
+
+                if (task.first == task.second && !first.is_leaf())
+                {
+                    auto left = task.first + 1;
+                    auto right = first.offset;
+
+                    next_tasks.push_back (task_type{left, left});
+                    next_tasks.push_back (task_type{right, right});
+                    next_tasks.push_back (task_type{left, right});
+                    expanded = true;
+                }
+                else if (task.first != task.second && !first.is_leaf() && !second.is_leaf())
+                {
+                    for (auto child_1 : {task.first + 1, first.offset})
+                        for (auto child_2 : {task.second + 1, second.offset})
+                            next_tasks.push_back (task_type{child_1, child_2});
+                    expanded = true;
+                }
+                else
+                    next_tasks.push_back (task);
+            }
+
+            tasks = std::move (next_tasks);
+        }
+
+        return tasks;
+    }
+
+    template<typename F>
+    void for_each_candidate (F &visit) const
+    {
+        if (!nodes_.empty())
+            for_each_candidate (task_type{0, 0}, visit);
+    }
+
+    template<typename F>
+    void for_each_candidate (const task_type &task, F &visit) const
+    {
+        std::vector<task_type> stack;
+        stack.reserve (2 * height_ + 2);
+        stack.push_back (task);
+
+        while (!stack.empty())
+        {
+            auto [first_i, second_i] = stack.back();
+            stack.pop_back();
+
+            auto &first = nodes_[first_i];
+            auto &second = nodes_[second_i];
+
+            if (first_i == second_i)
+            {
+                if (first.is_leaf())
+                    visit_leaf (first, visit);
+                else
+                {
+                    auto left = first_i + 1;
+                    auto right = first.offset;
+
+                    stack.push_back (task_type{left, right});
+                    stack.push_back (task_type{right, right});
+                    stack.push_back (task_type{left, left});
+                }
+            }
+            else if (are_overlapping (first.box, second.box))
+            {
+                if (first.is_leaf() && second.is_leaf())
+                    visit_leaves (first, second, visit);
+                else if (second.is_leaf() ||
+                         (!first.is_leaf() && area (first.box) > area (second.box)))
+                {
+                    stack.push_back (task_type{first_i + 1, second_i});
+                    stack.push_back (task_type{first.offset, second_i});
+                }
+                else
+                {
+                    stack.push_back (task_type{first_i, second_i + 1});
+                    stack.push_back (task_type{first_i, second.offset});
+                }
+            }
+        }
+    }
+
+    // Calls visit (shape, other_shape) for every pair of shapes with overlapping bounding boxes
+    // one of which is from this hierarchy and the other one is from other. Both hierarchies
+    // are descended simultaneously as in for_each_candidate ()
+    template<typename V, typename F>
+    void for_each_cross_candidate (const BVH<distance_type, V> &other, F &visit) const
+    {
+        if (nodes_.empty() || other.nodes_.empty())
+            return;
+
+        std::vector<task_type> stack;
+        stack.reserve (2 * (height_ + other.height_));
+        stack.push_back (task_type{0, 0});
+
+        while (!stack.empty())
+        {
+            auto [first_i, second_i] = stack.back();
+            stack.pop_back();
+
+            auto &first = nodes_[first_i];
+            auto &second = other.nodes_[second_i];
+
+            if (!are_overlapping (first.box, second.box))
+                continue;
+
+            if (first.is_leaf() && second.is_leaf())
+            {
+                for (auto i = first.offset; i != first.offset + first.count; ++i)
+                    for (auto j = second.offset; j != second.offset + second.count; ++j)
+                        if (are_overlapping (boxes_[i], other.boxes_[j]))
+                            visit (shapes_[i], other.shapes_[j]);
+            }
+            else if (second.is_leaf() || (!first.is_leaf() && area (first.box) > area (second.box)))
+            {
+                stack.push_back (task_type{first_i + 1, second_i});
+                stack.push_back (task_type{first.offset, second_i});
+            }
+            else
+            {
+                stack.push_back (task_type{first_i, second_i + 1});
+                stack.push_back (task_type{first_i, second.offset});
+            }
+        }
+    }
+
+private:
+
+    template<typename, typename> friend class BVH;
+
+    static bool are_overlapping (const Box &first, const Box &second)
+    {
+        for (auto i = 0; i != 3; ++i)
+        {
+            if (!cmp::less_equal (first.min[i], second.max[i]) ||
+                !cmp::less_equal (second.min[i], first.max[i]))
+                return false;
+        }
+
+        return true;
+    }
+
+    static distance_type area (const Box &box)
+    {
+        auto dx = box.max[0] - box.min[0];
+        auto dy = box.max[1] - box.min[1];
+        auto dz = box.max[2] - box.min[2];
+
+        return 2 * (dx * dy + dy * dz + dz * dx);
+    }
+
+    static Box empty_box ()
+    {
+        constexpr auto inf = std::numeric_limits<distance_type>::infinity();
+        return Box{{inf, inf, inf}, {-inf, -inf, -inf}};
+    }
+
+    static void expand (Box &box, const Box &other)
+    {
+        for (auto i = 0; i != 3; ++i)
+        {
+            box.min[i] = std::min (box.min[i], other.min[i]);
+            box.max[i] = std::max (box.max[i], other.max[i]);
+        }
+    }
+
+    template<typename F>
+    void visit_leaf (const node_type &leaf, F &visit) const
+    {
+        for (auto i = leaf.offset; i != leaf.offset + leaf.count; ++i)
+            for (auto j = i + 1; j != leaf.offset + leaf.count; ++j)
+                if (are_overlapping (boxes_[i], boxes_[j]))
+                    visit (shapes_[i], shapes_[j]);
+    }
+
+    template<typename F>
+    void visit_leaves (const node_type &first, const node_type &second, F &visit) const
+    {
+        for (auto i = first.offset; i != first.offset + first.count; ++i)
+            for (auto j = second.offset; j != second.offset + second.count; ++j)
+                if (are_overlapping (boxes_[i], boxes_[j]))
+                    visit (shapes_[i], shapes_[j]);
+    }
+
+    struct Bin final
+    {
+        Box box = empty_box();
+        size_type count = 0;
+    };
+
+    // Builds the subtree over order[first; last) and returns the index of its root
+    index_type build (std::vector<index_type> &order, const std::vector<Box> &boxes,
+                      const std::vector<std::array<distance_type, 3>> &centroids,
+                      size_type first, size_type last, size_type depth)
+    {
+        height_ = std::max (height_, depth);
+
+        auto node_i = static_cast<index_type>(nodes_.size());
+        nodes_.push_back (node_type{empty_box(), static_cast<index_type>(first),
+                                    static_cast<index_type>(last - first)});
+
+        auto centroid_box = empty_box();
+        for (auto i = first; i != last; ++i)
+        {
+            expand (nodes_[node_i].box, boxes[order[i]]);
+            expand (centroid_box, Box{centroids[order[i]], centroids[order[i]]});
+        }
+
+        auto count = last - first;
+        if (count <= 1)
+            return node_i;
+
+        // Binned SAH: the best of (n_bins_ - 1) candidate planes along every axis
+        auto best_cost = std::numeric_limits<distance_type>::infinity();
+        auto best_axis = 0;
+        size_type best_split = 0;
+
+        for (auto axis = 0; axis != 3; ++axis)
+        {
+            auto extent = centroid_box.max[axis] - centroid_box.min[axis];
+            if (!(extent > distance_type{}))
+                continue;
+
+            std::array<Bin, n_bins_> bins;
+            for (auto i = first; i != last; ++i)
+            {
+                auto bin_i = bin_index (centroids[order[i]][axis], centroid_box.min[axis], extent);
+                auto &bin = bins[bin_i];
+                ++bin.count;
+                expand (bin.box, boxes[order[i]]);
+            }
+
+            std::array<distance_type, n_bins_> right_cost{};
+            auto right_box = empty_box();
+            size_type right_count = 0;
+
+            for (auto bin_i = n_bins_ - 1; bin_i != 0; --bin_i)
+            {
+                expand (right_box, bins[bin_i].box);
+                right_count += bins[bin_i].count;
+                right_cost[bin_i] = right_count ? area (right_box) * right_count : distance_type{};
+            }
+
+            auto left_box = empty_box();
+            size_type left_count = 0;
+
+            for (size_type bin_i = 0; bin_i != n_bins_ - 1; ++bin_i)
+            {
+                expand (left_box, bins[bin_i].box);
+                left_count += bins[bin_i].count;
+
+                if (left_count == 0 || left_count == count)
+                    continue;
+
+                auto cost = area (left_box) * left_count + right_cost[bin_i + 1];
+                if (cost < best_cost)
+                {
+                    best_cost = cost;
+                    best_axis = axis;
+                    best_split = bin_i + 1;
+                }
+            }
+        }
+
+        auto parent_area = area (nodes_[node_i].box);
+        auto leaf_cost = static_cast<distance_type>(count);
+        auto split_cost = traversal_cost_ + (parent_area > distance_type{} ? best_cost / parent_area
+                                                                             : best_cost);
+
+        size_type middle;
+
+        if (best_split != 0 && (split_cost < leaf_cost || count > max_leaf_size_))
+        {
+            auto extent = centroid_box.max[best_axis] - centroid_box.min[best_axis];
+            auto middle_it = std::partition (order.begin() + first, order.begin() + last,
+                                             [&](index_type i)
+            {
+                return bin_index (centroids[i][best_axis], centroid_box.min[best_axis], extent) <
+                       best_split;
+            });
+
+            middle = std::distance (order.begin(), middle_it);
+        }
+        else if (count > max_leaf_size_) // all centroids coincide: split by count
+            middle = first + count / 2;
+        else
+            return node_i;
+
+        nodes_[node_i].count = 0;
+        build (order, boxes, centroids, first, middle, depth + 1);
+        nodes_[node_i].offset = build (order, boxes, centroids, middle, last, depth + 1);
+
+        return node_i;
+    }
+
+    static size_type bin_index (distance_type centroid, distance_type min, distance_type extent)
+    {
+        auto bin = static_cast<size_type>(n_bins_ * ((centroid - min) / extent));
+        return std::min (bin, n_bins_ - 1);
+    }
+};
+
+} // namespace geometry
+
+} // namespace yLab
+
+#endif // INCLUDE_SPACE_PARTITIONING_BOUNDING_VOLUME_HIERARCHY_HPP
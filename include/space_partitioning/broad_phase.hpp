@@ -0,0 +1,90 @@
+#ifndef INCLUDE_SPACE_PARTITIONING_BROAD_PHASE_HPP
+#define INCLUDE_SPACE_PARTITIONING_BROAD_PHASE_HPP
+
+#include <vector>
+#include <concepts>
+#include <cstddef>
+
+namespace yLab
+{
+
+namespace geometry
+{
+
+namespace detail
+{
+
+template<typename S>
+struct Candidate_Visitor final
+{
+    void operator() (const S &, const S &) {}
+};
+
+template<typename S>
+struct Neighbour_Visitor final
+{
+    void operator() (const S &) {}
+};
+
+template<typename S, typename R>
+struct Cross_Visitor final
+{
+    void operator() (const S &, const R &) {}
+};
+
+} // namespace detail
+
+/*
+ * A broad phase engine finds pairs of shapes that may intersect (candidates). Every pair of
+ * intersecting shapes has to be visited at least once. The work may be split into tasks
+ * that are processed independently (possibly by different threads); every candidate
+ * has to be visited by exactly one task. Shapes passed to visitors are only valid during
+ * the call: an engine may build them from its own storage (see Shape_Store).
+ */
+template<typename B>
+concept Broad_Phase = requires (const B &engine, std::size_t min_n_tasks,
+                                const typename B::task_type &task,
+                                detail::Candidate_Visitor<typename B::shape_type> &visit)
+{
+    typename B::distance_type;
+    typename B::shape_type;
+
+    { engine.split (min_n_tasks) } -> std::same_as<std::vector<typename B::task_type>>;
+    engine.for_each_candidate (visit);
+    engine.for_each_candidate (task, visit);
+};
+
+/*
+ * A dynamic broad phase engine also allows shapes to be removed or moved without rebuilding
+ * and finds all shapes that may intersect the given one (neighbours).
+ */
+template<typename B>
+concept Dynamic_Broad_Phase = Broad_Phase<B> &&
+                              requires (B &engine, const B &const_engine,
+                                        const typename B::shape_type &shape,
+                                        detail::Neighbour_Visitor<typename B::shape_type> &visit)
+{
+    { engine.erase (shape) } -> std::same_as<bool>;
+    { engine.update (shape, shape) } -> std::same_as<bool>;
+    const_engine.for_each_neighbour (shape, visit);
+};
+
+/*
+ * A cross broad phase engine finds candidates between two engines built independently
+ * (e.g. from two models): every pair has the first shape from this engine and the second one
+ * from the other engine; pairs of shapes of the same engine aren't visited.
+ */
+template<typename B, typename C>
+concept Cross_Broad_Phase = Broad_Phase<B> && Broad_Phase<C> &&
+                            requires (const B &engine, const C &other,
+                                      detail::Cross_Visitor<typename B::shape_type,
+                                                            typename C::shape_type> &visit)
+{
+    engine.for_each_cross_candidate (other, visit);
+};
+
+} // namespace geometry
+
+} // namespace yLab
+
+#endif // INCLUDE_SPACE_PARTITIONING_BROAD_PHASE_HPP
@@ -0,0 +1,668 @@
+#ifndef INCLUDE_SPACE_PARTITIONING_LINEAR_OCTREE_HPP
+#define INCLUDE_SPACE_PARTITIONING_LINEAR_OCTREE_HPP
+
+#include <vector>
+#include <array>
+#include <iterator>
+#include <algorithm>
+#include <numeric>
+#include <limits>
+#include <bit>
+#include <cmath>
+#include <thread>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include <span>
+
+#include "double_comparison.hpp"
+#include "shape.hpp"
+#include "shape_record.hpp"
+
+namespace yLab
+{
+
+namespace geometry
+{
+
+// A node of Linear_Octree; trivially copyable, so that nodes may be saved as they are
+struct Linear_Octree_Node final
+{
+    using size_type = std::size_t;
+    using index_type = std::uint32_t;
+    using code_type = std::uint64_t;
+
+    code_type code;
+    index_type first_child;
+    index_type first_shape;
+    index_type n_shapes;
+    std::uint8_t children; // bit i is set if child i exists
+
+    size_type depth () const noexcept { return (std::bit_width (code) - 1) / 3; }
+
+    index_type child (unsigned octant) const
+    {
+        return first_child + std::popcount (children & ((1u << octant) - 1));
+    }
+};
+
+// If descend is false, only shapes of the node are tested against their ancestors
+struct Linear_Octree_Task final
+{
+    Linear_Octree_Node::index_type node;
+    bool descend;
+};
+
+namespace detail
+{
+
+// Traversal shared by Linear_Octree and Linear_Octree_View
+
+// Index of the node with given location code or nodes.size () if there is no such node
+inline std::size_t find_linear_node (std::span<const Linear_Octree_Node> nodes,
+                                     Linear_Octree_Node::code_type code)
+{
+    auto it = std::lower_bound (nodes.begin(), nodes.end(), code,
+                                [](const Linear_Octree_Node &node, auto code)
+    {
+        return node.code < code;
+    });
+
+    return (it != nodes.end() && it->code == code) ? std::distance (nodes.begin(), it)
+                                                     : nodes.size();
+}
+
+// Breadth-first descent until there are enough subtrees to keep all threads busy.
+// Every node above the final frontier becomes a task of its own
+inline std::vector<Linear_Octree_Task> split_linear_octree (
+    std::span<const Linear_Octree_Node> nodes, std::size_t min_n_tasks)
+{
+    using task_type = Linear_Octree_Task;
+
+    std::vector<task_type> frontier;
+    std::vector<task_type> tasks;
+
+    if (nodes.empty())
+        return tasks;
+
+    frontier.push_back (task_type{0, true});
+
+    while (frontier.size() < min_n_tasks)
+    {
+        std::vector<task_type> next_frontier;
+
+        for (auto &task : frontier)
+        {
+            auto &node = nodes[task.node];
+            for (auto i = 0; i != std::popcount (node.children); ++i)
+                next_frontier.push_back (task_type{node.first_child + i, true});
+        }
+
+        if (next_frontier.empty())
+            break;
+
+        for (auto &task : frontier)
+            tasks.push_back (task_type{task.node, false});
+
+        frontier = std::move (next_frontier);
+    }
+
+    std::move (tasks.rbegin(), tasks.rend(), std::back_inserter (frontier));
+
+    return frontier;
+}
+
+// Calls visit_node (path) for every node of the task; path holds indexes of the nodes from
+// the root to the node. Depth-first traversal with an explicit stack; the path is kept
+// in an array indexed by depth
+template<typename F>
+void for_each_linear_node (std::span<const Linear_Octree_Node> nodes, std::size_t height,
+                           const Linear_Octree_Task &task, F visit_node)
+{
+    using index_type = Linear_Octree_Node::index_type;
+
+    std::vector<index_type> path;
+    path.reserve (height);
+
+    for (auto code = nodes[task.node].code >> 3; code; code >>= 3)
+        path.push_back (static_cast<index_type>(find_linear_node (nodes, code)));
+    std::reverse (path.begin(), path.end());
+
+    if (!task.descend)
+    {
+        path.push_back (task.node);
+        visit_node (path);
+        return;
+    }
+
+    std::vector<index_type> stack{task.node};
+    stack.reserve (7 * height + 1);
+
+    while (!stack.empty())
+    {
+        auto node_i = stack.back();
+        stack.pop_back();
+
+        auto &node = nodes[node_i];
+        path.resize (node.depth());
+        path.push_back (node_i);
+
+        visit_node (path);
+
+        for (auto i = std::popcount (node.children); i != 0; --i)
+            stack.push_back (node.first_child + i - 1);
+    }
+}
+
+// Calls visit for every pair of shapes of the last node of the path and of the same node
+// or one of its ancestors if are_overlapping (i, j) holds for their positions i and j
+template<typename Shapes, typename P, typename F>
+void for_each_candidate_in_linear_node (std::span<const Linear_Octree_Node> nodes,
+                                        const std::vector<Linear_Octree_Node::index_type> &path,
+                                        const Shapes &shapes, P are_overlapping, F &visit)
+{
+    auto &node = nodes[path.back()];
+    auto first = node.first_shape;
+    auto last = first + node.n_shapes;
+
+    for (auto i = first; i != last; ++i)
+        for (auto j = first; j != i; ++j)
+            if (are_overlapping (j, i))
+                visit (shapes[j], shapes[i]);
+
+    for (auto ancestor_it = path.rbegin() + 1; ancestor_it != path.rend(); ++ancestor_it)
+    {
+        auto &ancestor = nodes[*ancestor_it];
+
+        for (auto i = ancestor.first_shape; i != ancestor.first_shape + ancestor.n_shapes; ++i)
+            for (auto j = first; j != last; ++j)
+                if (are_overlapping (i, j))
+                    visit (shapes[i], shapes[j]);
+    }
+}
+
+} // namespace detail
+
+/*
+ * Pointerless octree. Shapes are put into the nodes of the complete tree of the given height
+ * by the same rule as in Octree, but only occupied nodes and their ancestors are stored. A node
+ * is identified by its Morton location code: the code of the root is 1, the code of child i
+ * of a node is (code << 3 | i). Nodes are stored in one array sorted by their codes, i.e. level
+ * by level, so children of a node are contiguous. Shapes are stored in one array grouped
+ * by nodes: node i owns shapes [first_shape; first_shape + n_shapes).
+ */
+template<typename T, typename U = Indexed_Shape<T>>
+class Linear_Octree final
+{
+public:
+
+    using distance_type = T;
+    using shape_type = U;
+    using size_type = std::size_t;
+    using index_type = std::uint32_t;
+    using code_type = std::uint64_t;
+
+    using node_type = Linear_Octree_Node;
+    using task_type = Linear_Octree_Task;
+
+    static constexpr size_type max_height () noexcept { return 21; } // 1 + 3 * 21 bits of code
+
+private:
+
+    std::vector<node_type> nodes_;
+    std::vector<shape_type> shapes_;
+
+    // Bounds of shapes_ as minima and maxima along every axis (see Shape_Store)
+    std::array<std::vector<distance_type>, 3> min_;
+    std::array<std::vector<distance_type>, 3> max_;
+
+    std::array<distance_type, 3> center_;
+    distance_type halfwidth_;
+    size_type height_;
+
+public:
+
+    template<std::forward_iterator it>
+    Linear_Octree (it first, it last)
+                  : Linear_Octree{first, last, default_height (std::distance (first, last))} {}
+
+    template<std::forward_iterator it>
+    Linear_Octree (it first, it last, size_type height)
+                  : Linear_Octree{first, last, height, std::thread::hardware_concurrency()} {}
+
+    /*
+     * Bulk construction: location codes of shapes are computed in parallel and radix sorted
+     * (every thread histograms and scatters its own chunk), then nodes are emitted level by level.
+     * Every thread gets at least min_shapes_per_thread () shapes.
+     */
+    template<std::forward_iterator it>
+    Linear_Octree (it first, it last, size_type height, size_type n_threads)
+                  : height_{std::clamp (height, size_type{1}, max_height())}
+    {
+        // Shapes are read by index below, which is O(n) per access for forward iterators
+        std::vector<shape_type> shapes (first, last);
+
+        auto n_shapes = shapes.size();
+        n_threads = std::clamp (n_shapes / min_shapes_per_thread(), size_type{1},
+                                std::max (n_threads, size_type{1}));
+
+        calculate_octree_parameters (shapes, n_threads);
+
+        std::vector<code_type> codes (n_shapes);
+        std::vector<index_type> order (n_shapes);
+
+        for_each_chunk (n_threads, n_shapes, [&](size_type chunk_first, size_type chunk_last,
+                                                 size_type)
+        {
+            for (auto i = chunk_first; i != chunk_last; ++i)
+            {
+                codes[i] = location_code (shapes[i]);
+                order[i] = static_cast<index_type>(i);
+            }
+        });
+
+        radix_sort (codes, order, n_threads);
+
+        shapes_.reserve (n_shapes);
+        for (auto i : order)
+            shapes_.push_back (shapes[i]);
+
+        fill_bounds ();
+        build_nodes (codes);
+    }
+
+    static constexpr size_type min_shapes_per_thread () noexcept { return 1 << 14; }
+
+    // The height of the complete tree; about one cell of the deepest level per shape
+    static size_type default_height (size_type n_shapes)
+    {
+        return std::clamp (static_cast<size_type>(std::bit_width (n_shapes)) / 3 + 1,
+                           size_type{1}, max_height());
+    }
+
+    size_type size () const noexcept { return nodes_.size(); }
+    size_type height () const noexcept { return height_; }
+
+    const std::array<distance_type, 3> &center () const noexcept { return center_; }
+    distance_type halfwidth () const noexcept { return halfwidth_; }
+
+    const std::vector<node_type> &nodes () const { return nodes_; }
+    const std::vector<shape_type> &shapes () const { return shapes_; }
+
+    // Index of the node with given location code or size () if there is no such node
+    size_type find (code_type code) const { return detail::find_linear_node (nodes_, code); }
+
+    // The number of shapes stored in nodes of every depth; the root has depth 0
+    std::vector<size_type> depth_histogram () const
+    {
+        std::vector<size_type> histogram (height_);
+        for (auto &node : nodes_)
+            histogram[node.depth()] += node.n_shapes;
+
+        return histogram;
+    }
+
+    // Broad phase
+
+    // Breadth-first descent until there are enough subtrees to keep all threads busy.
+    // Every node above the final frontier becomes a task of its own
+    std::vector<task_type> split (size_type min_n_tasks) const
+    {
+        return detail::split_linear_octree (nodes_, min_n_tasks);
+    }
+
+    template<typename F>
+    void for_each_candidate (F &visit) const
+    {
+        if (!nodes_.empty())
+            for_each_candidate (task_type{0, true}, visit);
+    }
+
+    template<typename F>
+    void for_each_candidate (const task_type &task, F &visit) const
+    {
+        auto are_overlapping = [this](index_type i, index_type j)
+        {
+            return this->are_overlapping (i, j);
+        };
+
+        detail::for_each_linear_node (nodes_, height_, task, [&](const auto &path)
+        {
+            detail::for_each_candidate_in_linear_node (nodes_, path, shapes_, are_overlapping,
+                                                       visit);
+        });
+    }
+
+private:
+
+    // Conservative: boxes closer than the tolerance of cmp are considered overlapping
+    bool are_overlapping (index_type i, index_type j) const
+    {
+        for (auto axis = 0; axis != 3; ++axis)
+        {
+            if (cmp::greater (min_[axis][i], max_[axis][j]) ||
+                cmp::greater (min_[axis][j], max_[axis][i]))
+                return false;
+        }
+
+        return true;
+    }
+
+    void fill_bounds ()
+    {
+        for (auto axis = 0; axis != 3; ++axis)
+        {
+            min_[axis].resize (shapes_.size());
+            max_[axis].resize (shapes_.size());
+
+            for (size_type i = 0; i != shapes_.size(); ++i)
+            {
+                min_[axis][i] = shapes_[i].left_bound (axis);
+                max_[axis][i] = shapes_[i].right_bound (axis);
+            }
+        }
+    }
+
+    // Calls f (chunk_first, chunk_last, chunk_i) for n_chunks chunks of [0; n) on separate threads
+    template<typename F>
+    static void for_each_chunk (size_type n_chunks, size_type n, F f)
+    {
+        std::vector<std::thread> threads;
+        threads.reserve (n_chunks - 1);
+
+        for (size_type chunk_i = 1; chunk_i < n_chunks; ++chunk_i)
+            threads.emplace_back (f, n * chunk_i / n_chunks, n * (chunk_i + 1) / n_chunks, chunk_i);
+        f (0, n / n_chunks, 0);
+
+        for (auto &thread : threads)
+            thread.join();
+    }
+
+    void calculate_octree_parameters (const std::vector<shape_type> &shapes, size_type n_threads)
+    {
+        constexpr auto inf = std::numeric_limits<distance_type>::infinity();
+
+        using bounds_type = std::array<std::array<distance_type, 3>, 2>;
+        std::vector<bounds_type> chunk_bounds (n_threads,
+                                               bounds_type{{{inf, inf, inf}, {-inf, -inf, -inf}}});
+
+        for_each_chunk (n_threads, shapes.size(), [&](size_type chunk_first,
+                                                      size_type chunk_last, size_type chunk_i)
+        {
+            auto &[min, max] = chunk_bounds[chunk_i];
+
+            for (auto i = chunk_first; i != chunk_last; ++i)
+            {
+                for (auto axis = 0; axis != 3; ++axis)
+                {
+                    min[axis] = std::min (min[axis], shapes[i].left_bound (axis));
+                    max[axis] = std::max (max[axis], shapes[i].right_bound (axis));
+                }
+            }
+        });
+
+        auto [min, max] = chunk_bounds.front();
+        for (auto &bounds : chunk_bounds)
+        {
+            for (auto i = 0; i != 3; ++i)
+            {
+                min[i] = std::min (min[i], bounds[0][i]);
+                max[i] = std::max (max[i], bounds[1][i]);
+            }
+        }
+
+        if (min[0] > max[0])
+        {
+            center_ = {};
+            halfwidth_ = 1;
+            return;
+        }
+
+        halfwidth_ = distance_type{};
+        for (auto i = 0; i != 3; ++i)
+        {
+            center_[i] = std::midpoint (min[i], max[i]);
+            halfwidth_ = std::max (halfwidth_, (max[i] - min[i]) / 2);
+        }
+    }
+
+    // Stable least significant digit radix sort of codes carrying order along
+    void radix_sort (std::vector<code_type> &codes, std::vector<index_type> &order,
+                     size_type n_threads) const
+    {
+        constexpr size_type digit_bits = 8;
+        constexpr size_type n_digits = 1 << digit_bits;
+
+        auto n_shapes = codes.size();
+        auto n_passes = (3 * (height_ - 1) + 1 + digit_bits - 1) / digit_bits;
+
+        std::vector<code_type> sorted_codes (n_shapes);
+        std::vector<index_type> sorted_order (n_shapes);
+        std::vector<std::array<size_type, n_digits>> offsets (n_threads);
+
+        for (size_type pass = 0; pass != n_passes; ++pass)
+        {
+            auto shift = pass * digit_bits;
+
+            for_each_chunk (n_threads, n_shapes, [&](size_type chunk_first, size_type chunk_last,
+                                                     size_type chunk_i)
+            {
+                auto &histogram = offsets[chunk_i];
+                histogram.fill (0);
+
+                for (auto i = chunk_first; i != chunk_last; ++i)
+                    ++histogram[(codes[i] >> shift) & (n_digits - 1)];
+            });
+
+            // Chunk i puts its elements with digit d after those of chunks [0; i)
+            size_type offset = 0;
+            for (size_type digit = 0; digit != n_digits; ++digit)
+            {
+                for (auto &histogram : offsets)
+                {
+                    auto count = histogram[digit];
+                    histogram[digit] = offset;
+                    offset += count;
+                }
+            }
+
+            for_each_chunk (n_threads, n_shapes, [&](size_type chunk_first, size_type chunk_last,
+                                                     size_type chunk_i)
+            {
+                auto &chunk_offsets = offsets[chunk_i];
+
+                for (auto i = chunk_first; i != chunk_last; ++i)
+                {
+                    auto position = chunk_offsets[(codes[i] >> shift) & (n_digits - 1)]++;
+                    sorted_codes[position] = codes[i];
+                    sorted_order[position] = order[i];
+                }
+            });
+
+            codes.swap (sorted_codes);
+            order.swap (sorted_order);
+        }
+    }
+
+    // The code of the node the shape is stored in: the shape descends while it doesn't cross
+    // central planes of nodes (see detail::insert_shape ())
+    code_type location_code (const shape_type &shape) const
+    {
+        const auto &bounding_volume = shape.bounding_volume();
+        auto center = center_;
+        auto halfwidth = halfwidth_;
+        code_type code = 1;
+
+        for (size_type depth = 1; depth != height_; ++depth)
+        {
+            auto octant = 0u;
+
+            for (auto i = 0; i != 3; ++i)
+            {
+                auto delta = bounding_volume.center()[i] - center[i];
+
+                if (cmp::less (std::abs (delta), bounding_volume.halfwidth (i)))
+                    return code;
+
+                if (cmp::greater (delta, distance_type{}))
+                    octant |= (1u << i);
+            }
+
+            halfwidth /= 2;
+            for (auto i = 0; i != 3; ++i)
+                center[i] += (octant & (1u << i)) ? halfwidth : -halfwidth;
+
+            code = (code << 3) | octant;
+        }
+
+        return code;
+    }
+
+    // Nodes are the occupied ones and all their ancestors. Sorted codes are grouped by levels,
+    // so the nodes of every level are the merge of the codes of the level and the parents of
+    // the nodes of the next level. Levels are emitted from the deepest one
+    void build_nodes (const std::vector<code_type> &sorted_codes)
+    {
+        std::vector<std::vector<code_type>> levels (height_);
+
+        auto code_it = sorted_codes.end();
+        for (auto depth = height_; depth-- != 0;)
+        {
+            auto level_first = std::partition_point (sorted_codes.begin(), code_it,
+                                                     [depth](code_type code)
+            {
+                return static_cast<size_type>(std::bit_width (code) - 1) / 3 < depth;
+            });
+
+            std::vector<code_type> parents;
+            if (depth + 1 != height_)
+            {
+                parents.reserve (levels[depth + 1].size());
+                for (auto code : levels[depth + 1])
+                    if (parents.empty() || parents.back() != (code >> 3))
+                        parents.push_back (code >> 3);
+            }
+
+            auto &level = levels[depth];
+            level.reserve (std::distance (level_first, code_it) + parents.size());
+            std::set_union (level_first, code_it, parents.begin(), parents.end(),
+                            std::back_inserter (level));
+            level.erase (std::unique (level.begin(), level.end()), level.end());
+
+            code_it = level_first;
+        }
+
+        if (levels.front().empty())
+            levels.front().push_back (1);
+
+        size_type n_nodes = 0;
+        for (auto &level : levels)
+            n_nodes += level.size();
+        nodes_.reserve (n_nodes);
+
+        size_type shape_i = 0;
+        for (auto &level : levels)
+        {
+            for (auto code : level)
+            {
+                auto first_shape = shape_i;
+                while (shape_i != sorted_codes.size() && sorted_codes[shape_i] == code)
+                    ++shape_i;
+
+                nodes_.push_back (node_type{code, 0, static_cast<index_type>(first_shape),
+                                            static_cast<index_type>(shape_i - first_shape), 0});
+            }
+        }
+
+        // Parents precede their children and are sorted in the same order as the children,
+        // so parents are found by one forward pass
+        index_type parent_i = 0;
+        for (index_type node_i = 1; node_i != nodes_.size(); ++node_i)
+        {
+            auto parent_code = nodes_[node_i].code >> 3;
+            while (nodes_[parent_i].code != parent_code)
+                ++parent_i;
+
+            auto &parent = nodes_[parent_i];
+            if (parent.children == 0)
+                parent.first_child = node_i;
+
+            parent.children |= (1u << (nodes_[node_i].code & 7));
+        }
+    }
+};
+
+/*
+ * Broad phase over the nodes and the shapes of a linear octree kept elsewhere, e.g. in a mapped
+ * Octree_Snapshot: nothing is copied, so the storage has to outlive the view. Pairs are
+ * prefiltered by the bounds of the shapes, which are plain loads for Shape_Record.
+ */
+template<typename T, typename U = Shape_Record<T>>
+class Linear_Octree_View final
+{
+public:
+
+    using distance_type = T;
+    using shape_type = U;
+    using size_type = std::size_t;
+    using index_type = std::uint32_t;
+    using code_type = std::uint64_t;
+    using node_type = Linear_Octree_Node;
+    using task_type = Linear_Octree_Task;
+
+private:
+
+    std::span<const node_type> nodes_;
+    std::span<const shape_type> shapes_;
+    size_type height_;
+
+public:
+
+    Linear_Octree_View (std::span<const node_type> nodes, std::span<const shape_type> shapes,
+                        size_type height)
+                       : nodes_{nodes}, shapes_{shapes}, height_{height} {}
+
+    size_type size () const noexcept { return nodes_.size(); }
+    size_type height () const noexcept { return height_; }
+
+    std::span<const node_type> nodes () const { return nodes_; }
+    std::span<const shape_type> shapes () const { return shapes_; }
+
+    // Index of the node with given location code or size () if there is no such node
+    size_type find (code_type code) const { return detail::find_linear_node (nodes_, code); }
+
+    // Broad phase (see Linear_Octree)
+
+    std::vector<task_type> split (size_type min_n_tasks) const
+    {
+        return detail::split_linear_octree (nodes_, min_n_tasks);
+    }
+
+    template<typename F>
+    void for_each_candidate (F &visit) const
+    {
+        if (!nodes_.empty())
+            for_each_candidate (task_type{0, true}, visit);
+    }
+
+    template<typename F>
+    void for_each_candidate (const task_type &task, F &visit) const
+    {
+        auto are_overlapping = [this](index_type i, index_type j)
+        {
+            return geometry::are_overlapping (shapes_[i], shapes_[j]);
+        };
+
+        detail::for_each_linear_node (nodes_, height_, task, [&](const auto &path)
+        {
+            detail::for_each_candidate_in_linear_node (nodes_, path, shapes_, are_overlapping,
+                                                       visit);
+        });
+    }
+};
+
+} // namespace geometry
+
+} // namespace yLab
+
+#endif // INCLUDE_SPACE_PARTITIONING_LINEAR_OCTREE_HPP
@@ -0,0 +1,317 @@
+#ifndef INCLUDE_SPACE_PARTITIONING_LOOSE_OCTREE_HPP
+#define INCLUDE_SPACE_PARTITIONING_LOOSE_OCTREE_HPP
+
+#include <vector>
+#include <array>
+#include <iterator>
+#include <algorithm>
+#include <numeric>
+#include <limits>
+#include <stdexcept>
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+
+#include "double_comparison.hpp"
+#include "shape.hpp"
+
+namespace yLab
+{
+
+namespace geometry
+{
+
+struct Invalid_Looseness final: public std::runtime_error
+{
+    Invalid_Looseness () : std::runtime_error{"Looseness of an octree can't be less than 1"} {}
+};
+
+/*
+ * Loose octree: the bounds of every node are enlarged by the looseness factor around its centre.
+ * A shape goes to the child containing the centre of its bounding box as long as the box fits
+ * into the enlarged bounds of the child, so shapes crossing the central planes of a node don't
+ * stay in it. Children are only allocated if there are shapes to put in them.
+ *
+ * Enlarged bounds of siblings overlap, so the candidates of a shape are found by a query with
+ * its bounding box. Shapes are stored grouped by nodes; a pair is reported by the query
+ * of the shape that is stored first.
+ */
+template<typename T, typename U = Indexed_Shape<T>>
+class Loose_Octree final
+{
+public:
+
+    using distance_type = T;
+    using shape_type = U;
+    using size_type = std::size_t;
+    using index_type = std::uint32_t;
+
+    struct Node final
+    {
+        std::array<distance_type, 3> center;
+        distance_type halfwidth;            // of the node without enlargement
+        std::array<index_type, 8> children; // 0 if there is no child
+        index_type first;                   // shapes of the node are [first; last)
+        index_type last;
+        index_type depth;
+    };
+
+    // Shapes with positions in [first; last) are queried
+    struct Task final
+    {
+        index_type first;
+        index_type last;
+    };
+
+    using node_type = Node;
+    using task_type = Task;
+
+    static constexpr distance_type default_looseness () noexcept { return 2; }
+    static constexpr size_type max_height () noexcept { return 16; }
+
+private:
+
+    struct Box final
+    {
+        std::array<distance_type, 3> min;
+        std::array<distance_type, 3> max;
+    };
+
+    distance_type looseness_;
+    std::vector<node_type> nodes_;
+    std::vector<shape_type> shapes_;
+    std::vector<Box> boxes_;
+    size_type height_ = 0;
+
+public:
+
+    template<std::forward_iterator it>
+    Loose_Octree (it first, it last, distance_type looseness = default_looseness())
+                 : looseness_{looseness}
+    {
+        if (!cmp::greater_equal (looseness_, distance_type{1}))
+            throw Invalid_Looseness{};
+
+        std::vector<shape_type> shapes (first, last);
+        auto n_shapes = static_cast<size_type>(shapes.size());
+        if (n_shapes == 0)
+            return;
+
+        std::vector<Box> boxes;
+        boxes.reserve (n_shapes);
+
+        for (auto &shape : shapes)
+        {
+            boxes.push_back (Box{{shape.left_bound (0), shape.left_bound (1),
+                                  shape.left_bound (2)},
+                                 {shape.right_bound (0), shape.right_bound (1),
+                                  shape.right_bound (2)}});
+        }
+
+        create_root (boxes);
+
+        std::vector<index_type> shape_nodes;
+        shape_nodes.reserve (n_shapes);
+        for (auto &box : boxes)
+            shape_nodes.push_back (insert (box));
+
+        // Counting sort of shapes by nodes
+        std::vector<index_type> offsets (nodes_.size() + 1, 0);
+        for (auto node_i : shape_nodes)
+            ++offsets[node_i + 1];
+
+        for (size_type node_i = 0; node_i != nodes_.size(); ++node_i)
+        {
+            offsets[node_i + 1] += offsets[node_i];
+            nodes_[node_i].first = offsets[node_i];
+            nodes_[node_i].last = offsets[node_i];
+        }
+
+        shapes_.reserve (n_shapes);
+        boxes_.resize (n_shapes);
+        std::vector<index_type> order (n_shapes);
+
+        for (size_type shape_i = 0; shape_i != n_shapes; ++shape_i)
+            order[nodes_[shape_nodes[shape_i]].last++] = static_cast<index_type>(shape_i);
+
+        for (size_type position = 0; position != n_shapes; ++position)
+        {
+            shapes_.push_back (shapes[order[position]]);
+            boxes_[position] = boxes[order[position]];
+        }
+    }
+
+    size_type size () const noexcept { return nodes_.size(); }
+    size_type height () const noexcept { return height_; }
+    distance_type looseness () const noexcept { return looseness_; }
+
+    const std::vector<node_type> &nodes () const { return nodes_; }
+
+    // The number of shapes stored in nodes of every depth; the root has depth 0
+    std::vector<size_type> depth_histogram () const
+    {
+        std::vector<size_type> histogram (height_);
+        for (auto &node : nodes_)
+            histogram[node.depth] += node.last - node.first;
+
+        return histogram;
+    }
+
+    // Broad phase
+
+    std::vector<task_type> split (size_type min_n_tasks) const
+    {
+        auto n_shapes = shapes_.size();
+        min_n_tasks = std::clamp (min_n_tasks, size_type{1}, std::max (n_shapes, size_type{1}));
+
+        std::vector<task_type> tasks;
+        tasks.reserve (min_n_tasks);
+
+        for (size_type i = 0; i != min_n_tasks; ++i)
+            tasks.push_back (task_type{static_cast<index_type>(n_shapes * i / min_n_tasks),
+                                       static_cast<index_type>(n_shapes * (i + 1) / min_n_tasks)});
+
+        return tasks;
+    }
+
+    template<typename F>
+    void for_each_candidate (F &visit) const
+    {
+        for_each_candidate (task_type{0, static_cast<index_type>(shapes_.size())}, visit);
+    }
+
+    template<typename F>
+    void for_each_candidate (const task_type &task, F &visit) const
+    {
+        std::vector<index_type> stack;
+        stack.reserve (7 * height_ + 1);
+
+        for (auto position = task.first; position != task.last; ++position)
+        {
+            auto &box = boxes_[position];
+            stack.push_back (0);
+
+            while (!stack.empty())
+            {
+                auto &node = nodes_[stack.back()];
+                stack.pop_back();
+
+                if (!are_overlapping (loose_box (node), box))
+                    continue;
+
+                for (auto other = std::max (node.first, position + 1); other < node.last; ++other)
+                    if (are_overlapping (box, boxes_[other]))
+                        visit (shapes_[position], shapes_[other]);
+
+                for (auto child : node.children)
+                    if (child)
+                        stack.push_back (child);
+            }
+        }
+    }
+
+private:
+
+    static bool are_overlapping (const Box &first, const Box &second)
+    {
+        for (auto i = 0; i != 3; ++i)
+        {
+            if (!cmp::less_equal (first.min[i], second.max[i]) ||
+                !cmp::less_equal (second.min[i], first.max[i]))
+                return false;
+        }
+
+        return true;
+    }
+
+    Box loose_box (const node_type &node) const
+    {
+        auto halfwidth = looseness_ * node.halfwidth;
+        auto &center = node.center;
+
+        return Box{{center[0] - halfwidth, center[1] - halfwidth, center[2] - halfwidth},
+                   {center[0] + halfwidth, center[1] + halfwidth, center[2] + halfwidth}};
+    }
+
+    void create_root (const std::vector<Box> &boxes)
+    {
+        constexpr auto inf = std::numeric_limits<distance_type>::infinity();
+
+        auto bounds = Box{{inf, inf, inf}, {-inf, -inf, -inf}};
+        for (auto &box : boxes)
+        {
+            for (auto i = 0; i != 3; ++i)
+            {
+                bounds.min[i] = std::min (bounds.min[i], box.min[i]);
+                bounds.max[i] = std::max (bounds.max[i], box.max[i]);
+            }
+        }
+
+        distance_type halfwidth{};
+        std::array<distance_type, 3> center;
+
+        for (auto i = 0; i != 3; ++i)
+        {
+            center[i] = std::midpoint (bounds.min[i], bounds.max[i]);
+            halfwidth = std::max (halfwidth, (bounds.max[i] - bounds.min[i]) / 2);
+        }
+
+        nodes_.push_back (node_type{center, halfwidth, {}, 0, 0, 0});
+        height_ = 1;
+    }
+
+    // Returns the index of the node the box is stored in; allocates nodes on the way
+    index_type insert (const Box &box)
+    {
+        std::array<distance_type, 3> center;
+        std::array<distance_type, 3> halfwidth;
+
+        for (auto i = 0; i != 3; ++i)
+        {
+            center[i] = std::midpoint (box.min[i], box.max[i]);
+            halfwidth[i] = (box.max[i] - box.min[i]) / 2;
+        }
+
+        index_type node_i = 0;
+
+        for (auto depth = 1u; depth != max_height(); ++depth)
+        {
+            auto &node = nodes_[node_i];
+            auto child_halfwidth = node.halfwidth / 2;
+            auto loose_halfwidth = looseness_ * child_halfwidth;
+
+            auto child_i = 0;
+            std::array<distance_type, 3> child_center;
+
+            for (auto i = 0; i != 3; ++i)
+            {
+                auto upper = !(center[i] < node.center[i]);
+
+                child_i |= (upper << i);
+                child_center[i] = node.center[i] + (upper ? child_halfwidth : -child_halfwidth);
+
+                if (std::abs (center[i] - child_center[i]) + halfwidth[i] > loose_halfwidth)
+                    return node_i;
+            }
+
+            if (!node.children[child_i])
+            {
+                auto new_child = static_cast<index_type>(nodes_.size());
+                nodes_[node_i].children[child_i] = new_child;
+                nodes_.push_back (node_type{child_center, child_halfwidth, {}, 0, 0,
+                                            static_cast<index_type>(depth)});
+                height_ = std::max (height_, size_type{depth} + 1);
+            }
+
+            node_i = nodes_[node_i].children[child_i];
+        }
+
+        return node_i;
+    }
+};
+
+} // namespace geometry
+
+} // namespace yLab
+
+#endif // INCLUDE_SPACE_PARTITIONING_LOOSE_OCTREE_HPP
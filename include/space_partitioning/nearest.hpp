@@ -0,0 +1,61 @@
+#ifndef INCLUDE_SPACE_PARTITIONING_NEAREST_HPP
+#define INCLUDE_SPACE_PARTITIONING_NEAREST_HPP
+
+#include <array>
+#include <cstddef>
+
+#include "point.hpp"
+#include "shape.hpp"
+#include "closest_point.hpp"
+
+namespace yLab
+{
+
+namespace geometry
+{
+
+// A shape found by a distance query and its point nearest to the query point
+template<typename T>
+struct Neighbour final
+{
+    std::size_t index;
+    T distance;
+    Point_3D<T> point;
+};
+
+namespace detail
+{
+
+// The point of a shape (Indexed_Shape or Shape_Record) nearest to pt
+template<typename T, typename Shape>
+Point_3D<T> closest_point_of_shape (const Point_3D<T> &pt, const Shape &shape)
+{
+    return visit_primitive (shape, [&pt](const auto &primitive)
+    {
+        return closest_point (pt, primitive);
+    });
+}
+
+// The squared distance from pt to the box [min; max]: a lower bound of the distance
+// to everything inside the box
+template<typename T>
+T squared_distance (const Point_3D<T> &pt, const std::array<T, 3> &min, const std::array<T, 3> &max)
+{
+    T distance_2{};
+
+    for (auto i = 0; i != 3; ++i)
+    {
+        auto delta = std::max ({min[i] - pt[i], pt[i] - max[i], T{}});
+        distance_2 += delta * delta;
+    }
+
+    return distance_2;
+}
+
+} // namespace detail
+
+} // namespace geometry
+
+} // namespace yLab
+
+#endif // INCLUDE_SPACE_PARTITIONING_NEAREST_HPP
@@ -4,6 +4,8 @@
 #include <cmath>
 #include <array>
 #include <vector>
+#include <algorithm>
+#include <cstdint>
 
 #include "vector"
 #include "shape.hpp"
@@ -24,11 +26,12 @@ public:
     using vector_type = Vector<distance_type>;
     using shape_type = U;
     using point_type = typename Primitive_Traits<distance_type>::point_type;
+    using slot_type = std::uint32_t;
 
 private:
 
     std::array<Octree_Node *, 8> children_{};
-    std::vector<shape_type> shapes_;
+    std::vector<slot_type> shapes_; // slots of the shapes in the shape store of the tree
     point_type center_;
     distance_type halfwidth_;
 
@@ -45,43 +48,63 @@ public:
     const point_type &center () const { return center_; }
     distance_type halfwidth () const { return halfwidth_; }
 
-    const std::vector<shape_type> &shapes () const { return shapes_; }
-    std::vector<shape_type> &shapes () { return shapes_; }
+    const std::vector<slot_type> &shapes () const { return shapes_; }
+    std::vector<slot_type> &shapes () { return shapes_; }
 
     // Modifiers
 
-    void add_shape (const shape_type &shape) { shapes_.push_back (shape); }
+    void add_shape (slot_type slot) { shapes_.push_back (slot); }
+
+    // The order of shapes in the node isn't preserved
+    bool remove_shape (slot_type slot)
+    {
+        auto it = std::find (shapes_.begin(), shapes_.end(), slot);
+
+        if (it == shapes_.end())
+            return false;
+
+        *it = shapes_.back();
+        shapes_.pop_back();
+
+        return true;
+    }
 };
 
 namespace detail
 {
 
-template<typename T>
-void insert_shape (Octree_Node<T> *root, const typename Octree_Node<T>::shape_type &shape)
+// The child of the node the shape lies in entirely or nullptr if the shape crosses
+// one of the central planes of the node or the node is a leaf
+template<typename Node>
+Node *next_node (Node *node, const typename Node::shape_type &shape)
 {
-    auto index = 0;
-    bool within_range = false;
+    using distance_type = typename Node::distance_type;
 
-    auto &bounding_volume = shape.bounding_volume();
+    const auto &bounding_volume = shape.bounding_volume();
+    auto index = 0;
 
     for (auto i = 0; i != 3; ++i)
     {
-        auto delta = bounding_volume.center()[i] - root->center()[i];
+        auto delta = bounding_volume.center()[i] - node->center()[i];
 
         if (cmp::less (std::abs (delta), bounding_volume.halfwidth (i)))
-        {
-            within_range = true;
-            break;
-        }
+            return nullptr;
 
-        if (cmp::greater (delta, T{}))
+        if (cmp::greater (delta, distance_type{}))
             index |= (1 << i);
     }
 
-    if (!within_range && root->child (index))
-        insert_shape (root->child (index), shape);
-    else
-        root->add_shape (shape);
+    return node->child (index);
+}
+
+// The node the shape is stored in
+template<typename Node>
+Node *target_node (Node *root, const typename Node::shape_type &shape)
+{
+    while (auto child = next_node (root, shape))
+        root = child;
+
+    return root;
 }
 
 } // namespace detail
@@ -10,9 +10,18 @@
 #include <array>
 #include <memory>
 #include <numeric>
+#include <algorithm>
+#include <optional>
+#include <limits>
+#include <thread>
+#include <span>
 
 #include "shape.hpp"
 #include "node.hpp"
+#include "shape_store.hpp"
+#include "ray.hpp"
+#include "nearest.hpp"
+#include "range_query.hpp"
 #include "primitive_traits.hpp"
 
 namespace yLab
@@ -35,11 +44,30 @@ public:
     using point_type = typename Primitive_Traits<T>::point_type;
     using shape_type = U;
     using node_type = Octree_Node<distance_type, shape_type>;
+    using store_type = Shape_Store<distance_type, shape_type>;
+    using slot_type = typename store_type::slot_type;
+    using ray_type = Ray<distance_type>;
+    using hit_type = Ray_Hit<distance_type>;
+
+    template<std::size_t N>
+    using packet_type = Ray_Packet<distance_type, N>;
+    using neighbour_type = Neighbour<distance_type>;
     using size_type = std::size_t;
 
+    // A part of the tree that may be processed independently of the others. If descend is false,
+    // only shapes of the last node of the path are tested against their ancestors
+    struct Task final
+    {
+        std::vector<const node_type *> path; // from the root to the subroot inclusive
+        bool descend;
+    };
+
+    using task_type = Task;
+
 private:
 
     std::vector<node_type> nodes_;
+    store_type store_;
     size_type height_;
 
 public:
@@ -52,12 +80,14 @@ public:
 
         auto n_shapes = std::distance(first, last);
         nodes_.reserve (n_shapes);
+        store_.reserve (n_shapes);
         height_ = std::min (max_height(), pseudo_optimal_height (n_shapes));
 
         auto [center, halfwidth] = calculate_octree_parameters (first, last);
 
         build_subtree (center, halfwidth, height_);
         insert (first, last);
+        group_shapes_by_nodes ();
     }
 
     size_type height () const noexcept { return height_; }
@@ -69,11 +99,41 @@ public:
         return (static_cast<size_type>(std::exp2 (3 * height())) - 1) / (8 - 1);
     }
 
+    // The number of shapes stored in nodes of every depth; the root has depth 0
+    std::vector<size_type> depth_histogram () const
+    {
+        std::vector<size_type> histogram (height());
+        std::vector<std::pair<const node_type *, size_type>> stack{{std::addressof (root()), 0}};
+
+        while (!stack.empty())
+        {
+            auto [node, depth] = stack.back();
+            stack.pop_back();
+
+            histogram[depth] += node->shapes().size();
+
+            for (auto i = 0; i != 8; ++i)
+                if (node->child (i))
+                    stack.emplace_back (node->child (i), depth + 1);
+        }
+
+        return histogram;
+    }
+
+    // Shapes of the tree; nodes refer to them by slots
+    const store_type &store () const { return store_; }
+
     // Modifiers
 
+    // Traversals prune nodes by their cubes, so the root cube grows to contain every shape
+    // inserted outside it; that rebuilds the tree
+
     void insert (const shape_type &shape)
     {
-        detail::insert_shape (std::addressof (root()), shape);
+        if (!is_in_root (shape))
+            grow_root (shape);
+
+        detail::target_node (std::addressof (root()), shape)->add_shape (store_.insert (shape));
     }
 
     template<std::input_iterator it>
@@ -84,11 +144,791 @@ public:
             insert (*first);
     }
 
+    // Removes the shape with the same index as the given one. The bounding volume of the shape
+    // has to be the same as the one it was inserted with
+    bool erase (const shape_type &shape)
+    {
+        auto node = detail::target_node (std::addressof (root()), shape);
+        auto slot = find_slot (*node, shape);
+
+        if (slot == no_slot_)
+            return false;
+
+        node->remove_shape (slot);
+        store_.erase (slot);
+
+        return true;
+    }
+
+    // Relocates the entry of old_shape if the bounding volume has changed. Returns false
+    // and doesn't insert new_shape if there is no old_shape in the tree
+    bool update (const shape_type &old_shape, const shape_type &new_shape)
+    {
+        auto old_node = detail::target_node (std::addressof (root()), old_shape);
+        auto slot = find_slot (*old_node, old_shape);
+
+        if (slot == no_slot_)
+            return false;
+
+        // Growing rebuilds the nodes and renumbers the slots
+        if (!is_in_root (new_shape))
+        {
+            grow_root (new_shape);
+            old_node = detail::target_node (std::addressof (root()), old_shape);
+            slot = find_slot (*old_node, old_shape);
+        }
+
+        auto new_node = detail::target_node (std::addressof (root()), new_shape);
+
+        store_.replace (slot, new_shape);
+
+        if (old_node != new_node)
+        {
+            old_node->remove_shape (slot);
+            new_node->add_shape (slot);
+        }
+
+        return true;
+    }
+
     const node_type &root () const { return nodes_.front(); }
     node_type &root () { return nodes_.front(); }
 
+    // Calls visit for every shape of the tree but the one with the same index as the given shape
+    // that may intersect it: the shape is either in the node the given shape would be stored in,
+    // in one of its ancestors or in one of its descendants
+    template<typename F>
+    void for_each_neighbour (const shape_type &shape, F &visit) const
+    {
+        auto visit_node = [this, &shape, &visit](const node_type *node)
+        {
+            for (auto slot : node->shapes())
+                if (store_.index (slot) != shape.index())
+                    visit (store_[slot]);
+        };
+
+        auto node = std::addressof (root());
+        for (auto child = node; child; child = detail::next_node (node, shape))
+        {
+            node = child;
+            visit_node (node);
+        }
+
+        std::vector<const node_type *> stack;
+        for (auto i = 0; i != 8; ++i)
+            if (node->child (i))
+                stack.push_back (node->child (i));
+
+        while (!stack.empty())
+        {
+            auto descendant = stack.back();
+            stack.pop_back();
+
+            visit_node (descendant);
+
+            for (auto i = 0; i != 8; ++i)
+                if (descendant->child (i))
+                    stack.push_back (descendant->child (i));
+        }
+    }
+
+    // Ray casts. Nodes crossed by the ray are traversed front to back; only shapes whose
+    // bounding boxes the ray crosses reach the exact test
+
+    // The nearest hit or nullopt if the ray doesn't hit anything
+    std::optional<hit_type> cast (const ray_type &ray) const
+    {
+        std::optional<hit_type> nearest;
+
+        auto visit = [&nearest](const hit_type &hit)
+        {
+            if (!nearest || hit.t < nearest->t)
+                nearest = hit;
+        };
+
+        auto max_t = [&nearest, &ray] { return nearest ? nearest->t : ray.max_t(); };
+
+        cast_through_subtree (root(), ray, visit, max_t);
+        return nearest;
+    }
+
+    // The nearest hits of a packet of coherent rays. The packet descends as a whole: a node
+    // is visited while any of its lanes crosses it and every lane is pruned by its own
+    // nearest hit
+    template<std::size_t N>
+    std::array<std::optional<hit_type>, N> cast (const packet_type<N> &packet) const
+    {
+        std::array<std::optional<hit_type>, N> nearest;
+        auto max_t = packet.max_t();
+
+        cast_packet_through_subtree (root(), packet, packet.lanes(), nearest, max_t);
+        return nearest;
+    }
+
+    // Calls visit (hit) for every shape hit by the ray in no particular order
+    template<typename F>
+    void for_each_hit (const ray_type &ray, F visit) const
+    {
+        auto max_t = [&ray] { return ray.max_t(); };
+        cast_through_subtree (root(), ray, visit, max_t);
+    }
+
+    // Distance queries. Nodes are visited best first, by the distance from the point to their
+    // cubes; as ray casts, the search relies on every shape lying in the cube of its node
+
+    // The k shapes nearest to the point ordered by distance; all shapes if there are fewer
+    std::vector<neighbour_type> nearest (const point_type &point, size_type k) const
+    {
+        Search_Buffers buffers;
+        return search_nearest (point, k, buffers);
+    }
+
+    // The nearest shape or nullopt if the tree is empty
+    std::optional<neighbour_type> closest (const point_type &point) const
+    {
+        Search_Buffers buffers;
+        return closest (point, buffers);
+    }
+
+    // closest () for every point of [first; last): points are split into n_threads chunks
+    // processed on separate threads
+    template<std::random_access_iterator it>
+    std::vector<std::optional<neighbour_type>> closest (it first, it last,
+                                                        size_type n_threads) const
+    {
+        auto n_points = static_cast<size_type>(std::distance (first, last));
+        std::vector<std::optional<neighbour_type>> neighbours (n_points);
+
+        for_each_chunk (n_points, n_threads, [&](size_type chunk_first, size_type chunk_last)
+        {
+            Search_Buffers buffers;
+            for (auto i = chunk_first; i != chunk_last; ++i)
+                neighbours[i] = closest (first[i], buffers);
+        });
+
+        return neighbours;
+    }
+
+    // Range queries. The box is enlarged by the tolerance of cmp, so shapes touching it
+    // are reported too
+
+    // Writes indexes of the shapes of the given kinds overlapping the box to out and returns
+    // the end of the output. Nothing is allocated
+    template<std::output_iterator<size_type> O>
+    O query (const AABB<distance_type> &box, O out,
+             Primitive_Kinds kinds = Primitive_Kinds::all) const
+    {
+        detail::Query_Box<distance_type> query_box{box};
+
+        // Every pop pushes at most 8 children, so a depth-first stack never holds more than
+        // 7 nodes per level plus the children of the deepest one
+        constexpr auto stack_capacity = 8 * max_height();
+        static_assert (stack_capacity >= 7 * (max_height() - 1) + 8);
+
+        std::array<const node_type *, stack_capacity> stack;
+        size_type stack_size = 0;
+        stack[stack_size++] = std::addressof (root());
+
+        while (stack_size)
+        {
+            auto node = stack[--stack_size];
+
+            for (auto slot : node->shapes())
+            {
+                auto min = store_.min (slot);
+                auto max = store_.max (slot);
+
+                if (!query_box.overlaps (min, max))
+                    continue;
+
+                auto shape = store_[slot];
+                auto is_in_box = query_box.contains (min, max)
+                               ? detail::visit_primitive (shape, [kinds](const auto &primitive)
+                                 {
+                                     return contains (kinds, detail::kind_of (primitive));
+                                 })
+                               : detail::is_shape_in_box (shape, query_box, kinds);
+                if (is_in_box)
+                    *out++ = shape.index();
+            }
+
+            for (auto i = 0; i != 8; ++i)
+                if (auto child = node->child (i);
+                    child && query_box.overlaps (cube_min (*child), cube_max (*child)))
+                    stack[stack_size++] = child;
+        }
+
+        return out;
+    }
+
+    // query () for every box of [first; last): boxes are split into n_threads chunks processed
+    // on separate threads. Returns the indexes found for every box
+    template<std::random_access_iterator it>
+    std::vector<std::vector<size_type>> query (it first, it last, size_type n_threads,
+                                               Primitive_Kinds kinds = Primitive_Kinds::all) const
+    {
+        auto n_boxes = static_cast<size_type>(std::distance (first, last));
+        std::vector<std::vector<size_type>> indexes (n_boxes);
+
+        for_each_chunk (n_boxes, n_threads, [&](size_type chunk_first, size_type chunk_last)
+        {
+            for (auto i = chunk_first; i != chunk_last; ++i)
+                query (first[i], std::back_inserter (indexes[i]), kinds);
+        });
+
+        return indexes;
+    }
+
+    // Broad phase
+
+    // Breadth-first descent until there are enough subtrees to keep all threads busy.
+    // Every node above the final frontier becomes a task of its own
+    std::vector<task_type> split (size_type min_n_tasks) const
+    {
+        std::vector<task_type> frontier;
+        std::vector<task_type> tasks;
+
+        frontier.push_back (task_type{{std::addressof (root())}, true});
+
+        while (frontier.size() < min_n_tasks)
+        {
+            std::vector<task_type> next_frontier;
+
+            for (auto &task : frontier)
+            {
+                auto subroot = task.path.back();
+
+                for (auto i = 0; i != 8; ++i)
+                {
+                    if (auto child = subroot->child (i))
+                    {
+                        auto path = task.path;
+                        path.push_back (child);
+                        next_frontier.push_back (task_type{std::move (path), true});
+                    }
+                }
+            }
+
+            if (next_frontier.empty())
+                break;
+
+            for (auto &task : frontier)
+            {
+                task.descend = false;
+                tasks.push_back (std::move (task));
+            }
+
+            frontier = std::move (next_frontier);
+        }
+
+        // Deeper nodes go first (see for_each_candidate ())
+        std::move (tasks.rbegin(), tasks.rend(), std::back_inserter (frontier));
+
+        return frontier;
+    }
+
+    // Calls visit for every pair of shapes one of which lies in a node and the other one
+    // lies in the same node or in one of its ancestors. Shapes in different subtrees
+    // can't intersect. Pairs with disjoint bounding boxes are skipped. Nodes are visited
+    // in post-order and ancestors from the nearest one: small nearby shapes go first, so they
+    // are likely to be found intersecting before they are tested against large shapes near
+    // the root
+    template<typename F>
+    void for_each_candidate (F &visit) const
+    {
+        std::vector<const node_type *> ancestor_stack;
+        ancestor_stack.reserve (height());
+        ancestor_stack.push_back (std::addressof (root()));
+
+        for_each_candidate_in_subtree (ancestor_stack, visit);
+    }
+
+    template<typename F>
+    void for_each_candidate (const task_type &task, F &visit) const
+    {
+        if (task.descend)
+        {
+            auto ancestor_stack = task.path;
+            for_each_candidate_in_subtree (ancestor_stack, visit);
+        }
+        else
+            for_each_candidate_in_node (task.path, visit);
+    }
+
+    // Calls visit (shape, other_shape) for every pair of shapes with overlapping bounding boxes
+    // one of which is from this tree and the other one is from other. Both trees are descended
+    // simultaneously; pairs of nodes whose cubes don't overlap are pruned
+    template<typename V, typename F>
+    void for_each_cross_candidate (const Octree<distance_type, V> &other, F &visit) const
+    {
+        visit_cross_nodes (root(), other, other.root(), visit);
+    }
+
 private:
 
+    template<typename, typename> friend class Octree;
+
+    template<typename V>
+    using other_node_type = typename Octree<distance_type, V>::node_type;
+
+    static constexpr slot_type no_slot_ = -1;
+
+    template<typename Node_1, typename Node_2>
+    static bool are_overlapping_cubes (const Node_1 &node_1, const Node_2 &node_2)
+    {
+        auto halfwidths = node_1.halfwidth() + node_2.halfwidth();
+
+        return !cmp::greater (std::abs (node_1.center().x() - node_2.center().x()), halfwidths) &&
+               !cmp::greater (std::abs (node_1.center().y() - node_2.center().y()), halfwidths) &&
+               !cmp::greater (std::abs (node_1.center().z() - node_2.center().z()), halfwidths);
+    }
+
+    // Shapes of node against shapes of other_node
+    template<typename V, typename F>
+    void visit_cross_shapes (const node_type &node,
+                             const Octree<distance_type, V> &other,
+                             const other_node_type<V> &other_node, F &visit) const
+    {
+        auto &other_store = other.store_;
+
+        for (auto slot_1 : node.shapes())
+        {
+            for (auto slot_2 : other_node.shapes())
+            {
+                if (store_.are_overlapping (slot_1, other_store, slot_2))
+                    visit (store_[slot_1], other_store[slot_2]);
+            }
+        }
+    }
+
+    // Every pair of shapes of the subtrees of node and other_node is visited exactly once:
+    // shapes of both nodes, shapes of one node against the subtrees of the children of
+    // the other one and pairs of the subtrees of children
+    template<typename V, typename F>
+    void visit_cross_nodes (const node_type &node,
+                            const Octree<distance_type, V> &other,
+                            const other_node_type<V> &other_node, F &visit) const
+    {
+        if (!are_overlapping_cubes (node, other_node))
+            return;
+
+        visit_cross_shapes (node, other, other_node, visit);
+
+        for (auto j = 0; j != 8; ++j)
+            if (auto other_child = other_node.child (j))
+                visit_node_against_subtree (node, other, *other_child, visit);
+
+        for (auto i = 0; i != 8; ++i)
+        {
+            auto child = node.child (i);
+            if (!child)
+                continue;
+
+            visit_subtree_against_node (*child, other, other_node, visit);
+
+            for (auto j = 0; j != 8; ++j)
+                if (auto other_child = other_node.child (j))
+                    visit_cross_nodes (*child, other, *other_child, visit);
+        }
+    }
+
+    // Shapes of node against the subtree of other_subroot
+    template<typename V, typename F>
+    void visit_node_against_subtree (const node_type &node,
+                                     const Octree<distance_type, V> &other,
+                                     const other_node_type<V> &other_subroot, F &visit) const
+    {
+        if (node.shapes().empty() || !are_overlapping_cubes (node, other_subroot))
+            return;
+
+        visit_cross_shapes (node, other, other_subroot, visit);
+
+        for (auto j = 0; j != 8; ++j)
+            if (auto other_child = other_subroot.child (j))
+                visit_node_against_subtree (node, other, *other_child, visit);
+    }
+
+    // The subtree of subroot against shapes of other_node
+    template<typename V, typename F>
+    void visit_subtree_against_node (const node_type &subroot,
+                                     const Octree<distance_type, V> &other,
+                                     const other_node_type<V> &other_node, F &visit) const
+    {
+        if (other_node.shapes().empty() || !are_overlapping_cubes (subroot, other_node))
+            return;
+
+        visit_cross_shapes (subroot, other, other_node, visit);
+
+        for (auto i = 0; i != 8; ++i)
+            if (auto child = subroot.child (i))
+                visit_subtree_against_node (*child, other, other_node, visit);
+    }
+
+    // max_t () is the parameter beyond which nothing is searched for; it decreases as the nearest
+    // hit is found
+    template<typename F, typename G>
+    void cast_through_subtree (const node_type &node, const ray_type &ray, F &visit,
+                               const G &max_t) const
+    {
+        for (auto slot : node.shapes())
+        {
+            auto [t_enter, t_exit] = ray.clip (store_.min (slot), store_.max (slot));
+            t_exit = std::min (t_exit, max_t());
+
+            distance_type t;
+            if (t_enter <= t_exit && detail::hit_shape (ray, store_[slot], t_enter, t_exit, t))
+                visit (hit_type{store_.index (slot), t});
+        }
+
+        std::array<std::pair<distance_type, const node_type *>, 8> children;
+        size_type n_children = 0;
+
+        for (auto i = 0; i != 8; ++i)
+        {
+            auto child = node.child (i);
+            if (!child)
+                continue;
+
+            auto [t_enter, t_exit] = ray.clip (cube_min (*child), cube_max (*child));
+            if (t_enter <= t_exit)
+                children[n_children++] = {t_enter, child};
+        }
+
+        std::ranges::sort (std::span{children.data(), n_children}, {},
+                           &std::pair<distance_type, const node_type *>::first);
+
+        for (size_type i = 0; i != n_children; ++i)
+        {
+            if (children[i].first > max_t())
+                break;
+
+            cast_through_subtree (*children[i].second, ray, visit, max_t);
+        }
+    }
+
+    // Calls f (chunk_first, chunk_last) for n_chunks chunks of [0; n) on separate threads
+    template<typename F>
+    static void for_each_chunk (size_type n, size_type n_chunks, F f)
+    {
+        n_chunks = std::clamp (n_chunks, size_type{1}, std::max (n, size_type{1}));
+
+        std::vector<std::thread> threads;
+        threads.reserve (n_chunks - 1);
+
+        for (size_type chunk_i = 1; chunk_i < n_chunks; ++chunk_i)
+            threads.emplace_back (f, n * chunk_i / n_chunks, n * (chunk_i + 1) / n_chunks);
+        f (0, n / n_chunks);
+
+        for (auto &thread : threads)
+            thread.join();
+    }
+
+    // Scratch of distance queries reused by the queries of one thread
+    struct Search_Buffers final
+    {
+        // Nodes to visit keyed by the squared distance to their cubes
+        std::vector<std::pair<distance_type, const node_type *>> nodes;
+
+        // A max-heap of the best candidates by squared distance
+        std::vector<std::pair<distance_type, neighbour_type>> found;
+    };
+
+    std::optional<neighbour_type> closest (const point_type &point, Search_Buffers &buffers) const
+    {
+        auto neighbours = search_nearest (point, 1, buffers);
+        if (neighbours.empty())
+            return std::nullopt;
+
+        return neighbours.front();
+    }
+
+    std::vector<neighbour_type> search_nearest (const point_type &point, size_type k,
+                                                Search_Buffers &buffers) const
+    {
+        auto &nodes = buffers.nodes;
+        auto &found = buffers.found;
+        nodes.clear();
+        found.clear();
+
+        if (k == 0)
+            return {};
+
+        auto nearer_node = [](auto &lhs, auto &rhs) { return lhs.first > rhs.first; };
+        auto nearer_shape = [](auto &lhs, auto &rhs) { return lhs.first < rhs.first; };
+
+        // The squared distance beyond which nothing can get into the k nearest
+        auto bound = [&found, k]
+        {
+            return (found.size() < k) ? std::numeric_limits<distance_type>::infinity()
+                                      : found.front().first;
+        };
+
+        nodes.emplace_back (distance_type{}, std::addressof (root()));
+
+        while (!nodes.empty())
+        {
+            std::pop_heap (nodes.begin(), nodes.end(), nearer_node);
+            auto [node_distance_2, node] = nodes.back();
+            nodes.pop_back();
+
+            if (node_distance_2 > bound())
+                break;
+
+            for (auto slot : node->shapes())
+            {
+                auto box_distance_2 = detail::squared_distance (point, store_.min (slot),
+                                                                store_.max (slot));
+                if (box_distance_2 > bound())
+                    continue;
+
+                auto shape = store_[slot];
+                auto nearest_point = detail::closest_point_of_shape (point, shape);
+                auto distance_2 = Vector{point, nearest_point}.norm();
+
+                if (found.size() == k)
+                {
+                    if (distance_2 >= found.front().first)
+                        continue;
+
+                    std::pop_heap (found.begin(), found.end(), nearer_shape);
+                    found.pop_back();
+                }
+
+                found.emplace_back (distance_2, neighbour_type{shape.index(),
+                                                               std::sqrt (distance_2),
+                                                               nearest_point});
+                std::push_heap (found.begin(), found.end(), nearer_shape);
+            }
+
+            for (auto i = 0; i != 8; ++i)
+            {
+                auto child = node->child (i);
+                if (!child)
+                    continue;
+
+                auto distance_2 = detail::squared_distance (point, cube_min (*child),
+                                                            cube_max (*child));
+                if (distance_2 <= bound())
+                {
+                    nodes.emplace_back (distance_2, child);
+                    std::push_heap (nodes.begin(), nodes.end(), nearer_node);
+                }
+            }
+        }
+
+        std::sort_heap (found.begin(), found.end(), nearer_shape);
+
+        std::vector<neighbour_type> neighbours;
+        neighbours.reserve (found.size());
+        for (auto &[distance_2, neighbour] : found)
+            neighbours.push_back (neighbour);
+
+        return neighbours;
+    }
+
+    template<std::size_t N>
+    void cast_packet_through_subtree (const node_type &node, const packet_type<N> &packet,
+                                      typename packet_type<N>::mask_type active,
+                                      std::array<std::optional<hit_type>, N> &nearest,
+                                      typename packet_type<N>::lanes_type &max_t) const
+    {
+        using mask_type = typename packet_type<N>::mask_type;
+        typename packet_type<N>::lanes_type t_enter, t_exit, t;
+
+        for (auto slot : node.shapes())
+        {
+            auto lanes = packet.clip (store_.min (slot), store_.max (slot), max_t, active,
+                                      t_enter, t_exit);
+            if (!lanes)
+                continue;
+
+            auto hits = detail::hit_shape (packet, store_[slot], lanes, t_enter, t_exit, t);
+            for (std::size_t lane = 0; lane != N; ++lane)
+            {
+                auto is_nearer = !nearest[lane] || t[lane] < nearest[lane]->t;
+                if ((hits & (mask_type{1} << lane)) && is_nearer)
+                {
+                    nearest[lane] = hit_type{store_.index (slot), t[lane]};
+                    max_t[lane] = t[lane];
+                }
+            }
+        }
+
+        // Children are ordered by the nearest entry of any lane
+        std::array<std::pair<distance_type, const node_type *>, 8> children;
+        size_type n_children = 0;
+
+        for (auto i = 0; i != 8; ++i)
+        {
+            auto child = node.child (i);
+            if (!child)
+                continue;
+
+            auto lanes = packet.clip (cube_min (*child), cube_max (*child), max_t, active,
+                                      t_enter, t_exit);
+            if (!lanes)
+                continue;
+
+            auto entry = std::numeric_limits<distance_type>::infinity();
+            for (std::size_t lane = 0; lane != N; ++lane)
+                if (lanes & (mask_type{1} << lane))
+                    entry = std::min (entry, t_enter[lane]);
+
+            children[n_children++] = {entry, child};
+        }
+
+        std::ranges::sort (std::span{children.data(), n_children}, {},
+                           &std::pair<distance_type, const node_type *>::first);
+
+        // Lanes that have found hits nearer than a child since the sorting skip it
+        for (size_type i = 0; i != n_children; ++i)
+        {
+            auto &child = *children[i].second;
+            auto lanes = packet.clip (cube_min (child), cube_max (child), max_t, active,
+                                      t_enter, t_exit);
+            if (lanes)
+                cast_packet_through_subtree (child, packet, lanes, nearest, max_t);
+        }
+    }
+
+    static std::array<distance_type, 3> cube_min (const node_type &node)
+    {
+        auto &center = node.center();
+        auto halfwidth = node.halfwidth();
+
+        return {center.x() - halfwidth, center.y() - halfwidth, center.z() - halfwidth};
+    }
+
+    static std::array<distance_type, 3> cube_max (const node_type &node)
+    {
+        auto &center = node.center();
+        auto halfwidth = node.halfwidth();
+
+        return {center.x() + halfwidth, center.y() + halfwidth, center.z() + halfwidth};
+    }
+
+    bool is_in_root (const shape_type &shape) const
+    {
+        auto min = cube_min (root());
+        auto max = cube_max (root());
+
+        for (auto i = 0; i != 3; ++i)
+            if (cmp::less (shape.left_bound (i), min[i])
+                || cmp::greater (shape.right_bound (i), max[i]))
+                return false;
+
+        return true;
+    }
+
+    // Rebuilds the tree in a cube twice as wide as the one bounding both the current root
+    // and the shape, so that repeated growth is amortised
+    void grow_root (const shape_type &shape)
+    {
+        auto min = cube_min (root());
+        auto max = cube_max (root());
+
+        auto min_elem = *std::min_element (min.begin(), min.end());
+        auto max_elem = *std::max_element (max.begin(), max.end());
+
+        for (auto i = 0; i != 3; ++i)
+        {
+            min_elem = std::min (min_elem, shape.left_bound (i));
+            max_elem = std::max (max_elem, shape.right_bound (i));
+        }
+
+        distance_type pt_coord = std::midpoint (min_elem, max_elem);
+        distance_type halfwidth = max_elem - min_elem;
+
+        std::vector<slot_type> slots;
+        for (auto &node : nodes_)
+            slots.insert (slots.end(), node.shapes().begin(), node.shapes().end());
+
+        height_ = std::min (max_height(), pseudo_optimal_height (slots.size() + 1));
+
+        nodes_.clear();
+        nodes_.reserve (max_size());
+        build_subtree (Point_3D{pt_coord, pt_coord, pt_coord}, halfwidth, height_);
+
+        for (auto slot : slots)
+            detail::target_node (std::addressof (root()), store_[slot])->add_shape (slot);
+
+        group_shapes_by_nodes ();
+    }
+
+    // Shapes of every node get consecutive slots, so that the bounds of shapes of a node
+    // are read sequentially
+    void group_shapes_by_nodes ()
+    {
+        std::vector<slot_type> order;
+        order.reserve (store_.size());
+
+        for (auto &node : nodes_)
+        {
+            for (auto &slot : node.shapes())
+            {
+                auto new_slot = static_cast<slot_type>(order.size());
+                order.push_back (slot);
+                slot = new_slot;
+            }
+        }
+
+        store_.reorder (order);
+    }
+
+    // The slot of the shape with the same index as the given one or no_slot_
+    slot_type find_slot (const node_type &node, const shape_type &shape) const
+    {
+        auto &slots = node.shapes();
+        auto it = std::find_if (slots.begin(), slots.end(), [this, &shape](slot_type slot)
+        {
+            return store_.index (slot) == shape.index();
+        });
+
+        return (it == slots.end()) ? no_slot_ : *it;
+    }
+
+    template<typename F>
+    void for_each_candidate_in_node (const std::vector<const node_type *> &path, F &visit) const
+    {
+        auto node = path.back();
+
+        for (auto ancestor_it = path.rbegin(); ancestor_it != path.rend(); ++ancestor_it)
+        {
+            auto ancestor = *ancestor_it;
+
+            for (auto slot_1 : ancestor->shapes())
+            {
+                for (auto slot_2 : node->shapes())
+                {
+                    if (slot_1 == slot_2)
+                        break;
+
+                    if (store_.are_overlapping (slot_1, slot_2))
+                        visit (store_[slot_1], store_[slot_2]);
+                }
+            }
+        }
+    }
+
+    template<typename F>
+    void for_each_candidate_in_subtree (std::vector<const node_type *> &ancestor_stack,
+                                        F &visit) const
+    {
+        auto root = ancestor_stack.back();
+
+        for (auto i = 0; i != 8; ++i)
+        {
+            if (root->child(i))
+            {
+                ancestor_stack.emplace_back (root->child(i));
+                for_each_candidate_in_subtree (ancestor_stack, visit);
+                ancestor_stack.pop_back();
+            }
+        }
+
+        for_each_candidate_in_node (ancestor_stack, visit);
+    }
+
     static std::size_t pseudo_optimal_height (std::size_t n_shapes)
     {
         return std::max (std::size_t{1}, static_cast<std::size_t>(std::log10 (1 + n_shapes)));
@@ -137,9 +977,9 @@ private:
             distance_type step = halfwidth * 0.5;
             for (int i = 0; i != 8; ++i)
             {
-                point_type new_center{center.x() + (i & 1) ? step : -step,
-                                      center.y() + (i & 2) ? step : -step,
-                                      center.z() + (i & 4) ? step : -step};
+                point_type new_center{center.x() + ((i & 1) ? step : -step),
+                                      center.y() + ((i & 2) ? step : -step),
+                                      center.z() + ((i & 4) ? step : -step)};
 
                 subroot.child (i) = build_subtree (new_center, step, stop_depth - 1);
             }
@@ -0,0 +1,347 @@
+#ifndef INCLUDE_SPACE_PARTITIONING_OCTREE_SNAPSHOT_HPP
+#define INCLUDE_SPACE_PARTITIONING_OCTREE_SNAPSHOT_HPP
+
+#include <vector>
+#include <array>
+#include <span>
+#include <string>
+#include <fstream>
+#include <stdexcept>
+#include <limits>
+#include <bit>
+#include <concepts>
+#include <type_traits>
+#include <cstdint>
+#include <cstddef>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "shape.hpp"
+#include "shape_record.hpp"
+#include "linear_octree.hpp"
+
+namespace yLab
+{
+
+namespace geometry
+{
+
+struct Invalid_Snapshot final: public std::runtime_error
+{
+    Invalid_Snapshot (const std::string &reason)
+                     : std::runtime_error{"Invalid octree snapshot: " + reason} {}
+};
+
+// Identity of the scene file a snapshot was built from
+struct Scene_Stamp final
+{
+    std::uint64_t size = 0;
+    std::int64_t mtime = 0; // nanoseconds
+
+    // Stamp of an open regular file; throws Invalid_Snapshot for pipes, terminals, etc.
+    static Scene_Stamp of (int fd)
+    {
+        struct stat info;
+        if (fstat (fd, &info) != 0 || !S_ISREG (info.st_mode))
+            throw Invalid_Snapshot{"the scene has to be a regular file"};
+
+        return Scene_Stamp{static_cast<std::uint64_t>(info.st_size),
+                           static_cast<std::int64_t>(info.st_mtim.tv_sec) * 1'000'000'000 +
+                           info.st_mtim.tv_nsec};
+    }
+
+    bool operator== (const Scene_Stamp &) const = default;
+};
+
+/*
+ * Linear octree saved to disk: a header, an array of nodes and an array of Shape_Record,
+ * every array aligned to 64 bytes. The file is mapped read-only and view () traverses both
+ * arrays in place, so neither parsing nor tree building is needed. Loading rejects files
+ * of other versions, of other distance types or platforms, files built from another scene
+ * and files whose nodes refer outside the arrays. Records aren't read while loading, so that
+ * it doesn't touch every page of a large file: verify () checks them before they are trusted.
+ */
+template<typename T>
+class Octree_Snapshot final
+{
+public:
+
+    using distance_type = T;
+    using record_type = Shape_Record<distance_type>;
+    using node_type = Linear_Octree_Node;
+    using view_type = Linear_Octree_View<distance_type, record_type>;
+    using size_type = std::size_t;
+
+    static constexpr std::uint32_t version = 2;
+
+    struct Header final
+    {
+        std::array<char, 8> magic;
+        std::uint32_t version;
+        std::uint32_t byte_order;
+        std::uint32_t distance_size;
+        std::uint32_t node_size;
+        std::uint32_t record_size;
+        std::uint32_t height;
+        std::uint64_t n_nodes;
+        std::uint64_t n_shapes;
+        std::uint64_t n_indexes; // the greatest index of a shape + 1
+        std::uint64_t nodes_offset;
+        std::uint64_t records_offset;
+        std::uint64_t file_size;
+        Scene_Stamp scene;
+        std::array<distance_type, 3> center;
+        distance_type halfwidth;
+    };
+
+    using header_type = Header;
+
+    static_assert (std::is_trivially_copyable_v<node_type>);
+    static_assert (std::is_trivially_copyable_v<record_type>);
+
+private:
+
+    static constexpr std::array<char, 8> magic_ = {'T', 'R', 'I', 'O', 'C', 'T', 'R', 'E'};
+    static constexpr std::uint32_t byte_order_ = 0x01020304;
+    static constexpr std::uint64_t alignment_ = 64;
+    static constexpr std::uint64_t max_n_indexes_ =
+        std::uint64_t{std::numeric_limits<typename record_type::index_type>::max()} + 1;
+
+    void *data_ = nullptr;
+    size_type size_ = 0;
+
+public:
+
+    // Shapes of the tree are saved as Shape_Record
+    template<typename U>
+    static void write (const std::string &path, const Linear_Octree<distance_type, U> &tree,
+                       size_type n_indexes, const Scene_Stamp &scene)
+    {
+        if (n_indexes > max_n_indexes_)
+            throw Invalid_Snapshot{"indexes of shapes don't fit in records"};
+
+        header_type header{};
+
+        header.magic = magic_;
+        header.version = version;
+        header.byte_order = byte_order_;
+        header.distance_size = sizeof (distance_type);
+        header.node_size = sizeof (node_type);
+        header.record_size = sizeof (record_type);
+        header.height = static_cast<std::uint32_t>(tree.height());
+        header.n_nodes = tree.size();
+        header.n_shapes = tree.shapes().size();
+        header.n_indexes = n_indexes;
+        header.nodes_offset = align (sizeof (header_type));
+        header.records_offset = align (header.nodes_offset + header.n_nodes * sizeof (node_type));
+        header.file_size = header.records_offset + header.n_shapes * sizeof (record_type);
+        header.scene = scene;
+        header.center = tree.center();
+        header.halfwidth = tree.halfwidth();
+
+        std::ofstream file{path, std::ios::binary | std::ios::trunc};
+        if (!file)
+            throw Invalid_Snapshot{"can't open " + path + " for writing"};
+
+        write_bytes (file, std::addressof (header), sizeof (header_type));
+        pad (file, header.nodes_offset);
+        write_bytes (file, tree.nodes().data(), header.n_nodes * sizeof (node_type));
+        pad (file, header.records_offset);
+
+        for (auto &shape : tree.shapes())
+        {
+            if constexpr (std::same_as<U, record_type>)
+                write_bytes (file, std::addressof (shape), sizeof (record_type));
+            else
+            {
+                record_type record{shape};
+                write_bytes (file, std::addressof (record), sizeof (record_type));
+            }
+        }
+
+        if (!file.flush())
+            throw Invalid_Snapshot{"can't write " + path};
+    }
+
+    Octree_Snapshot (const std::string &path, const Scene_Stamp &scene)
+    {
+        auto fd = open (path.c_str(), O_RDONLY);
+        if (fd < 0)
+            throw Invalid_Snapshot{"can't open " + path};
+
+        struct stat info;
+        if (fstat (fd, &info) != 0 || static_cast<size_type>(info.st_size) < sizeof (header_type))
+        {
+            close (fd);
+            throw Invalid_Snapshot{"the file is too short"};
+        }
+
+        size_ = static_cast<size_type>(info.st_size);
+        data_ = mmap (nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        close (fd);
+
+        if (data_ == MAP_FAILED)
+        {
+            data_ = nullptr;
+            throw Invalid_Snapshot{"can't map " + path};
+        }
+
+        try
+        {
+            validate (scene);
+        }
+        catch (...)
+        {
+            munmap (data_, size_);
+            throw;
+        }
+    }
+
+    Octree_Snapshot (const Octree_Snapshot &) = delete;
+    Octree_Snapshot &operator= (const Octree_Snapshot &) = delete;
+
+    ~Octree_Snapshot ()
+    {
+        if (data_)
+            munmap (data_, size_);
+    }
+
+    const header_type &header () const { return *static_cast<const header_type *>(data_); }
+
+    std::span<const node_type> nodes () const
+    {
+        return {reinterpret_cast<const node_type *>(bytes() + header().nodes_offset),
+                header().n_nodes};
+    }
+
+    std::span<const record_type> records () const
+    {
+        return {reinterpret_cast<const record_type *>(bytes() + header().records_offset),
+                header().n_shapes};
+    }
+
+    size_type n_indexes () const { return header().n_indexes; }
+
+    // Broad phase over the mapped arrays; the snapshot has to outlive it
+    view_type view () const { return view_type{nodes(), records(), header().height}; }
+
+    // Every record is a point, a segment or a triangle with a valid index and ordered bounds;
+    // reads all the records
+    void verify () const
+    {
+        using kind_type = typename record_type::Kind;
+
+        auto n_indexes = header().n_indexes;
+
+        for (auto &record : records())
+        {
+            if (record.kind() != kind_type::point && record.kind() != kind_type::segment &&
+                record.kind() != kind_type::triangle)
+                throw Invalid_Snapshot{"a record of an unknown primitive"};
+            if (record.index() >= n_indexes)
+                throw Invalid_Snapshot{"a record with an index out of range"};
+
+            for (auto i = 0u; i != 3; ++i)
+                if (!(record.left_bound (i) <= record.right_bound (i)))
+                    throw Invalid_Snapshot{"a record with wrong bounds"};
+        }
+    }
+
+private:
+
+    const char *bytes () const { return static_cast<const char *>(data_); }
+
+    void validate (const Scene_Stamp &scene) const
+    {
+        auto &h = header();
+
+        if (h.magic != magic_)
+            throw Invalid_Snapshot{"wrong magic number"};
+        if (h.version != version)
+            throw Invalid_Snapshot{"unsupported version " + std::to_string (h.version)};
+        if (h.byte_order != byte_order_ || h.distance_size != sizeof (distance_type) ||
+            h.node_size != sizeof (node_type) || h.record_size != sizeof (record_type))
+            throw Invalid_Snapshot{"the file was written for another type or platform"};
+        if (h.file_size != size_)
+            throw Invalid_Snapshot{"the file is truncated"};
+        if (h.nodes_offset < sizeof (header_type) || h.nodes_offset % alignment_ ||
+            h.records_offset % alignment_ ||
+            !fits (h.nodes_offset, h.n_nodes, sizeof (node_type)) ||
+            !fits (h.records_offset, h.n_shapes, sizeof (record_type)) ||
+            h.nodes_offset + h.n_nodes * sizeof (node_type) > h.records_offset)
+            throw Invalid_Snapshot{"the arrays don't fit in the file"};
+        if (h.height == 0 || h.height > Linear_Octree<distance_type>::max_height() ||
+            h.n_nodes == 0 || h.n_nodes > max_n_indexes_ || h.n_shapes > max_n_indexes_ ||
+            h.n_indexes > max_n_indexes_)
+            throw Invalid_Snapshot{"the file is corrupted"};
+        if (!(h.scene == scene))
+            throw Invalid_Snapshot{"the scene has changed since the snapshot was written"};
+
+        validate_nodes ();
+    }
+
+    // Whether n elements of the given size starting at offset fit in the file; can't overflow
+    bool fits (std::uint64_t offset, std::uint64_t n, std::uint64_t element_size) const
+    {
+        return offset <= size_ && n <= (size_ - offset) / element_size;
+    }
+
+    // Codes are sorted, every node lies within the height of the tree, its shapes lie within
+    // the records and its children follow it and have the codes of its children
+    void validate_nodes () const
+    {
+        auto &h = header();
+        auto nodes = this->nodes();
+
+        for (size_type node_i = 0; node_i != nodes.size(); ++node_i)
+        {
+            auto &node = nodes[node_i];
+
+            if ((node_i == 0) ? node.code != 1 : node.code <= nodes[node_i - 1].code)
+                throw Invalid_Snapshot{"nodes aren't sorted by their codes"};
+            if (node.depth() >= h.height)
+                throw Invalid_Snapshot{"a node is deeper than the tree"};
+            if (node.first_shape > h.n_shapes || node.n_shapes > h.n_shapes - node.first_shape)
+                throw Invalid_Snapshot{"shapes of a node lie outside the records"};
+
+            if (node.children == 0)
+                continue;
+
+            auto n_children = static_cast<size_type>(std::popcount (node.children));
+            if (node.first_child <= node_i || node.first_child > nodes.size() - n_children)
+                throw Invalid_Snapshot{"children of a node lie outside the nodes"};
+
+            for (auto octant = 0u; octant != 8; ++octant)
+                if ((node.children & (1u << octant)) &&
+                    nodes[node.child (octant)].code != ((node.code << 3) | octant))
+                    throw Invalid_Snapshot{"a child of a node has a wrong code"};
+        }
+    }
+
+    static std::uint64_t align (std::uint64_t offset)
+    {
+        return (offset + alignment_ - 1) / alignment_ * alignment_;
+    }
+
+    static void write_bytes (std::ofstream &file, const void *data, size_type n_bytes)
+    {
+        file.write (static_cast<const char *>(data), static_cast<std::streamsize>(n_bytes));
+    }
+
+    static void pad (std::ofstream &file, std::uint64_t offset)
+    {
+        static constexpr std::array<char, alignment_> zeros{};
+        auto position = static_cast<std::uint64_t>(file.tellp());
+        write_bytes (file, zeros.data(), offset - position);
+    }
+};
+
+} // namespace geometry
+
+} // namespace yLab
+
+#endif // INCLUDE_SPACE_PARTITIONING_OCTREE_SNAPSHOT_HPP
@@ -0,0 +1,208 @@
+#ifndef INCLUDE_SPACE_PARTITIONING_RANGE_QUERY_HPP
+#define INCLUDE_SPACE_PARTITIONING_RANGE_QUERY_HPP
+
+#include <array>
+#include <algorithm>
+#include <cmath>
+
+#include "double_comparison.hpp"
+#include "point.hpp"
+#include "segment.hpp"
+#include "triangle.hpp"
+#include "vector.hpp"
+#include "shape.hpp"
+#include "axis_aligned_bounding_box.hpp"
+
+namespace yLab
+{
+
+namespace geometry
+{
+
+// Kinds of primitives accepted by a range query; kinds combine with |
+enum class Primitive_Kinds : unsigned
+{
+    none      = 0,
+    points    = 1 << 0,
+    segments  = 1 << 1,
+    triangles = 1 << 2,
+    all       = points | segments | triangles
+};
+
+constexpr Primitive_Kinds operator| (Primitive_Kinds lhs, Primitive_Kinds rhs)
+{
+    return static_cast<Primitive_Kinds>(static_cast<unsigned>(lhs) | static_cast<unsigned>(rhs));
+}
+
+constexpr bool contains (Primitive_Kinds kinds, Primitive_Kinds kind)
+{
+    return (static_cast<unsigned>(kinds) & static_cast<unsigned>(kind)) != 0;
+}
+
+namespace detail
+{
+
+// Bounds of a query box enlarged by the tolerance of cmp, so that primitives touching the box
+// are reported
+template<typename T>
+struct Query_Box final
+{
+    std::array<T, 3> min;
+    std::array<T, 3> max;
+
+    explicit Query_Box (const AABB<T> &box)
+    {
+        for (auto i = 0u; i != 3; ++i)
+        {
+            auto low = box.center()[i] - box.halfwidth (i);
+            auto high = box.center()[i] + box.halfwidth (i);
+
+            min[i] = low - cmp::cmp_precision<T>::epsilon * (1 + std::abs (low));
+            max[i] = high + cmp::cmp_precision<T>::epsilon * (1 + std::abs (high));
+        }
+    }
+
+    bool overlaps (const std::array<T, 3> &other_min, const std::array<T, 3> &other_max) const
+    {
+        for (auto i = 0; i != 3; ++i)
+            if (other_min[i] > max[i] || other_max[i] < min[i])
+                return false;
+
+        return true;
+    }
+
+    bool contains (const std::array<T, 3> &other_min, const std::array<T, 3> &other_max) const
+    {
+        for (auto i = 0; i != 3; ++i)
+            if (other_min[i] < min[i] || other_max[i] > max[i])
+                return false;
+
+        return true;
+    }
+};
+
+template<typename T>
+constexpr Primitive_Kinds kind_of (const Point_3D<T> &) { return Primitive_Kinds::points; }
+
+template<typename T>
+constexpr Primitive_Kinds kind_of (const Segment<Point_3D<T>> &)
+{
+    return Primitive_Kinds::segments;
+}
+
+template<typename T>
+constexpr Primitive_Kinds kind_of (const Triangle<Point_3D<T>> &)
+{
+    return Primitive_Kinds::triangles;
+}
+
+template<typename T>
+bool is_in_box (const Point_3D<T> &pt, const Query_Box<T> &box)
+{
+    for (auto i = 0; i != 3; ++i)
+        if (pt[i] < box.min[i] || pt[i] > box.max[i])
+            return false;
+
+    return true;
+}
+
+// Slab test of the segment with t in [0; 1]
+template<typename T>
+bool is_in_box (const Segment<Point_3D<T>> &seg, const Query_Box<T> &box)
+{
+    T t_enter{0};
+    T t_exit{1};
+
+    for (auto i = 0; i != 3; ++i)
+    {
+        auto origin = seg.P()[i];
+        auto direction = seg.Q()[i] - origin;
+
+        if (direction == T{})
+        {
+            if (origin < box.min[i] || origin > box.max[i])
+                return false;
+            continue;
+        }
+
+        auto t_1 = (box.min[i] - origin) / direction;
+        auto t_2 = (box.max[i] - origin) / direction;
+        if (t_1 > t_2)
+            std::swap (t_1, t_2);
+
+        t_enter = std::max (t_enter, t_1);
+        t_exit = std::min (t_exit, t_2);
+
+        if (t_enter > t_exit)
+            return false;
+    }
+
+    return true;
+}
+
+// Separating axis test: the normals of the box faces, the normal of the triangle and
+// the 9 products of the box axes by the edges
+template<typename T>
+bool is_in_box (const Triangle<Point_3D<T>> &tr, const Query_Box<T> &box)
+{
+    std::array<T, 3> halfwidth;
+    Point_3D<T> center;
+
+    for (auto i = 0; i != 3; ++i)
+    {
+        halfwidth[i] = (box.max[i] - box.min[i]) / 2;
+        center[i] = (box.max[i] + box.min[i]) / 2;
+    }
+
+    std::array<Vector<T>, 3> vertices{Vector{center, tr.P()}, Vector{center, tr.Q()},
+                                      Vector{center, tr.R()}};
+
+    // Projections of the triangle and the box on the axis overlap
+    auto overlap_on = [&vertices, &halfwidth](const Vector<T> &axis)
+    {
+        auto p_0 = scalar_product (vertices[0], axis);
+        auto p_1 = scalar_product (vertices[1], axis);
+        auto p_2 = scalar_product (vertices[2], axis);
+
+        auto radius = halfwidth[0] * std::abs (axis.x_) + halfwidth[1] * std::abs (axis.y_) +
+                      halfwidth[2] * std::abs (axis.z_);
+
+        return !(std::min ({p_0, p_1, p_2}) > radius || std::max ({p_0, p_1, p_2}) < -radius);
+    };
+
+    std::array<Vector<T>, 3> axes{Vector<T>{1, 0, 0}, Vector<T>{0, 1, 0}, Vector<T>{0, 0, 1}};
+    std::array<Vector<T>, 3> edges{vertices[1] - vertices[0], vertices[2] - vertices[1],
+                                   vertices[0] - vertices[2]};
+
+    for (auto &axis : axes)
+        if (!overlap_on (axis))
+            return false;
+
+    if (!overlap_on (vector_product (edges[0], edges[1])))
+        return false;
+
+    for (auto &axis : axes)
+        for (auto &edge : edges)
+            if (!overlap_on (vector_product (axis, edge)))
+                return false;
+
+    return true;
+}
+
+// The shape (Indexed_Shape or Shape_Record) is of one of the kinds and overlaps the box
+template<typename T, typename Shape>
+bool is_shape_in_box (const Shape &shape, const Query_Box<T> &box, Primitive_Kinds kinds)
+{
+    return visit_primitive (shape, [&box, kinds](const auto &primitive)
+    {
+        return contains (kinds, kind_of (primitive)) && is_in_box (primitive, box);
+    });
+}
+
+} // namespace detail
+
+} // namespace geometry
+
+} // namespace yLab
+
+#endif // INCLUDE_SPACE_PARTITIONING_RANGE_QUERY_HPP
@@ -0,0 +1,454 @@
+#ifndef INCLUDE_SPACE_PARTITIONING_RAY_HPP
+#define INCLUDE_SPACE_PARTITIONING_RAY_HPP
+
+#include <array>
+#include <vector>
+#include <iterator>
+#include <utility>
+#include <variant>
+#include <limits>
+#include <type_traits>
+#include <stdexcept>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+
+#include "double_comparison.hpp"
+#include "vector.hpp"
+#include "primitive_traits.hpp"
+#include "shape.hpp"
+
+#include "point_point.hpp"
+#include "point_segment.hpp"
+#include "point_triangle.hpp"
+#include "segment_segment.hpp"
+#include "segment_triangle.hpp"
+
+namespace yLab
+{
+
+namespace geometry
+{
+
+struct Degenerate_Ray final: public std::runtime_error
+{
+    Degenerate_Ray () : std::runtime_error{"Direction of a ray can't be a zero vector"} {}
+};
+
+/*
+ * Points origin + t * direction with t in [0; max_t]. A segment PQ is the ray from P
+ * with direction PQ and max_t = 1, so t of a hit is the share of the segment before it.
+ */
+template<typename T>
+class Ray final
+{
+public:
+
+    using distance_type = T;
+    using point_type = typename Primitive_Traits<distance_type>::point_type;
+    using segment_type = typename Primitive_Traits<distance_type>::segment_type;
+    using vector_type = Vector<distance_type>;
+
+private:
+
+    std::array<distance_type, 3> origin_;
+    std::array<distance_type, 3> direction_;
+    std::array<distance_type, 3> inverse_direction_;
+    distance_type max_t_;
+
+public:
+
+    Ray (const point_type &origin, const vector_type &direction,
+         distance_type max_t = std::numeric_limits<distance_type>::infinity())
+        : origin_{origin.x(), origin.y(), origin.z()},
+          direction_{direction.x_, direction.y_, direction.z_}, max_t_{max_t}
+    {
+        if (direction.is_zero())
+            throw Degenerate_Ray{};
+
+        for (auto i = 0; i != 3; ++i)
+            inverse_direction_[i] = 1 / direction_[i];
+    }
+
+    explicit Ray (const segment_type &seg) : Ray{seg.P(), vector_type{seg.P(), seg.Q()}, 1} {}
+
+    point_type origin () const { return point_type{origin_[0], origin_[1], origin_[2]}; }
+    vector_type direction () const
+    {
+        return vector_type{direction_[0], direction_[1], direction_[2]};
+    }
+    distance_type max_t () const noexcept { return max_t_; }
+
+    distance_type origin (unsigned axis) const { return origin_[axis]; }
+    distance_type direction (unsigned axis) const { return direction_[axis]; }
+
+    point_type point_at (distance_type t) const
+    {
+        return point_type{origin_[0] + t * direction_[0], origin_[1] + t * direction_[1],
+                          origin_[2] + t * direction_[2]};
+    }
+
+    // Slab test: the part [t_enter; t_exit] of the ray inside the box [min; max] enlarged
+    // by the tolerance of cmp. t_enter > t_exit if the ray misses the box
+    std::pair<distance_type, distance_type> clip (const std::array<distance_type, 3> &min,
+                                                  const std::array<distance_type, 3> &max) const
+    {
+        distance_type t_enter{};
+        distance_type t_exit = max_t_;
+
+        for (auto i = 0; i != 3; ++i)
+        {
+            auto low = min[i] - tolerance (min[i]);
+            auto high = max[i] + tolerance (max[i]);
+
+            if (direction_[i] == distance_type{})
+            {
+                if (origin_[i] < low || origin_[i] > high)
+                    return {distance_type{1}, distance_type{}};
+                continue;
+            }
+
+            auto t_1 = (low - origin_[i]) * inverse_direction_[i];
+            auto t_2 = (high - origin_[i]) * inverse_direction_[i];
+            if (t_1 > t_2)
+                std::swap (t_1, t_2);
+
+            t_enter = std::max (t_enter, t_1);
+            t_exit = std::min (t_exit, t_2);
+
+            if (t_enter > t_exit)
+                break;
+        }
+
+        return {t_enter, t_exit};
+    }
+
+    // How far the slab test enlarges the bound of a box
+    static distance_type tolerance (distance_type bound)
+    {
+        return cmp::cmp_precision<distance_type>::epsilon * (1 + std::abs (bound));
+    }
+};
+
+/*
+ * Up to N coherent rays traced together (e.g. 8 or 16 rays from one sensor). Rays are stored
+ * by lanes: every coordinate of origins and directions is an array of N values, so that
+ * slab tests of all lanes are plain loops over arrays which the compiler turns into SIMD
+ * instructions. Lanes are selected by bit masks.
+ */
+template<typename T, std::size_t N>
+requires (N > 0 && N <= 32)
+class Ray_Packet final
+{
+public:
+
+    using distance_type = T;
+    using ray_type = Ray<distance_type>;
+    using mask_type = std::uint32_t;
+    using lanes_type = std::array<distance_type, N>;
+    using size_type = std::size_t;
+
+    static constexpr size_type width () noexcept { return N; }
+
+private:
+
+    std::vector<ray_type> rays_;
+    std::array<lanes_type, 3> origin_;
+    std::array<lanes_type, 3> direction_;
+    std::array<lanes_type, 3> inverse_direction_;
+    lanes_type max_t_;
+
+public:
+
+    // Takes from 1 to N rays; lanes beyond the last ray repeat it but are never active
+    template<std::input_iterator it>
+    Ray_Packet (it first, it last) : rays_(first, last)
+    {
+        if (rays_.empty() || rays_.size() > N)
+            throw std::invalid_argument{"A ray packet holds from 1 to N rays"};
+
+        for (size_type lane = 0; lane != N; ++lane)
+        {
+            auto &ray = rays_[std::min (lane, rays_.size() - 1)];
+
+            for (auto i = 0u; i != 3; ++i)
+            {
+                origin_[i][lane] = ray.origin (i);
+                direction_[i][lane] = ray.direction (i);
+                inverse_direction_[i][lane] = 1 / ray.direction (i);
+            }
+
+            max_t_[lane] = ray.max_t();
+        }
+    }
+
+    size_type size () const noexcept { return rays_.size(); }
+    const ray_type &ray (size_type lane) const { return rays_[lane]; }
+
+    mask_type lanes () const noexcept
+    {
+        return (size() == 32) ? ~mask_type{} : (mask_type{1} << size()) - 1;
+    }
+
+    const lanes_type &max_t () const noexcept { return max_t_; }
+    const lanes_type &origin (unsigned axis) const { return origin_[axis]; }
+    const lanes_type &direction (unsigned axis) const { return direction_[axis]; }
+
+    // Slab test of all lanes against the box [min; max] enlarged by the tolerance of cmp.
+    // Lanes are clipped by max_t; returns active lanes that cross the box
+    mask_type clip (const std::array<distance_type, 3> &min,
+                    const std::array<distance_type, 3> &max, const lanes_type &max_t,
+                    mask_type active, lanes_type &t_enter, lanes_type &t_exit) const
+    {
+        t_enter.fill (distance_type{});
+        t_exit = max_t;
+
+        for (auto i = 0; i != 3; ++i)
+        {
+            auto low = min[i] - ray_type::tolerance (min[i]);
+            auto high = max[i] + ray_type::tolerance (max[i]);
+
+            // A NaN of a zero direction with the origin on the plane of a slab doesn't clip
+            for (size_type lane = 0; lane != N; ++lane)
+            {
+                auto t_1 = (low - origin_[i][lane]) * inverse_direction_[i][lane];
+                auto t_2 = (high - origin_[i][lane]) * inverse_direction_[i][lane];
+
+                t_enter[lane] = std::max (t_enter[lane], std::min (t_1, t_2));
+                t_exit[lane] = std::min (t_exit[lane], std::max (t_1, t_2));
+            }
+        }
+
+        mask_type crossing = 0;
+        for (size_type lane = 0; lane != N; ++lane)
+            crossing |= mask_type{t_enter[lane] <= t_exit[lane]} << lane;
+
+        return crossing & active;
+    }
+};
+
+template<typename T>
+struct Ray_Hit final
+{
+    std::size_t index; // of the shape hit
+    T t;               // parameter of the first point of the shape on the ray
+};
+
+namespace detail
+{
+
+template<typename T>
+T projection (const Ray<T> &ray, const Point_3D<T> &pt)
+{
+    auto direction = ray.direction();
+    return scalar_product (Vector<T>{ray.origin(), pt}, direction) /
+           scalar_product (direction, direction);
+}
+
+template<typename T>
+T hit_parameter (const Ray<T> &ray, const Point_3D<T> &pt, T, T)
+{
+    return projection (ray, pt);
+}
+
+// The closest approach of the lines; the nearest end if the segment is parallel to the ray
+template<typename T>
+T hit_parameter (const Ray<T> &ray, const Segment<Point_3D<T>> &seg, T t_enter, T)
+{
+    auto d = ray.direction();
+    Vector<T> e{seg.P(), seg.Q()};
+    Vector<T> w{seg.P(), ray.origin()};
+
+    auto dd = scalar_product (d, d);
+    auto de = scalar_product (d, e);
+    auto ee = scalar_product (e, e);
+    auto denominator = dd * ee - de * de;
+
+    if (cmp::is_zero (denominator / (dd * ee)))
+        return std::max (t_enter, std::min (projection (ray, seg.P()), projection (ray, seg.Q())));
+
+    return (de * scalar_product (e, w) - ee * scalar_product (d, w)) / denominator;
+}
+
+// The point on the plane of the triangle; if the ray lies in the plane, the ray is clipped
+// by the half-planes of the edges
+template<typename T>
+T hit_parameter (const Ray<T> &ray, const Triangle<Point_3D<T>> &tr, T t_enter, T)
+{
+    auto d = ray.direction();
+    auto n = tr.norm();
+    auto nd = scalar_product (n, d);
+
+    if (!cmp::is_zero (nd * nd / (scalar_product (n, n) * scalar_product (d, d))))
+        return scalar_product (n, Vector<T>{ray.origin(), tr.P()}) / nd;
+
+    std::array<Point_3D<T>, 3> vertices{tr.P(), tr.Q(), tr.R()};
+
+    for (auto i = 0; i != 3; ++i)
+    {
+        auto &A = vertices[i];
+        auto &B = vertices[(i + 1) % 3];
+        auto &C = vertices[(i + 2) % 3];
+
+        auto inward = vector_product (n, Vector<T>{A, B});
+        if (scalar_product (inward, Vector<T>{A, C}) < 0)
+            inward = -inward;
+
+        // scalar_product (inward, origin + t * d - A) >= 0
+        auto rate = scalar_product (inward, d);
+        if (rate > 0)
+        {
+            auto t = scalar_product (inward, Vector<T>{ray.origin(), A}) / rate;
+            t_enter = std::max (t_enter, t);
+        }
+    }
+
+    return t_enter;
+}
+
+// Returns true and sets t if the part [t_enter; t_exit] of the ray intersects the primitive
+template<typename T, typename Primitive>
+bool hit (const Ray<T> &ray, const Primitive &primitive, T t_enter, T t_exit, T &t)
+{
+    auto P = ray.point_at (t_enter);
+    auto Q = ray.point_at (t_exit);
+
+    auto is_hit = (P == Q) ? are_intersecting (P, primitive)
+                           : are_intersecting (Segment<Point_3D<T>>{P, Q}, primitive);
+    if (!is_hit)
+        return false;
+
+    t = std::clamp (hit_parameter (ray, primitive, t_enter, t_exit), t_enter, t_exit);
+    return true;
+}
+
+// The same for a shape: Indexed_Shape or Shape_Record
+template<typename T, typename Shape>
+bool hit_shape (const Ray<T> &ray, const Shape &shape, T t_enter, T t_exit, T &t)
+{
+    return visit_primitive (shape, [&](const auto &primitive)
+    {
+        return hit (ray, primitive, t_enter, t_exit, t);
+    });
+}
+
+/*
+ * are_intersecting (segment, triangle) of segment_triangle.hpp for all lanes at once:
+ * the segments are the parts [t_enter; t_exit] of the rays. Lanes the classification of
+ * which needs the 2D test (the segment lies in the plane of the triangle) or is close to
+ * degenerate are left to the scalar test. Returns the mask of lanes hitting the triangle
+ * and sets their t.
+ */
+template<typename T, std::size_t N>
+typename Ray_Packet<T, N>::mask_type
+hit_triangle (const Ray_Packet<T, N> &packet, const Triangle<Point_3D<T>> &tr,
+              typename Ray_Packet<T, N>::mask_type lanes,
+              const std::array<T, N> &t_enter, const std::array<T, N> &t_exit, std::array<T, N> &t)
+{
+    using mask_type = typename Ray_Packet<T, N>::mask_type;
+    constexpr auto epsilon = cmp::cmp_precision<T>::epsilon;
+
+    using point_type = std::array<T, 3>;
+
+    point_type A{tr.P().x(), tr.P().y(), tr.P().z()};
+    point_type B{tr.Q().x(), tr.Q().y(), tr.Q().z()};
+    point_type C{tr.R().x(), tr.R().y(), tr.R().z()};
+    auto n = tr.norm();
+    auto nn = scalar_product (n, n);
+
+    std::array<bool, N> is_hit;
+    std::array<bool, N> is_ambiguous;
+
+    for (std::size_t lane = 0; lane != N; ++lane)
+    {
+        point_type O, d, P, Q;
+        for (auto i = 0u; i != 3; ++i)
+        {
+            O[i] = packet.origin (i)[lane];
+            d[i] = packet.direction (i)[lane];
+            P[i] = O[i] + t_enter[lane] * d[i];
+            Q[i] = O[i] + t_exit[lane] * d[i];
+        }
+
+        auto p = triple_product (A, B, C, P);
+        auto q = triple_product (A, B, C, Q);
+
+        auto p_loc = (std::abs (p) < epsilon) ? 0 : (p > 0 ? 1 : -1);
+        auto q_loc = (std::abs (q) < epsilon) ? 0 : (q > 0 ? 1 : -1);
+
+        // The end below the plane goes second
+        if (q_loc != -1)
+            std::swap (P, Q);
+
+        auto o_1 = triple_product (P, A, B, Q);
+        auto o_2 = triple_product (P, B, C, Q);
+        auto o_3 = triple_product (P, C, A, Q);
+
+        auto nd = n.x_ * d[0] + n.y_ * d[1] + n.z_ * d[2];
+        auto dd = d[0] * d[0] + d[1] * d[1] + d[2] * d[2];
+
+        is_hit[lane] = (p_loc != q_loc) && o_1 < epsilon && o_2 < epsilon && o_3 < epsilon;
+        is_ambiguous[lane] = (p_loc == 0 && q_loc == 0) || std::abs (nd * nd / (nn * dd)) < epsilon;
+
+        auto t_plane = (n.x_ * (A[0] - O[0]) + n.y_ * (A[1] - O[1]) + n.z_ * (A[2] - O[2])) / nd;
+        t[lane] = std::clamp (t_plane, t_enter[lane], std::max (t_enter[lane], t_exit[lane]));
+    }
+
+    mask_type hits = 0;
+
+    for (std::size_t lane = 0; lane != N; ++lane)
+    {
+        auto bit = mask_type{1} << lane;
+        if (!(lanes & bit))
+            continue;
+
+        auto &ray = packet.ray (lane);
+
+        if (is_ambiguous[lane] || ray.point_at (t_enter[lane]) == ray.point_at (t_exit[lane]))
+        {
+            if (hit (ray, tr, t_enter[lane], t_exit[lane], t[lane]))
+                hits |= bit;
+        }
+        else if (is_hit[lane])
+            hits |= bit;
+    }
+
+    return hits;
+}
+
+// The same for a shape; lanes of points and segments are tested one by one
+template<typename T, std::size_t N, typename Shape>
+typename Ray_Packet<T, N>::mask_type
+hit_shape (const Ray_Packet<T, N> &packet, const Shape &shape,
+           typename Ray_Packet<T, N>::mask_type lanes,
+           const std::array<T, N> &t_enter, const std::array<T, N> &t_exit, std::array<T, N> &t)
+{
+    using mask_type = typename Ray_Packet<T, N>::mask_type;
+
+    return visit_primitive (shape, [&](const auto &primitive) -> mask_type
+    {
+        if constexpr (std::is_same_v<std::remove_cvref_t<decltype (primitive)>,
+                                     Triangle<Point_3D<T>>>)
+            return hit_triangle (packet, primitive, lanes, t_enter, t_exit, t);
+        else
+        {
+            mask_type hits = 0;
+
+            for (std::size_t lane = 0; lane != N; ++lane)
+                if ((lanes & (mask_type{1} << lane)) &&
+                    hit (packet.ray (lane), primitive, t_enter[lane], t_exit[lane], t[lane]))
+                    hits |= mask_type{1} << lane;
+
+            return hits;
+        }
+    });
+}
+
+} // namespace detail
+
+} // namespace geometry
+
+} // namespace yLab
+
+#endif // INCLUDE_SPACE_PARTITIONING_RAY_HPP
@@ -8,6 +8,7 @@
 #include "triangle.hpp"
 #include "primitive_traits.hpp"
 #include "axis_aligned_bounding_box.hpp"
+#include "magic_product.hpp"
 
 namespace yLab
 {
@@ -41,8 +42,6 @@ public:
     template<typename primitive_type>
     Shape (const primitive_type &pr) : primitive_{pr}, aabb_{pr.begin(), pr.end()} {}
 
-    virtual ~Shape () = default;
-
     const primitive_variant &primitive () const { return primitive_; }
     primitive_variant &primitive () { return primitive_; }
 
@@ -81,17 +80,43 @@ public:
     index_type index () const noexcept { return index_; }
 };
 
+namespace detail
+{
+
+// Calls f with the primitive of a shape: Indexed_Shape or Shape_Record
+template<typename Shape, typename F>
+decltype (auto) visit_primitive (const Shape &shape, F f)
+{
+    if constexpr (requires { shape.visit (f); })
+        return shape.visit (f);
+    else
+        return std::visit (f, shape.primitive());
+}
+
+} // namespace detail
+
+// Narrow phase only: bounding volumes are supposed to be checked by the caller
+template<Orientation_Predicates Policy = Tolerant_Predicates, typename T>
+bool are_primitives_intersecting (const Shape<T> &shape_1, const Shape<T> &shape_2)
+{
+    return std::visit ([](auto &primitive_1, auto &primitive_2)
+                       {
+                           return are_intersecting<Policy> (primitive_1, primitive_2);
+                       },
+                       shape_1.primitive(), shape_2.primitive());
+}
+
 template<typename T>
+bool are_overlapping (const Shape<T> &shape_1, const Shape<T> &shape_2)
+{
+    return are_overlapping (shape_1.bounding_volume(), shape_2.bounding_volume());
+}
+
+template<Orientation_Predicates Policy = Tolerant_Predicates, typename T>
 bool are_intersecting (const Shape<T> &shape_1, const Shape<T> &shape_2)
 {
-    if (are_overlapping (shape_1.bounding_volume(), shape_2.bounding_volume()))
-    {
-        return std::visit ([](auto &primitive_1, auto &primitive_2)
-                           {
-                               return are_intersecting (primitive_1, primitive_2);
-                           },
-                           shape_1.primitive(), shape_2.primitive());
-    }
+    if (are_overlapping (shape_1, shape_2))
+        return are_primitives_intersecting<Policy> (shape_1, shape_2);
     else
         return false;
 }
@@ -0,0 +1,275 @@
+#ifndef INCLUDE_SPACE_PARTITIONING_SHAPE_STORE_HPP
+#define INCLUDE_SPACE_PARTITIONING_SHAPE_STORE_HPP
+
+#include <vector>
+#include <array>
+#include <utility>
+#include <type_traits>
+#include <cstdint>
+#include <cstddef>
+
+#include "double_comparison.hpp"
+#include "point.hpp"
+#include "segment.hpp"
+#include "triangle.hpp"
+#include "primitive_traits.hpp"
+#include "shape.hpp"
+
+namespace yLab
+{
+
+namespace geometry
+{
+
+/*
+ * Shapes of a tree kept once in structure-of-arrays form and addressed by 32-bit slots, so
+ * that nodes only store slots. Every coordinate of every vertex, the minima and the maxima
+ * along every axis, the indexes and the kinds of primitives are separate arrays: the broad
+ * phase rejects most candidates by the bounds without touching the rest. Points and segments
+ * repeat their last vertex. A shape is built from the arrays when it's needed, so operator[]
+ * returns it by value. Slots of erased shapes are reused by the following insertions.
+ */
+template<typename T, typename U = Indexed_Shape<T>>
+class Shape_Store final
+{
+public:
+
+    using distance_type = T;
+    using shape_type = U;
+    using point_type = typename Primitive_Traits<distance_type>::point_type;
+    using segment_type = typename Primitive_Traits<distance_type>::segment_type;
+    using triangle_type = typename Primitive_Traits<distance_type>::triangle_type;
+    using index_type = std::remove_cvref_t<decltype (std::declval<const U &>().index())>;
+    using size_type = std::size_t;
+    using slot_type = std::uint32_t;
+
+    enum class Kind : std::uint8_t { point, segment, triangle };
+
+    // Bytes of the arrays taken by a shape
+    static constexpr size_type shape_size () noexcept
+    {
+        return (9 + 6) * sizeof (distance_type) + sizeof (index_type) + sizeof (Kind);
+    }
+
+private:
+
+    std::array<std::vector<distance_type>, 9> vertices_; // axis of vertex i at 3 * i + axis
+    std::array<std::vector<distance_type>, 3> min_;
+    std::array<std::vector<distance_type>, 3> max_;
+    std::vector<index_type> indexes_;
+    std::vector<Kind> kinds_;
+    std::vector<slot_type> free_slots_;
+
+public:
+
+    Shape_Store () = default;
+
+    void reserve (size_type n_shapes)
+    {
+        for (auto &coordinates : vertices_)
+            coordinates.reserve (n_shapes);
+
+        for (auto i = 0; i != 3; ++i)
+        {
+            min_[i].reserve (n_shapes);
+            max_[i].reserve (n_shapes);
+        }
+
+        indexes_.reserve (n_shapes);
+        kinds_.reserve (n_shapes);
+    }
+
+    // The number of slots including the free ones
+    size_type size () const noexcept { return indexes_.size(); }
+
+    // Bytes taken by the shapes of all slots
+    size_type footprint () const noexcept { return size() * shape_size(); }
+
+    shape_type operator[] (slot_type slot) const
+    {
+        return visit (slot, [index = indexes_[slot]](const auto &primitive)
+        {
+            return shape_type (primitive, index);
+        });
+    }
+
+    index_type index (slot_type slot) const { return indexes_[slot]; }
+
+    // Calls f with the primitive of the shape
+    template<typename F>
+    decltype (auto) visit (slot_type slot, F f) const
+    {
+        switch (kinds_[slot])
+        {
+            case Kind::point:
+                return f (vertex (slot, 0));
+            case Kind::segment:
+                return f (segment_type{vertex (slot, 0), vertex (slot, 1)});
+            default:
+                return f (triangle_type{vertex (slot, 0), vertex (slot, 1), vertex (slot, 2)});
+        }
+    }
+
+    distance_type min (slot_type slot, unsigned axis) const { return min_[axis][slot]; }
+    distance_type max (slot_type slot, unsigned axis) const { return max_[axis][slot]; }
+
+    std::array<distance_type, 3> min (slot_type slot) const
+    {
+        return {min_[0][slot], min_[1][slot], min_[2][slot]};
+    }
+
+    std::array<distance_type, 3> max (slot_type slot) const
+    {
+        return {max_[0][slot], max_[1][slot], max_[2][slot]};
+    }
+
+    slot_type insert (const shape_type &shape)
+    {
+        if (free_slots_.empty())
+        {
+            for (auto &coordinates : vertices_)
+                coordinates.emplace_back();
+
+            for (auto i = 0; i != 3; ++i)
+            {
+                min_[i].emplace_back();
+                max_[i].emplace_back();
+            }
+
+            indexes_.emplace_back();
+            kinds_.emplace_back();
+
+            auto slot = static_cast<slot_type>(size() - 1);
+            replace (slot, shape);
+
+            return slot;
+        }
+
+        auto slot = free_slots_.back();
+        free_slots_.pop_back();
+        replace (slot, shape);
+
+        return slot;
+    }
+
+    void replace (slot_type slot, const shape_type &shape)
+    {
+        detail::visit_primitive (shape, [this, slot](const auto &primitive)
+        {
+            set_primitive (slot, primitive);
+        });
+
+        for (auto i = 0; i != 3; ++i)
+        {
+            min_[i][slot] = shape.left_bound (i);
+            max_[i][slot] = shape.right_bound (i);
+        }
+
+        indexes_[slot] = shape.index();
+    }
+
+    // The shape stays in the store until the slot is reused
+    void erase (slot_type slot) { free_slots_.push_back (slot); }
+
+    // The shape in slot order[i] moves to slot i; free slots that aren't mentioned are dropped
+    void reorder (const std::vector<slot_type> &order)
+    {
+        auto gather = [&order](auto &array)
+        {
+            std::remove_cvref_t<decltype (array)> reordered;
+            reordered.reserve (order.size());
+
+            for (auto slot : order)
+                reordered.push_back (array[slot]);
+
+            array = std::move (reordered);
+        };
+
+        for (auto &coordinates : vertices_)
+            gather (coordinates);
+
+        for (auto i = 0; i != 3; ++i)
+        {
+            gather (min_[i]);
+            gather (max_[i]);
+        }
+
+        gather (indexes_);
+        gather (kinds_);
+        free_slots_.clear();
+    }
+
+    // Conservative: boxes closer than the tolerance of cmp are considered overlapping
+    bool are_overlapping (slot_type slot_1, slot_type slot_2) const
+    {
+        for (auto i = 0; i != 3; ++i)
+        {
+            if (cmp::greater (min_[i][slot_1], max_[i][slot_2]) ||
+                cmp::greater (min_[i][slot_2], max_[i][slot_1]))
+                return false;
+        }
+
+        return true;
+    }
+
+    // The same for a shape of another store
+    template<typename Store>
+    bool are_overlapping (slot_type slot, const Store &other, slot_type other_slot) const
+    {
+        for (auto i = 0u; i != 3; ++i)
+        {
+            if (cmp::greater (min_[i][slot], other.max (other_slot, i)) ||
+                cmp::greater (other.min (other_slot, i), max_[i][slot]))
+                return false;
+        }
+
+        return true;
+    }
+
+private:
+
+    point_type vertex (slot_type slot, unsigned i) const
+    {
+        return point_type{vertices_[3 * i][slot], vertices_[3 * i + 1][slot],
+                          vertices_[3 * i + 2][slot]};
+    }
+
+    void set_vertex (slot_type slot, unsigned i, const point_type &P)
+    {
+        vertices_[3 * i][slot] = P.x();
+        vertices_[3 * i + 1][slot] = P.y();
+        vertices_[3 * i + 2][slot] = P.z();
+    }
+
+    void set_primitive (slot_type slot, const point_type &P)
+    {
+        for (auto i = 0u; i != 3; ++i)
+            set_vertex (slot, i, P);
+
+        kinds_[slot] = Kind::point;
+    }
+
+    void set_primitive (slot_type slot, const segment_type &seg)
+    {
+        set_vertex (slot, 0, seg.P());
+        set_vertex (slot, 1, seg.Q());
+        set_vertex (slot, 2, seg.Q());
+
+        kinds_[slot] = Kind::segment;
+    }
+
+    void set_primitive (slot_type slot, const triangle_type &tr)
+    {
+        set_vertex (slot, 0, tr.P());
+        set_vertex (slot, 1, tr.Q());
+        set_vertex (slot, 2, tr.R());
+
+        kinds_[slot] = Kind::triangle;
+    }
+};
+
+} // namespace geometry
+
+} // namespace yLab
+
+#endif // INCLUDE_SPACE_PARTITIONING_SHAPE_STORE_HPP
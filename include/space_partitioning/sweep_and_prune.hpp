@@ -0,0 +1,181 @@
+#ifndef INCLUDE_SPACE_PARTITIONING_SWEEP_AND_PRUNE_HPP
+#define INCLUDE_SPACE_PARTITIONING_SWEEP_AND_PRUNE_HPP
+
+#include <vector>
+#include <array>
+#include <iterator>
+#include <algorithm>
+#include <numeric>
+#include <cstddef>
+
+#include "double_comparison.hpp"
+#include "shape.hpp"
+
+namespace yLab
+{
+
+namespace geometry
+{
+
+/*
+ * Sort-and-sweep broad phase. Shapes are sorted by the left bound of their bounding boxes
+ * along the axis the centres of the boxes vary the most. A shape may only intersect
+ * the following shapes whose left bounds don't exceed its right bound.
+ */
+template<typename T, typename U = Indexed_Shape<T>>
+class Sweep_And_Prune final
+{
+public:
+
+    using distance_type = T;
+    using shape_type = U;
+    using size_type = std::size_t;
+
+    // Shapes with positions in [first; last) in the sorted sequence are swept
+    struct Task final
+    {
+        size_type first;
+        size_type last;
+    };
+
+    using task_type = Task;
+
+private:
+
+    struct Bounds final
+    {
+        std::array<distance_type, 3> min;
+        std::array<distance_type, 3> max;
+    };
+
+    std::vector<shape_type> shapes_;
+    std::vector<Bounds> bounds_;
+    unsigned axis_;
+
+public:
+
+    template<std::forward_iterator it>
+    Sweep_And_Prune (it first, it last) : axis_{sweep_axis (first, last)}
+    {
+        std::vector<shape_type> shapes (first, last);
+
+        std::vector<size_type> order (shapes.size());
+        std::iota (order.begin(), order.end(), size_type{0});
+
+        std::vector<Bounds> bounds;
+        bounds.reserve (order.size());
+        for (auto &shape : shapes)
+        {
+            bounds.push_back (Bounds{{shape.left_bound (0), shape.left_bound (1),
+                                      shape.left_bound (2)},
+                                     {shape.right_bound (0), shape.right_bound (1),
+                                      shape.right_bound (2)}});
+        }
+
+        std::sort (order.begin(), order.end(), [&bounds, axis = axis_](size_type lhs, size_type rhs)
+        {
+            return bounds[lhs].min[axis] < bounds[rhs].min[axis];
+        });
+
+        shapes_.reserve (order.size());
+        bounds_.reserve (order.size());
+
+        for (auto i : order)
+        {
+            shapes_.push_back (shapes[i]);
+            bounds_.push_back (bounds[i]);
+        }
+    }
+
+    size_type size () const noexcept { return shapes_.size(); }
+    unsigned axis () const noexcept { return axis_; }
+
+    // Broad phase
+
+    std::vector<task_type> split (size_type min_n_tasks) const
+    {
+        min_n_tasks = std::clamp (min_n_tasks, size_type{1}, std::max (size(), size_type{1}));
+
+        std::vector<task_type> tasks;
+        tasks.reserve (min_n_tasks);
+
+        for (size_type i = 0; i != min_n_tasks; ++i)
+            tasks.push_back (task_type{size() * i / min_n_tasks, size() * (i + 1) / min_n_tasks});
+
+        return tasks;
+    }
+
+    template<typename F>
+    void for_each_candidate (F &visit) const { for_each_candidate (task_type{0, size()}, visit); }
+
+    template<typename F>
+    void for_each_candidate (const task_type &task, F &visit) const
+    {
+        auto other_1 = (axis_ + 1) % 3;
+        auto other_2 = (axis_ + 2) % 3;
+
+        for (auto i = task.first; i != task.last; ++i)
+        {
+            auto &bounds_1 = bounds_[i];
+
+            for (auto j = i + 1; j != size(); ++j)
+            {
+                auto &bounds_2 = bounds_[j];
+
+                if (!cmp::less_equal (bounds_2.min[axis_], bounds_1.max[axis_]))
+                    break;
+
+                if (are_overlapping (bounds_1, bounds_2, other_1) &&
+                    are_overlapping (bounds_1, bounds_2, other_2))
+                    visit (shapes_[i], shapes_[j]);
+            }
+        }
+    }
+
+private:
+
+    static bool are_overlapping (const Bounds &first, const Bounds &second, unsigned axis)
+    {
+        return cmp::less_equal (first.min[axis], second.max[axis]) &&
+               cmp::less_equal (second.min[axis], first.max[axis]);
+    }
+
+    template<std::forward_iterator it>
+    static unsigned sweep_axis (it first, it last)
+    {
+        std::array<distance_type, 3> sum{};
+        std::array<distance_type, 3> sum_of_squares{};
+        auto n_shapes = std::distance (first, last);
+
+        // Any axis will do for no shapes
+        if (n_shapes == 0)
+            return 0;
+
+        for (; first != last; ++first)
+        {
+            for (auto i = 0; i != 3; ++i)
+            {
+                auto center = first->bounding_volume().center()[i];
+
+                sum[i] += center;
+                sum_of_squares[i] += center * center;
+            }
+        }
+
+        std::array<distance_type, 3> variance;
+        for (auto i = 0; i != 3; ++i)
+        {
+            auto mean = sum[i] / n_shapes;
+            variance[i] = sum_of_squares[i] / n_shapes - mean * mean;
+        }
+
+        auto max_variance = std::max_element (variance.begin(), variance.end());
+        return std::distance (variance.begin(), max_variance);
+    }
+};
+
+} // namespace geometry
+
+} // namespace yLab
+
+#endif // INCLUDE_SPACE_PARTITIONING_SWEEP_AND_PRUNE_HPP
@@ -0,0 +1,440 @@
+#ifndef INCLUDE_SPACE_PARTITIONING_UNIFORM_GRID_HPP
+#define INCLUDE_SPACE_PARTITIONING_UNIFORM_GRID_HPP
+
+#include <vector>
+#include <array>
+#include <iterator>
+#include <algorithm>
+#include <limits>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+
+#include "double_comparison.hpp"
+#include "shape.hpp"
+
+namespace yLab
+{
+
+namespace geometry
+{
+
+/*
+ * Uniform grid broad phase for shapes of similar size. The edge of a cell is twice the median
+ * halfwidth of bounding boxes, so a typical shape occupies at most 8 cells. Only occupied cells
+ * are stored: an open addressing hash table maps cell coordinates to the cell, shapes of all
+ * cells lie in one array (cell i owns the range [cell_offsets_[i]; cell_offsets_[i + 1])).
+ *
+ * A pair of shapes sharing several cells is only reported by the cell that contains
+ * the minimal corner of the intersection of their bounding boxes.
+ *
+ * Shapes spanning more than max_cells_per_shape () cells (outliers much larger than the median)
+ * aren't put into cells: they're kept in a separate list and tested against all shapes.
+ */
+template<typename T, typename U = Indexed_Shape<T>>
+class Uniform_Grid final
+{
+public:
+
+    using distance_type = T;
+    using shape_type = U;
+    using size_type = std::size_t;
+    using index_type = std::uint32_t;
+    using cell_coordinates = std::array<std::int32_t, 3>;
+
+    // Cells with indexes in [first; last) are processed; indexes from n_cells () on stand for
+    // oversized shapes
+    struct Task final
+    {
+        index_type first;
+        index_type last;
+    };
+
+    using task_type = Task;
+
+private:
+
+    using key_type = std::uint64_t;
+
+    struct Box final
+    {
+        std::array<distance_type, 3> min;
+        std::array<distance_type, 3> max;
+    };
+
+    static constexpr key_type empty_key_ = std::numeric_limits<key_type>::max();
+    static constexpr unsigned bits_per_coordinate_ = 21;
+    static constexpr std::int32_t max_coordinate_ = (1 << bits_per_coordinate_) - 1;
+
+    std::vector<shape_type> shapes_;
+    std::vector<Box> boxes_;
+
+    std::array<distance_type, 3> origin_;
+    distance_type cell_size_;
+
+    std::vector<key_type> table_keys_;    // key of the cell or empty_key_
+    std::vector<index_type> table_cells_; // index of the cell with the key
+    std::vector<key_type> cell_keys_;
+    std::vector<index_type> cell_offsets_;
+    std::vector<index_type> cell_shapes_;
+
+    std::vector<index_type> oversized_; // shapes that aren't put into cells
+    std::vector<bool> is_oversized_;
+
+public:
+
+    template<std::forward_iterator it>
+    Uniform_Grid (it first, it last)
+    {
+        auto n_shapes = static_cast<size_type>(std::distance (first, last));
+
+        shapes_.reserve (n_shapes);
+        boxes_.reserve (n_shapes);
+
+        for (; first != last; ++first)
+        {
+            auto &shape = shapes_.emplace_back (*first);
+            boxes_.push_back (Box{{shape.left_bound (0), shape.left_bound (1),
+                                   shape.left_bound (2)},
+                                  {shape.right_bound (0), shape.right_bound (1),
+                                   shape.right_bound (2)}});
+        }
+
+        calculate_grid_parameters ();
+        fill_cells ();
+    }
+
+    size_type size () const noexcept { return shapes_.size(); }
+    size_type n_cells () const noexcept { return cell_keys_.size(); }
+    size_type n_oversized () const noexcept { return oversized_.size(); }
+    distance_type cell_size () const noexcept { return cell_size_; }
+
+    static constexpr size_type max_cells_per_shape () noexcept { return 64; }
+
+    // Index of the occupied cell with given coordinates or n_cells () if it's empty
+    size_type find_cell (const cell_coordinates &coordinates) const
+    {
+        auto key = make_key (coordinates);
+
+        for (auto slot = hash (key);; slot = (slot + 1) & (table_keys_.size() - 1))
+        {
+            if (table_keys_[slot] == key)
+                return table_cells_[slot];
+            if (table_keys_[slot] == empty_key_)
+                return n_cells();
+        }
+    }
+
+    // Broad phase
+
+    std::vector<task_type> split (size_type min_n_tasks) const
+    {
+        auto n_units = n_cells() + n_oversized();
+        min_n_tasks = std::clamp (min_n_tasks, size_type{1}, std::max (n_units, size_type{1}));
+
+        std::vector<task_type> tasks;
+        tasks.reserve (min_n_tasks);
+
+        for (size_type i = 0; i != min_n_tasks; ++i)
+            tasks.push_back (task_type{static_cast<index_type>(n_units * i / min_n_tasks),
+                                       static_cast<index_type>(n_units * (i + 1) / min_n_tasks)});
+
+        return tasks;
+    }
+
+    template<typename F>
+    void for_each_candidate (F &visit) const
+    {
+        for_each_candidate (task_type{0, static_cast<index_type>(n_cells() + n_oversized())},
+                            visit);
+    }
+
+    template<typename F>
+    void for_each_candidate (const task_type &task, F &visit) const
+    {
+        auto last_cell = std::min (task.last, static_cast<index_type>(n_cells()));
+
+        for (auto cell_i = task.first; cell_i < last_cell; ++cell_i)
+        {
+            auto cell = decode_key (cell_keys_[cell_i]);
+            auto first = cell_offsets_[cell_i];
+            auto last = cell_offsets_[cell_i + 1];
+
+            for (auto i = first; i != last; ++i)
+            {
+                auto shape_1 = cell_shapes_[i];
+
+                for (auto j = i + 1; j != last; ++j)
+                {
+                    auto shape_2 = cell_shapes_[j];
+
+                    if (are_overlapping (boxes_[shape_1], boxes_[shape_2]) &&
+                        reporting_cell (shape_1, shape_2) == cell)
+                        visit (shapes_[shape_1], shapes_[shape_2]);
+                }
+            }
+        }
+
+        for (auto unit = std::max (task.first, last_cell); unit < task.last; ++unit)
+            visit_oversized (oversized_[unit - n_cells()], visit);
+    }
+
+private:
+
+    // An oversized shape against all shapes but the oversized ones it has been tested with
+    template<typename F>
+    void visit_oversized (index_type shape_1, F &visit) const
+    {
+        for (index_type shape_2 = 0; shape_2 != size(); ++shape_2)
+        {
+            if (is_oversized_[shape_2] && shape_2 <= shape_1)
+                continue;
+
+            if (are_overlapping (boxes_[shape_1], boxes_[shape_2]))
+                visit (shapes_[shape_1], shapes_[shape_2]);
+        }
+    }
+
+    bool is_oversized (const Box &box) const
+    {
+        auto lower = lower_cell (box);
+        auto upper = upper_cell (box);
+
+        size_type n_cells = 1;
+        for (auto i = 0; i != 3; ++i)
+        {
+            n_cells *= static_cast<size_type>(upper[i] - lower[i]) + 1;
+            if (n_cells > max_cells_per_shape())
+                return true;
+        }
+
+        return false;
+    }
+
+    static bool are_overlapping (const Box &first, const Box &second)
+    {
+        for (auto i = 0; i != 3; ++i)
+        {
+            if (!cmp::less_equal (first.min[i], second.max[i]) ||
+                !cmp::less_equal (second.min[i], first.max[i]))
+                return false;
+        }
+
+        return true;
+    }
+
+    // Bounds are widened by the tolerance of comparisons so that touching shapes share a cell
+    static distance_type widen (distance_type bound, distance_type direction)
+    {
+        constexpr auto epsilon = cmp::cmp_precision<distance_type>::epsilon;
+        return bound + direction * epsilon * (1 + std::abs (bound));
+    }
+
+    std::int32_t coordinate (distance_type x, unsigned axis) const
+    {
+        auto cell = std::floor ((x - origin_[axis]) / cell_size_);
+        return static_cast<std::int32_t>(std::clamp (cell, distance_type{0},
+                                                     static_cast<distance_type>(max_coordinate_)));
+    }
+
+    cell_coordinates lower_cell (const Box &box) const
+    {
+        return {coordinate (widen (box.min[0], -1), 0), coordinate (widen (box.min[1], -1), 1),
+                coordinate (widen (box.min[2], -1), 2)};
+    }
+
+    cell_coordinates upper_cell (const Box &box) const
+    {
+        return {coordinate (widen (box.max[0], 1), 0), coordinate (widen (box.max[1], 1), 1),
+                coordinate (widen (box.max[2], 1), 2)};
+    }
+
+    cell_coordinates reporting_cell (index_type shape_1, index_type shape_2) const
+    {
+        auto &box_1 = boxes_[shape_1];
+        auto &box_2 = boxes_[shape_2];
+
+        auto lower_1 = lower_cell (box_1);
+        auto lower_2 = lower_cell (box_2);
+        auto upper_1 = upper_cell (box_1);
+        auto upper_2 = upper_cell (box_2);
+
+        cell_coordinates cell;
+        for (auto i = 0u; i != 3; ++i)
+        {
+            auto corner = coordinate (std::max (box_1.min[i], box_2.min[i]), i);
+            cell[i] = std::clamp (corner, std::max (lower_1[i], lower_2[i]),
+                                          std::min (upper_1[i], upper_2[i]));
+        }
+
+        return cell;
+    }
+
+    static key_type make_key (const cell_coordinates &cell)
+    {
+        return (key_type (cell[0]) << (2 * bits_per_coordinate_)) |
+               (key_type (cell[1]) << bits_per_coordinate_) | key_type (cell[2]);
+    }
+
+    static cell_coordinates decode_key (key_type key)
+    {
+        constexpr key_type mask = max_coordinate_;
+
+        return {static_cast<std::int32_t>((key >> (2 * bits_per_coordinate_)) & mask),
+                static_cast<std::int32_t>((key >> bits_per_coordinate_) & mask),
+                static_cast<std::int32_t>(key & mask)};
+    }
+
+    size_type hash (key_type key) const
+    {
+        // Fibonacci hashing
+        key *= 0x9E3779B97F4A7C15ull;
+        return static_cast<size_type>(key >> (64 - std::countr_zero (table_keys_.size())));
+    }
+
+    template<typename F>
+    void for_each_cell (const Box &box, F f) const
+    {
+        auto lower = lower_cell (box);
+        auto upper = upper_cell (box);
+
+        for (auto x = lower[0]; x <= upper[0]; ++x)
+            for (auto y = lower[1]; y <= upper[1]; ++y)
+                for (auto z = lower[2]; z <= upper[2]; ++z)
+                    f (cell_coordinates{x, y, z});
+    }
+
+    void calculate_grid_parameters ()
+    {
+        constexpr auto inf = std::numeric_limits<distance_type>::infinity();
+
+        origin_ = {inf, inf, inf};
+        auto max = std::array{-inf, -inf, -inf};
+        std::vector<distance_type> halfwidths;
+        halfwidths.reserve (size());
+
+        for (auto &box : boxes_)
+        {
+            distance_type halfwidth{};
+
+            for (auto i = 0; i != 3; ++i)
+            {
+                origin_[i] = std::min (origin_[i], widen (box.min[i], -1));
+                max[i] = std::max (max[i], box.max[i]);
+                halfwidth = std::max (halfwidth, (box.max[i] - box.min[i]) / 2);
+            }
+
+            halfwidths.push_back (halfwidth);
+        }
+
+        if (halfwidths.empty())
+        {
+            origin_ = {};
+            cell_size_ = 1;
+            return;
+        }
+
+        auto median = halfwidths.begin() + halfwidths.size() / 2;
+        std::nth_element (halfwidths.begin(), median, halfwidths.end());
+
+        // Cells mustn't be so small that their coordinates don't fit into the key
+        distance_type world_size{};
+        for (auto i = 0; i != 3; ++i)
+            world_size = std::max (world_size, max[i] - origin_[i]);
+
+        cell_size_ = std::max (2 * *median, world_size / max_coordinate_);
+        if (!(cell_size_ > distance_type{}))
+            cell_size_ = 1;
+    }
+
+    void fill_cells ()
+    {
+        // Sizes of the table and the number of cells are unknown in advance: the table grows
+        // as an ordinary open addressing hash table
+        table_keys_.assign (std::bit_ceil (std::max (2 * size(), size_type{16})), empty_key_);
+        table_cells_.assign (table_keys_.size(), 0);
+
+        std::vector<index_type> counts;
+        is_oversized_.assign (size(), false);
+
+        for (size_type shape_i = 0; shape_i != size(); ++shape_i)
+        {
+            auto &box = boxes_[shape_i];
+            if (is_oversized (box))
+            {
+                oversized_.push_back (static_cast<index_type>(shape_i));
+                is_oversized_[shape_i] = true;
+                continue;
+            }
+
+            for_each_cell (box, [&](const cell_coordinates &cell)
+            {
+                auto cell_i = find_or_insert (make_key (cell));
+                if (cell_i == counts.size())
+                    counts.push_back (0);
+
+                ++counts[cell_i];
+            });
+        }
+
+        cell_offsets_.assign (n_cells() + 1, 0);
+        for (size_type i = 0; i != n_cells(); ++i)
+            cell_offsets_[i + 1] = cell_offsets_[i] + counts[i];
+
+        cell_shapes_.resize (cell_offsets_.back());
+        std::copy (cell_offsets_.begin(), cell_offsets_.end() - 1, counts.begin());
+
+        for (size_type shape_i = 0; shape_i != size(); ++shape_i)
+        {
+            if (is_oversized_[shape_i])
+                continue;
+
+            for_each_cell (boxes_[shape_i], [&](const cell_coordinates &cell)
+            {
+                cell_shapes_[counts[find_cell (cell)]++] = static_cast<index_type>(shape_i);
+            });
+        }
+    }
+
+    index_type find_or_insert (key_type key)
+    {
+        if (2 * (n_cells() + 1) > table_keys_.size())
+            rehash (2 * table_keys_.size());
+
+        auto slot = hash (key);
+        for (; table_keys_[slot] != empty_key_; slot = (slot + 1) & (table_keys_.size() - 1))
+        {
+            if (table_keys_[slot] == key)
+                return table_cells_[slot];
+        }
+
+        table_keys_[slot] = key;
+        table_cells_[slot] = static_cast<index_type>(n_cells());
+        cell_keys_.push_back (key);
+
+        return table_cells_[slot];
+    }
+
+    void rehash (size_type capacity)
+    {
+        table_keys_.assign (capacity, empty_key_);
+        table_cells_.assign (capacity, 0);
+
+        for (size_type cell_i = 0; cell_i != n_cells(); ++cell_i)
+        {
+            auto slot = hash (cell_keys_[cell_i]);
+            while (table_keys_[slot] != empty_key_)
+                slot = (slot + 1) & (capacity - 1);
+
+            table_keys_[slot] = cell_keys_[cell_i];
+            table_cells_[slot] = static_cast<index_type>(cell_i);
+        }
+    }
+};
+
+} // namespace geometry
+
+} // namespace yLab
+
+#endif // INCLUDE_SPACE_PARTITIONING_UNIFORM_GRID_HPP
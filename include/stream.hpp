@@ -0,0 +1,134 @@
+#ifndef INCLUDE_STREAM_HPP
+#define INCLUDE_STREAM_HPP
+
+#include <atomic>
+#include <thread>
+#include <stop_token>
+#include <iterator>
+#include <utility>
+#include <cstddef>
+
+#include "mpmc_queue.hpp"
+
+namespace yLab
+{
+
+/*
+ * Lazy input range of values computed by a background thread. The producer passes values
+ * to the consumer through a bounded queue, so at most capacity values are buffered and
+ * the consumer may process them while the producer is still running. emit () waits while
+ * the queue is full and returns true once the value is queued. Destruction of the stream
+ * requests the producer to stop. emit () then returns false instead of waiting for a full
+ * queue; the value is not queued. A producer should stop once emit () returns false, and
+ * it is expected to check its stop token to leave the work it hasn't done.
+ */
+template<typename T>
+class Stream final
+{
+public:
+
+    using value_type = T;
+    using size_type = std::size_t;
+
+    class Iterator final
+    {
+    public:
+
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+
+    private:
+
+        Stream *stream_ = nullptr;
+        value_type value_{};
+        bool exhausted_ = true;
+
+    public:
+
+        Iterator () = default;
+        explicit Iterator (Stream *stream) : stream_{stream}, exhausted_{false} { ++*this; }
+
+        const value_type &operator* () const { return value_; }
+
+        Iterator &operator++ ()
+        {
+            exhausted_ = !stream_->next (value_);
+            return *this;
+        }
+
+        void operator++ (int) { ++*this; }
+
+        friend bool operator== (const Iterator &it, std::default_sentinel_t)
+        {
+            return it.exhausted_;
+        }
+    };
+
+private:
+
+    MPMC_Queue<value_type> queue_;
+    std::atomic<bool> finished_{false};
+    std::jthread producer_;
+
+public:
+
+    // produce is called on the background thread with emit (const value_type &)
+    // and std::stop_token
+    template<typename F>
+    Stream (F produce, size_type capacity) : queue_{capacity}
+    {
+        producer_ = std::jthread{[this, produce = std::move (produce)](std::stop_token stop)
+                                 mutable
+        {
+            produce ([this, stop](const value_type &value)
+            {
+                while (!queue_.try_push (value))
+                {
+                    if (stop.stop_requested())
+                        return false;
+                    std::this_thread::yield();
+                }
+
+                return true;
+            }, stop);
+
+            finished_.store (true, std::memory_order_release);
+        }};
+    }
+
+    Stream (const Stream &) = delete;
+    Stream &operator= (const Stream &) = delete;
+
+    ~Stream ()
+    {
+        producer_.request_stop();
+        producer_.join();
+    }
+
+    // The stream may only be traversed once
+    Iterator begin () { return Iterator{this}; }
+    std::default_sentinel_t end () const { return {}; }
+
+private:
+
+    bool next (value_type &value)
+    {
+        for (;;)
+        {
+            // The producer is checked before the queue so that no value pushed before
+            // it had finished is missed
+            auto finished = finished_.load (std::memory_order_acquire);
+
+            if (queue_.try_pop (value))
+                return true;
+            if (finished)
+                return false;
+
+            std::this_thread::yield();
+        }
+    }
+};
+
+} // namespace yLab
+
+#endif // INCLUDE_STREAM_HPP
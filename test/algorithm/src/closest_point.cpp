@@ -0,0 +1,42 @@
+#include <gtest/gtest.h>
+
+#include "closest_point.hpp"
+
+using namespace yLab::geometry;
+
+TEST (Distance, Point_Segment)
+{
+    Segment seg{Point_3D{0.0, 0.0, 0.0}, Point_3D{4.0, 0.0, 0.0}};
+
+    // the projection of the point lies inside the segment
+    EXPECT_EQ (closest_point (Point_3D{1.0, 3.0, 0.0}, seg), (Point_3D{1.0, 0.0, 0.0}));
+    EXPECT_DOUBLE_EQ (squared_distance (Point_3D{1.0, 3.0, 0.0}, seg), 9.0);
+
+    // the projection of the point lies beyond an end of the segment
+    EXPECT_EQ (closest_point (Point_3D{-2.0, 1.0, 0.0}, seg), (Point_3D{0.0, 0.0, 0.0}));
+    EXPECT_EQ (closest_point (Point_3D{7.0, 0.0, -4.0}, seg), (Point_3D{4.0, 0.0, 0.0}));
+    EXPECT_DOUBLE_EQ (squared_distance (Point_3D{7.0, 0.0, -4.0}, seg), 25.0);
+}
+
+TEST (Distance, Point_Triangle)
+{
+    Triangle tr{Point_3D{0.0, 0.0, 0.0}, Point_3D{4.0, 0.0, 0.0}, Point_3D{0.0, 4.0, 0.0}};
+
+    // the projection of the point lies inside the triangle
+    EXPECT_EQ (closest_point (Point_3D{1.0, 1.0, 5.0}, tr), (Point_3D{1.0, 1.0, 0.0}));
+    EXPECT_DOUBLE_EQ (squared_distance (Point_3D{1.0, 1.0, -5.0}, tr), 25.0);
+
+    // the point lies in the Voronoi region of a vertex
+    EXPECT_EQ (closest_point (Point_3D{-1.0, -1.0, 1.0}, tr), (Point_3D{0.0, 0.0, 0.0}));
+    EXPECT_EQ (closest_point (Point_3D{6.0, -1.0, 0.0}, tr), (Point_3D{4.0, 0.0, 0.0}));
+    EXPECT_EQ (closest_point (Point_3D{-1.0, 6.0, 2.0}, tr), (Point_3D{0.0, 4.0, 0.0}));
+
+    // the point lies in the Voronoi region of an edge
+    EXPECT_EQ (closest_point (Point_3D{2.0, -3.0, 0.0}, tr), (Point_3D{2.0, 0.0, 0.0}));
+    EXPECT_EQ (closest_point (Point_3D{-3.0, 2.0, 1.0}, tr), (Point_3D{0.0, 2.0, 0.0}));
+    EXPECT_EQ (closest_point (Point_3D{4.0, 4.0, 0.0}, tr), (Point_3D{2.0, 2.0, 0.0}));
+    EXPECT_DOUBLE_EQ (squared_distance (Point_3D{4.0, 4.0, 0.0}, tr), 8.0);
+
+    // the point belongs to the triangle
+    EXPECT_DOUBLE_EQ (squared_distance (Point_3D{1.0, 2.0, 0.0}, tr), 0.0);
+}
@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "point.hpp"
+#include "triangle.hpp"
+#include "magic_product.hpp"
+#include "triangle_triangle.hpp"
+#include "point_segment.hpp"
+#include "point_point.hpp"
+
+using namespace yLab::geometry;
+using namespace yLab::geometry::detail;
+
+TEST (Exact_Orientation, 2D_version)
+{
+    Point_2D P{0.0, 0.0};
+    Point_2D Q{2.0, 0.0};
+
+    // the point is off the line by less than the tolerance of cmp
+    Point_2D M{1.0, 1e-10};
+    EXPECT_EQ (magic_product (P, Q, M), Loc_2D::Neutral);
+    EXPECT_EQ (magic_product<Exact_Predicates> (P, Q, M), Loc_2D::Positive);
+    EXPECT_EQ (magic_product<Exact_Predicates> (Q, P, M), Loc_2D::Negative);
+
+    // the floating-point product can't be trusted: the sign comes from expansion arithmetic
+    Point_2D R{12.0, 12.0};
+    Point_2D S{24.0, 24.0};
+    EXPECT_EQ (magic_product<Exact_Predicates> (Point_2D{0.5, 0.5}, R, S), Loc_2D::Neutral);
+    EXPECT_EQ (magic_product<Exact_Predicates> (Point_2D{std::nextafter (0.5, 1.0), 0.5}, R, S),
+               Loc_2D::Negative);
+    EXPECT_EQ (magic_product<Exact_Predicates> (Point_2D{0.5, std::nextafter (0.5, 1.0)}, R, S),
+               Loc_2D::Positive);
+
+    Point_2D<float> P_f{std::nextafter (0.5f, 1.0f), 0.5f};
+    EXPECT_EQ (magic_product<Exact_Predicates> (P_f, Point_2D{12.0f, 12.0f},
+                                                Point_2D{24.0f, 24.0f}), Loc_2D::Negative);
+}
+
+TEST (Exact_Orientation, 3D_version)
+{
+    // all points lie in the plane z = x
+    Point_3D P{0.5, 0.0, 0.5};
+    Point_3D Q{12.0, 1.0, 12.0};
+    Point_3D R{3.0, 24.0, 3.0};
+    Point_3D M{24.0, 7.0, 24.0};
+
+    EXPECT_EQ (magic_product<Exact_Predicates> (P, Q, R, M), Loc_3D::On);
+
+    // one unit in the last place off the plane is on the same side as a point far off it
+    Point_3D M_near{std::nextafter (24.0, 25.0), 7.0, 24.0};
+    Point_3D M_far{25.0, 7.0, 24.0};
+
+    EXPECT_EQ (magic_product (P, Q, R, M_near), Loc_3D::On);
+    EXPECT_NE (magic_product<Exact_Predicates> (P, Q, R, M_near), Loc_3D::On);
+    EXPECT_EQ (magic_product<Exact_Predicates> (P, Q, R, M_near),
+               magic_product<Exact_Predicates> (P, Q, R, M_far));
+    EXPECT_EQ (magic_product<Exact_Predicates> (P, Q, R, M_far), magic_product (P, Q, R, M_far));
+    EXPECT_EQ (magic_product<Exact_Predicates> (Q, P, R, M_near),
+               opposite (magic_product<Exact_Predicates> (P, Q, R, M_near)));
+}
+
+TEST (Exact_Orientation, Triangle_Triangle)
+{
+    Triangle tr_1{Point_3D{0.0, 0.0, 0.0}, Point_3D{1.0, 0.0, 0.0}, Point_3D{0.0, 1.0, 0.0}};
+
+    // parallel triangles closer than the tolerance of cmp
+    Triangle tr_2{Point_3D{0.0, 0.0, 1e-9}, Point_3D{1.0, 0.0, 1e-9}, Point_3D{0.0, 1.0, 1e-9}};
+    EXPECT_TRUE (yLab::geometry::are_intersecting (tr_1, tr_2));
+    EXPECT_FALSE (yLab::geometry::are_intersecting<Exact_Predicates> (tr_1, tr_2));
+    EXPECT_FALSE (yLab::geometry::are_intersecting<Exact_Predicates> (tr_2, tr_1));
+
+    // triangles crossing each other
+    Triangle tr_3{Point_3D{0.2, 0.2, -1.0}, Point_3D{0.2, 0.2, 1.0}, Point_3D{0.3, 0.1, 1.0}};
+    EXPECT_TRUE (yLab::geometry::are_intersecting<Exact_Predicates> (tr_1, tr_3));
+    EXPECT_TRUE (yLab::geometry::are_intersecting<Exact_Predicates> (tr_3, tr_1));
+
+    // coplanar triangles sharing a vertex
+    Triangle tr_4{Point_3D{1.0, 0.0, 0.0}, Point_3D{2.0, 0.0, 0.0}, Point_3D{2.0, 1.0, 0.0}};
+    EXPECT_TRUE (yLab::geometry::are_intersecting<Exact_Predicates> (tr_1, tr_4));
+}
+
+TEST (Exact_Orientation, Raw_Predicates)
+{
+    Point_2D P{0.0, 0.0};
+    Point_2D Q{2.0, 0.0};
+
+    // the rounded product is taken as it is
+    EXPECT_EQ (magic_product<Raw_Predicates> (P, Q, Point_2D{1.0, 1e-10}), Loc_2D::Positive);
+    EXPECT_EQ (magic_product<Raw_Predicates> (P, Q, Point_2D{1.0, 0.0}), Loc_2D::Neutral);
+
+    Triangle tr_1{Point_3D{0.0, 0.0, 0.0}, Point_3D{1.0, 0.0, 0.0}, Point_3D{0.0, 1.0, 0.0}};
+    Triangle tr_2{Point_3D{0.0, 0.0, 1e-9}, Point_3D{1.0, 0.0, 1e-9}, Point_3D{0.0, 1.0, 1e-9}};
+    EXPECT_FALSE (yLab::geometry::are_intersecting<Raw_Predicates> (tr_1, tr_2));
+
+    Triangle tr_3{Point_3D{0.2, 0.2, -1.0}, Point_3D{0.2, 0.2, 1.0}, Point_3D{0.3, 0.1, 1.0}};
+    EXPECT_TRUE (yLab::geometry::are_intersecting<Raw_Predicates> (tr_1, tr_3));
+
+    // points and segments are compared without tolerance too
+    Point_3D pt{0.5, 0.0, 1e-9};
+    Segment seg{Point_3D{0.0, 0.0, 0.0}, Point_3D{1.0, 0.0, 0.0}};
+    EXPECT_TRUE (yLab::geometry::are_intersecting (pt, seg));
+    EXPECT_FALSE (yLab::geometry::are_intersecting<Raw_Predicates> (pt, seg));
+    EXPECT_TRUE (yLab::geometry::are_intersecting<Raw_Predicates> (Point_3D{0.5, 0.0, 0.0}, seg));
+
+    EXPECT_TRUE (yLab::geometry::are_intersecting (Point_3D{0.5, 0.0, 0.0}, pt));
+    EXPECT_FALSE (yLab::geometry::are_intersecting<Raw_Predicates> (Point_3D{0.5, 0.0, 0.0}, pt));
+}
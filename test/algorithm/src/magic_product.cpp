@@ -1,7 +1,9 @@
 #include <gtest/gtest.h>
 
 #include "point.hpp"
+#include "triangle.hpp"
 #include "magic_product.hpp"
+#include "triangle_plane.hpp"
 
 using namespace yLab::geometry;
 using namespace yLab::geometry::detail;
@@ -20,3 +22,23 @@ TEST (Magic_Product, 3D_version)
     EXPECT_EQ (magic_product (pt_11, pt_31, pt_21, Point_3D{802.82, -872.85, 0.0}),    Loc_3D::On);
     EXPECT_EQ (magic_product (pt_11, pt_31, pt_21, Point_3D{802.82, -872.85, -2.865}), Loc_3D::Above);
 }
+
+TEST (Magic_Product, Triangle_Plane)
+{
+    Point_3D pt_11 {1.0, 0.0, 0.0};
+    Point_3D pt_21 {0.0, 1.0, 0.0};
+    Point_3D pt_31 {0.0, 0.0, 0.0};
+
+    Triangle_Plane plane{Triangle{pt_11, pt_21, pt_31}};
+    Triangle_Plane swapped_plane{Triangle{pt_11, pt_31, pt_21}};
+
+    EXPECT_EQ (plane.axis, Axes::z);
+
+    for (auto M : {Point_3D{802.82, -872.85, 48.14}, Point_3D{802.82, -872.85, 0.0},
+                   Point_3D{802.82, -872.85, -2.865}, Point_3D{-0.5, 3.0, 1e-7}})
+    {
+        EXPECT_EQ (magic_product (plane, M), magic_product (pt_11, pt_21, pt_31, M));
+        EXPECT_EQ (magic_product (swapped_plane, M), magic_product (pt_11, pt_31, pt_21, M));
+        EXPECT_EQ (magic_product (swapped_plane, M), opposite (magic_product (plane, M)));
+    }
+}
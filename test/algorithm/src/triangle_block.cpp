@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include "triangle_block.hpp"
+#include "triangle_triangle.hpp"
+
+using namespace yLab::geometry;
+
+namespace
+{
+
+// The rejection by planes of are_intersecting () written with compute_relative_location ()
+template<typename T>
+bool is_separated_by_planes (const Triangle<Point_3D<T>> &tr_1, const Triangle<Point_3D<T>> &tr_2)
+{
+    using detail::Loc_3D;
+
+    auto [P1_loc, Q1_loc, R1_loc] = detail::compute_relative_location (tr_1, tr_2);
+    if (P1_loc == Q1_loc && Q1_loc == R1_loc)
+        return P1_loc != Loc_3D::On;
+
+    auto [P2_loc, Q2_loc, R2_loc] = detail::compute_relative_location (tr_2, tr_1);
+    return P2_loc == Q2_loc && Q2_loc == R2_loc;
+}
+
+// Blocks of every size including partial ones are compared with the scalar rejection
+template<typename T, std::size_t N>
+void check_separated_by_planes ()
+{
+    using point_type = Point_3D<T>;
+    using triangle_type = Triangle<point_type>;
+    using block_type = Triangle_Block<T, N>;
+
+    std::mt19937_64 gen{25};
+    std::uniform_real_distribution<T> coordinate (-3.0, 3.0);
+
+    auto random_point = [&]
+    {
+        return point_type{coordinate (gen), coordinate (gen), coordinate (gen)};
+    };
+
+    auto random_triangle = [&]
+    {
+        while (true)
+        {
+            try
+            {
+                return triangle_type{random_point(), random_point(), random_point()};
+            }
+            catch (const Degenerate_Triangle &) {}
+        }
+    };
+
+    std::size_t n_separated = 0;
+    std::size_t n_expected = 0;
+    std::size_t n_missed = 0;
+    std::size_t n_intersecting = 0;
+
+    for (auto i = 0; i != 500; ++i)
+    {
+        auto tr = random_triangle();
+        block_type block;
+        std::vector<triangle_type> triangles;
+
+        // One lane is coplanar with tr
+        auto size = 1 + i % block_type::capacity();
+        for (std::size_t lane = 0; lane != size; ++lane)
+        {
+            point_type middle{(tr.P().x() + tr.Q().x()) / 2, (tr.P().y() + tr.Q().y()) / 2,
+                              (tr.P().z() + tr.Q().z()) / 2};
+
+            triangles.push_back ((lane == 3) ? triangle_type{tr.P(), tr.R(), middle}
+                                             : random_triangle());
+            block.push_back (triangles.back());
+        }
+
+        auto separated = detail::separated_by_planes (tr, block);
+        EXPECT_EQ (std::uint64_t{separated} >> size, 0u);
+
+        for (std::size_t lane = 0; lane != size; ++lane)
+        {
+            auto is_separated = (separated >> lane) & 1;
+            auto is_expected = is_separated_by_planes (tr, triangles[lane]);
+
+            // Lanes are separated exactly as expected unless SIMD registers are used with FMA.
+            // Then lanes within rounding errors of the planes are left to the full test: the
+            // coplanar lane and hardly any other
+            if (detail::Has_Simd_Lanes<T, N> && detail::has_fused_multiply_add)
+                EXPECT_TRUE (!is_separated || is_expected);
+            else
+                EXPECT_EQ (is_separated, is_expected);
+
+            if (lane != 3)
+            {
+                n_expected += is_expected;
+                n_missed += is_expected && !is_separated;
+            }
+
+            if (is_separated)
+            {
+                EXPECT_FALSE (are_intersecting (tr, triangles[lane]));
+                ++n_separated;
+            }
+            else
+                n_intersecting += are_intersecting (tr, triangles[lane]);
+        }
+    }
+
+    EXPECT_GT (n_separated, 0);
+    EXPECT_LE (100 * n_missed, n_expected);
+    EXPECT_GT (n_intersecting, 0);
+}
+
+} // unnamed namespace
+
+// SIMD registers are used for every N they fill, plain loops for the others
+TEST (Triangle_Block, Separated_By_Planes)
+{
+    check_separated_by_planes<double, 8>();
+    check_separated_by_planes<float, 8>();
+    check_separated_by_planes<float, 32>();
+    check_separated_by_planes<double, 5>();
+}
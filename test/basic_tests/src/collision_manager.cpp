@@ -0,0 +1,888 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+#include <set>
+#include <random>
+#include <algorithm>
+#include <utility>
+#include <mutex>
+#include <numeric>
+#include <type_traits>
+#include <optional>
+#include <stop_token>
+#include <cstddef>
+
+#include "collision_manager.hpp"
+#include "sweep_and_prune.hpp"
+#include "bounding_volume_hierarchy.hpp"
+#include "uniform_grid.hpp"
+#include "loose_octree.hpp"
+#include "adaptive_octree.hpp"
+#include "linear_octree.hpp"
+#include "shape_record.hpp"
+#include "ray.hpp"
+
+using namespace yLab::geometry;
+
+namespace
+{
+
+using shape_type = Indexed_Shape<double>;
+using point_type = Primitive_Traits<double>::point_type;
+using triangle_type = Primitive_Traits<double>::triangle_type;
+
+template<typename Broad_Phase>
+using manager_type = Collision_Manager<double, shape_type, Broad_Phase>;
+
+std::vector<shape_type> random_triangles (std::size_t n_shapes, double world_size,
+                                          double max_shape_size, unsigned seed)
+{
+    std::mt19937_64 gen{seed};
+    std::uniform_real_distribution<double> coordinate (-world_size, world_size);
+    std::uniform_real_distribution<double> offset (-max_shape_size, max_shape_size);
+
+    std::vector<shape_type> shapes;
+    shapes.reserve (n_shapes);
+
+    for (std::size_t i = 0; i != n_shapes; ++i)
+    {
+        point_type center{coordinate (gen), coordinate (gen), coordinate (gen)};
+
+        auto vertex = [&]
+        {
+            return point_type{center.x() + offset (gen), center.y() + offset (gen),
+                              center.z() + offset (gen)};
+        };
+
+        shapes.emplace_back (triangle_type{vertex(), vertex(), vertex()}, i);
+    }
+
+    return shapes;
+}
+
+std::vector<std::size_t> brute_force (const std::vector<shape_type> &shapes)
+{
+    std::set<std::size_t> indexes;
+
+    for (std::size_t i = 0; i != shapes.size(); ++i)
+        for (std::size_t j = i + 1; j != shapes.size(); ++j)
+            if (are_intersecting (shapes[i], shapes[j]))
+            {
+                indexes.insert (shapes[i].index());
+                indexes.insert (shapes[j].index());
+            }
+
+    return std::vector<std::size_t>(indexes.begin(), indexes.end());
+}
+
+using index_pair = std::pair<std::size_t, std::size_t>;
+
+std::vector<index_pair> brute_force_pairs (const std::vector<shape_type> &shapes)
+{
+    std::vector<index_pair> pairs;
+
+    for (std::size_t i = 0; i != shapes.size(); ++i)
+        for (std::size_t j = i + 1; j != shapes.size(); ++j)
+            if (are_intersecting (shapes[i], shapes[j]))
+                pairs.emplace_back (shapes[i].index(), shapes[j].index());
+
+    std::sort (pairs.begin(), pairs.end());
+    return pairs;
+}
+
+template<typename Pair>
+index_pair ordered (const Pair &pair)
+{
+    return std::minmax (pair.first, pair.second);
+}
+
+} // unnamed namespace
+
+TEST (Collision_Manager, Serial)
+{
+    auto shapes = random_triangles (1000, 100.0, 6.0, 1);
+
+    Collision_Manager<double> manager{shapes.begin(), shapes.end()};
+    manager.intersect_all ();
+
+    EXPECT_EQ (manager.intersecting().indexes(), brute_force (shapes));
+}
+
+TEST (Collision_Manager, Parallel)
+{
+    auto shapes = random_triangles (3000, 100.0, 6.0, 2);
+
+    Collision_Manager<double> serial{shapes.begin(), shapes.end()};
+    serial.intersect_all ();
+
+    for (auto n_threads : {2, 3, 8, 64})
+    {
+        Collision_Manager<double> parallel{shapes.begin(), shapes.end()};
+        parallel.intersect_all (n_threads);
+
+        EXPECT_EQ (parallel.intersecting().indexes(), serial.intersecting().indexes());
+    }
+}
+
+TEST (Collision_Manager, Pipeline)
+{
+    auto shapes = random_triangles (3000, 60.0, 6.0, 3);
+
+    Collision_Manager<double> serial{shapes.begin(), shapes.end()};
+    serial.intersect_all ();
+
+    for (auto [n_producers, n_consumers] : {std::pair{1, 1}, std::pair{1, 3}, std::pair{4, 2}})
+    {
+        Collision_Manager<double> pipelined{shapes.begin(), shapes.end()};
+        pipelined.intersect_all (n_producers, n_consumers, 16);
+
+        EXPECT_EQ (pipelined.intersecting().indexes(), serial.intersecting().indexes());
+    }
+}
+
+TEST (Collision_Manager, Set_Sink)
+{
+    auto shapes = random_triangles (1000, 60.0, 6.0, 4);
+
+    Collision_Manager<double, shape_type, Octree<double>, yLab::Set_Sink> manager{shapes.begin(),
+                                                                                  shapes.end()};
+    manager.intersect_all (3);
+
+    EXPECT_EQ (manager.intersecting().indexes(), brute_force (shapes));
+}
+
+TEST (Collision_Manager, Sweep_And_Prune)
+{
+    auto shapes = random_triangles (2000, 80.0, 6.0, 5);
+
+    manager_type<Sweep_And_Prune<double>> sap{shapes.begin(), shapes.end()};
+    sap.intersect_all ();
+
+    EXPECT_EQ (sap.intersecting().indexes(), brute_force (shapes));
+
+    manager_type<Sweep_And_Prune<double>> parallel{shapes.begin(), shapes.end()};
+    parallel.intersect_all (4);
+
+    EXPECT_EQ (parallel.intersecting().indexes(), brute_force (shapes));
+}
+
+TEST (Collision_Manager, Sweep_And_Prune_Slabs)
+{
+    // Long thin layers along y
+    auto shapes = random_triangles (2000, 5.0, 1.0, 6);
+    for (auto &shape : shapes)
+    {
+        auto &tr = std::get<triangle_type>(shape.primitive());
+        for (auto &pt : tr)
+            pt = point_type{pt.x() * 0.1, pt.y() * 40.0, pt.z()};
+
+        shape = shape_type{tr, shape.index()};
+    }
+
+    manager_type<Sweep_And_Prune<double>> sap{shapes.begin(), shapes.end()};
+    sap.intersect_all ();
+
+    EXPECT_EQ (sap.broad_phase().axis(), 1);
+    EXPECT_EQ (sap.intersecting().indexes(), brute_force (shapes));
+}
+
+TEST (Collision_Manager, Sweep_And_Prune_Empty)
+{
+    std::vector<shape_type> shapes;
+
+    Sweep_And_Prune<double> sap{shapes.begin(), shapes.end()};
+    EXPECT_EQ (sap.size(), 0);
+    EXPECT_EQ (sap.axis(), 0);
+
+    auto n_candidates = 0;
+    auto visit = [&n_candidates](const shape_type &, const shape_type &) { ++n_candidates; };
+    sap.for_each_candidate (visit);
+
+    EXPECT_EQ (n_candidates, 0);
+}
+
+TEST (Collision_Manager, BVH)
+{
+    auto shapes = random_triangles (3000, 80.0, 6.0, 7);
+
+    manager_type<BVH<double>> bvh{shapes.begin(), shapes.end()};
+    bvh.intersect_all ();
+
+    EXPECT_EQ (bvh.intersecting().indexes(), brute_force (shapes));
+
+    for (auto n_threads : {2, 5})
+    {
+        manager_type<BVH<double>> parallel{shapes.begin(), shapes.end()};
+        parallel.intersect_all (n_threads);
+
+        EXPECT_EQ (parallel.intersecting().indexes(), bvh.intersecting().indexes());
+    }
+
+    // Coincident centroids can't be split by the heuristic
+    std::vector<shape_type> same (20, shapes.front());
+    for (std::size_t i = 0; i != same.size(); ++i)
+        same[i] = shape_type{std::get<triangle_type>(shapes.front().primitive()), i};
+
+    manager_type<BVH<double>> coincident{same.begin(), same.end()};
+    coincident.intersect_all ();
+
+    EXPECT_EQ (coincident.intersecting().size(), same.size());
+}
+
+TEST (Collision_Manager, Uniform_Grid)
+{
+    auto shapes = random_triangles (3000, 80.0, 6.0, 8);
+
+    manager_type<Uniform_Grid<double>> grid{shapes.begin(), shapes.end()};
+    grid.intersect_all ();
+
+    EXPECT_EQ (grid.intersecting().indexes(), brute_force (shapes));
+
+    manager_type<Uniform_Grid<double>> parallel{shapes.begin(), shapes.end()};
+    parallel.intersect_all (3);
+
+    EXPECT_EQ (parallel.intersecting().indexes(), grid.intersecting().indexes());
+}
+
+TEST (Collision_Manager, Uniform_Grid_No_Duplicates)
+{
+    // A large shape spans many cells of small ones
+    auto shapes = random_triangles (500, 30.0, 2.0, 9);
+    shapes.emplace_back (triangle_type{point_type{-30.0, -30.0, 0.0}, point_type{30.0, -30.0, 0.0},
+                                       point_type{0.0, 30.0, 0.0}}, shapes.size());
+
+    Uniform_Grid<double> grid{shapes.begin(), shapes.end()};
+    EXPECT_GT (grid.n_cells(), shapes.size() / 2);
+
+    std::set<std::pair<std::size_t, std::size_t>> pairs;
+    auto n_visits = 0;
+    auto visit = [&](const shape_type &shape_1, const shape_type &shape_2)
+    {
+        ++n_visits;
+        pairs.emplace (std::min (shape_1.index(), shape_2.index()),
+                       std::max (shape_1.index(), shape_2.index()));
+    };
+
+    grid.for_each_candidate (visit);
+
+    EXPECT_EQ (n_visits, pairs.size());
+}
+
+TEST (Collision_Manager, Uniform_Grid_Oversized)
+{
+    // Outliers would cover millions of cells of the small shapes
+    auto shapes = random_triangles (2000, 50.0, 2.0, 10);
+    shapes.emplace_back (triangle_type{point_type{-1e4, -1e4, -1e4}, point_type{1e4, -1e4, 1e4},
+                                       point_type{0.0, 1e4, 0.0}}, shapes.size());
+    shapes.emplace_back (triangle_type{point_type{-1e4, 1e4, -1e4}, point_type{1e4, 1e4, 1e4},
+                                       point_type{0.0, -1e4, 0.0}}, shapes.size());
+
+    Uniform_Grid<double> grid{shapes.begin(), shapes.end()};
+    EXPECT_EQ (grid.n_oversized(), 2);
+    EXPECT_LT (grid.n_cells(), 8 * shapes.size());
+
+    manager_type<Uniform_Grid<double>> manager{shapes.begin(), shapes.end()};
+    manager.intersect_all ();
+
+    EXPECT_EQ (manager.intersecting().indexes(), brute_force (shapes));
+
+    manager_type<Uniform_Grid<double>> parallel{shapes.begin(), shapes.end()};
+    parallel.intersect_all (4);
+
+    EXPECT_EQ (parallel.intersecting().indexes(), brute_force (shapes));
+}
+
+TEST (Collision_Manager, Dynamic_Update)
+{
+    auto shapes = random_triangles (1000, 50.0, 6.0, 7);
+
+    Collision_Manager<double> manager{shapes.begin(), shapes.end()};
+    manager.intersect_all ();
+
+    std::mt19937_64 gen{8};
+    std::uniform_int_distribution<std::size_t> shape_i (0, shapes.size() - 1);
+
+    for (auto frame = 0u; frame != 5; ++frame)
+    {
+        auto moved = random_triangles (shapes.size(), 50.0, 6.0, 100 + frame);
+
+        for (auto i = 0; i != 50; ++i)
+        {
+            auto index = shape_i (gen);
+
+            EXPECT_TRUE (manager.update (shapes[index], moved[index]));
+            shapes[index] = moved[index];
+        }
+
+        EXPECT_EQ (manager.intersecting().indexes(), brute_force (shapes));
+    }
+
+    auto expected = brute_force (shapes);
+    for (auto index : expected)
+        EXPECT_GT (manager.n_intersections (index), 0);
+}
+
+TEST (Collision_Manager, Dynamic_Remove)
+{
+    auto shapes = random_triangles (1000, 50.0, 6.0, 9);
+
+    Collision_Manager<double> manager{shapes.begin(), shapes.end()};
+
+    std::vector<shape_type> remaining;
+    for (auto &shape : shapes)
+    {
+        if (shape.index() % 3 == 0)
+        {
+            EXPECT_TRUE (manager.remove (shape));
+        }
+        else
+            remaining.push_back (shape);
+    }
+
+    EXPECT_FALSE (manager.remove (shapes.front()));
+    EXPECT_FALSE (manager.update (shapes.front(), shapes.front()));
+    EXPECT_EQ (manager.intersecting().indexes(), brute_force (remaining));
+}
+
+// Indexes are fixed when the scene is built; a failed update leaves the octree as it was
+TEST (Collision_Manager, Dynamic_Invalid_Index)
+{
+    auto shapes = random_triangles (1000, 50.0, 6.0, 11);
+
+    Collision_Manager<double> manager{shapes.begin(), shapes.end()};
+    manager.intersect_all ();
+
+    auto &tr = std::get<triangle_type>(shapes[5].primitive());
+    shape_type renumbered{tr, shapes.size()};
+    shape_type beyond{tr, shapes.size() + 100};
+
+    EXPECT_THROW (manager.update (shapes[5], renumbered), Invalid_Index);
+    EXPECT_THROW (manager.update (beyond, beyond), Invalid_Index);
+    EXPECT_THROW (manager.remove (beyond), Invalid_Index);
+    EXPECT_THROW (manager.n_intersections (shapes.size()), Invalid_Index);
+
+    EXPECT_EQ (manager.intersecting().indexes(), brute_force (shapes));
+
+    auto &octree = manager.broad_phase();
+    auto halfwidth = octree.root().halfwidth();
+
+    ASSERT_TRUE (manager.remove (shapes[7]));
+
+    auto shift = [](const point_type &pt)
+    {
+        return point_type{pt.x() + 1000.0, pt.y(), pt.z()};
+    };
+    auto &removed_tr = std::get<triangle_type>(shapes[7].primitive());
+    shape_type far_away{triangle_type{shift (removed_tr.P()), shift (removed_tr.Q()),
+                                      shift (removed_tr.R())}, 7};
+
+    EXPECT_FALSE (manager.update (shapes[7], far_away));
+    EXPECT_EQ (octree.root().halfwidth(), halfwidth);
+}
+
+// Shapes moved far outside the cube of the root are still found by every traversal
+TEST (Collision_Manager, Dynamic_Out_Of_Bounds)
+{
+    using ray_type = Ray<double>;
+
+    auto shapes = random_triangles (1000, 50.0, 6.0, 31);
+    auto others = random_triangles (300, 60.0, 6.0, 32);
+
+    Collision_Manager<double> manager{shapes.begin(), shapes.end()};
+    manager.intersect_all ();
+
+    // Shapes around (100, 100, 100) and (-300, 40, 0) intersect each other and the other set
+    auto outside = random_triangles (40, 3.0, 3.0, 33);
+    for (auto i = 0u; i != outside.size(); ++i)
+    {
+        auto center = (i % 2) ? point_type{100.0, 100.0, 100.0} : point_type{-300.0, 40.0, 0.0};
+        auto &tr = std::get<triangle_type>(outside[i].primitive());
+        auto shift = [&center](const point_type &pt)
+        {
+            return point_type{pt.x() + center.x(), pt.y() + center.y(), pt.z() + center.z()};
+        };
+
+        auto index = i * 20;
+        triangle_type moved_tr{shift (tr.P()), shift (tr.Q()), shift (tr.R())};
+        shape_type moved{moved_tr, index};
+
+        EXPECT_TRUE (manager.update (shapes[index], moved));
+        shapes[index] = moved;
+
+        others[i] = shape_type{moved_tr, others[i].index()};
+    }
+
+    EXPECT_EQ (manager.intersecting().indexes(), brute_force (shapes));
+
+    Collision_Manager<double> restarted{shapes.begin(), shapes.end()};
+    restarted.intersect_all ();
+    EXPECT_EQ (manager.intersecting().indexes(), restarted.intersecting().indexes());
+
+    auto &octree = manager.broad_phase();
+
+    AABB<double> box{point_type{100.0, 100.0, 100.0}, 5.0, 5.0, 5.0};
+    detail::Query_Box<double> query_box{box};
+
+    std::vector<std::size_t> expected_found;
+    for (auto &shape : shapes)
+        if (detail::is_shape_in_box (shape, query_box, Primitive_Kinds::all))
+            expected_found.push_back (shape.index());
+
+    std::vector<std::size_t> found;
+    octree.query (box, std::back_inserter (found));
+    std::sort (found.begin(), found.end());
+
+    ASSERT_FALSE (expected_found.empty());
+    EXPECT_EQ (found, expected_found);
+
+    ray_type ray{point_type{80.0, 80.0, 80.0}, Vector<double>{1.0, 1.0, 1.0}};
+
+    std::optional<double> expected_t;
+    for (auto &shape : shapes)
+    {
+        std::array<double, 3> min{shape.left_bound (0), shape.left_bound (1),
+                                  shape.left_bound (2)};
+        std::array<double, 3> max{shape.right_bound (0), shape.right_bound (1),
+                                  shape.right_bound (2)};
+
+        auto [t_enter, t_exit] = ray.clip (min, max);
+        double t;
+        if (t_enter <= t_exit && detail::hit_shape (ray, shape, t_enter, t_exit, t)
+            && (!expected_t || t < *expected_t))
+            expected_t = t;
+    }
+
+    auto hit = octree.cast (ray);
+    ASSERT_TRUE (expected_t.has_value());
+    ASSERT_TRUE (hit.has_value());
+    EXPECT_NEAR (hit->t, *expected_t, 1e-6);
+
+    // Cross queries against a set the tree was not built with
+    std::vector<index_pair> expected_pairs;
+    for (auto &shape_1 : shapes)
+        for (auto &shape_2 : others)
+            if (are_intersecting (shape_1, shape_2))
+                expected_pairs.emplace_back (shape_1.index(), shape_2.index());
+    std::sort (expected_pairs.begin(), expected_pairs.end());
+
+    Collision_Manager<double> other_manager{others.begin(), others.end()};
+
+    std::vector<index_pair> pairs;
+    manager.for_each_intersecting_pair (other_manager, [&pairs](const auto &pair)
+    {
+        pairs.emplace_back (pair.first, pair.second);
+    });
+    std::sort (pairs.begin(), pairs.end());
+
+    EXPECT_EQ (pairs, expected_pairs);
+}
+
+TEST (Collision_Manager, Octree_Shape_Store)
+{
+    auto shapes = random_triangles (1000, 50.0, 6.0, 10);
+
+    Octree<double> octree{shapes.begin(), shapes.end()};
+    EXPECT_EQ (octree.store().size(), shapes.size());
+
+    // The geometry is kept once: the store takes less than a copy of every shape, which
+    // the nodes used to hold
+    EXPECT_LT (octree.store().footprint(), shapes.size() * sizeof (shape_type));
+
+    for (auto &shape : shapes)
+    {
+        if (shape.index() % 3 == 0)
+        {
+            EXPECT_TRUE (octree.erase (shape));
+        }
+    }
+
+    for (auto &shape : shapes)
+        if (shape.index() % 3 == 0)
+            octree.insert (shape);
+
+    // Slots of erased shapes are reused
+    EXPECT_EQ (octree.store().size(), shapes.size());
+
+    std::vector<index_pair> pairs;
+    auto visit = [&pairs](const shape_type &shape_1, const shape_type &shape_2)
+    {
+        if (are_intersecting (shape_1, shape_2))
+            pairs.push_back (ordered (index_pair{shape_1.index(), shape_2.index()}));
+    };
+
+    octree.for_each_candidate (visit);
+    std::sort (pairs.begin(), pairs.end());
+
+    EXPECT_EQ (pairs, brute_force_pairs (shapes));
+}
+
+TEST (Collision_Manager, Pair_Callback)
+{
+    auto shapes = random_triangles (2000, 100.0, 6.0, 10);
+    auto expected = brute_force_pairs (shapes);
+
+    Collision_Manager<double> manager{shapes.begin(), shapes.end()};
+
+    std::vector<index_pair> serial;
+    manager.for_each_intersecting_pair ([&serial](const auto &pair)
+    {
+        serial.push_back (ordered (pair));
+    });
+    std::sort (serial.begin(), serial.end());
+
+    EXPECT_EQ (serial, expected);
+
+    std::vector<index_pair> parallel;
+    std::mutex mutex;
+    manager.for_each_intersecting_pair ([&](const auto &pair)
+    {
+        std::lock_guard lock{mutex};
+        parallel.push_back (ordered (pair));
+    }, 4);
+    std::sort (parallel.begin(), parallel.end());
+
+    EXPECT_EQ (parallel, expected);
+}
+
+TEST (Collision_Manager, Pair_Stream)
+{
+    auto shapes = random_triangles (2000, 100.0, 6.0, 11);
+    auto expected = brute_force_pairs (shapes);
+
+    Collision_Manager<double> manager{shapes.begin(), shapes.end()};
+
+    std::vector<index_pair> streamed;
+    for (auto &pair : manager.intersecting_pairs (16))
+        streamed.push_back (ordered (pair));
+    std::sort (streamed.begin(), streamed.end());
+
+    EXPECT_EQ (streamed, expected);
+
+    // The producer is cancelled when the range is destroyed before it's exhausted
+    auto n_taken = 0;
+    for (auto &pair : manager.intersecting_pairs (4))
+    {
+        static_cast<void>(pair);
+        if (++n_taken == 3)
+            break;
+    }
+
+    EXPECT_EQ (n_taken, 3);
+
+    // A producer that never runs out of values stops once the range is destroyed
+    {
+        yLab::Stream<int> numbers{[](auto emit, std::stop_token stop)
+        {
+            for (auto i = 0; !stop.stop_requested(); ++i)
+                emit (i);
+        }, 4};
+
+        std::vector<int> taken;
+        for (auto number : numbers)
+        {
+            taken.push_back (number);
+            if (taken.size() == 3)
+                break;
+        }
+
+        EXPECT_EQ (taken, (std::vector<int>{0, 1, 2}));
+    }
+}
+
+TEST (Collision_Manager, Any_Hit)
+{
+    auto shapes = random_triangles (3000, 100.0, 6.0, 12);
+    auto expected = brute_force (shapes);
+
+    for (auto n_threads : {1, 4})
+    {
+        Collision_Manager<double> octree{shapes.begin(), shapes.end()};
+        octree.intersect_any (n_threads);
+        EXPECT_EQ (octree.intersecting().indexes(), expected);
+
+        manager_type<BVH<double, shape_type>> bvh{shapes.begin(), shapes.end()};
+        bvh.intersect_any (n_threads);
+        EXPECT_EQ (bvh.intersecting().indexes(), expected);
+    }
+}
+
+TEST (Collision_Manager, Any_Hit_Dense)
+{
+    auto shapes = random_triangles (1000, 3.0, 6.0, 13);
+
+    Collision_Manager<double> manager{shapes.begin(), shapes.end()};
+    auto n_tests = manager.intersect_any ();
+
+    std::size_t n_candidates = 0;
+    auto count = [&n_candidates](const shape_type &, const shape_type &) { ++n_candidates; };
+    manager.broad_phase().for_each_candidate (count);
+
+    EXPECT_EQ (manager.intersecting().indexes(), brute_force (shapes));
+    EXPECT_LT (10 * n_tests, n_candidates);
+}
+
+TEST (Collision_Manager, Loose_Octree)
+{
+    auto shapes = random_triangles (3000, 100.0, 6.0, 14);
+    auto expected = brute_force (shapes);
+
+    for (auto looseness : {1.0, 1.5, 2.0, 3.0})
+    {
+        Loose_Octree<double> engine{shapes.begin(), shapes.end(), looseness};
+
+        std::vector<index_pair> pairs;
+        auto collect = [&pairs](const shape_type &shape_1, const shape_type &shape_2)
+        {
+            pairs.push_back (ordered (std::pair{shape_1.index(), shape_2.index()}));
+        };
+        engine.for_each_candidate (collect);
+
+        std::sort (pairs.begin(), pairs.end());
+        EXPECT_EQ (std::adjacent_find (pairs.begin(), pairs.end()), pairs.end());
+    }
+
+    manager_type<Loose_Octree<double>> manager{shapes.begin(), shapes.end()};
+    manager.intersect_all (4);
+
+    EXPECT_EQ (manager.intersecting().indexes(), expected);
+    EXPECT_THROW ((Loose_Octree<double>{shapes.begin(), shapes.end(), 0.5}), Invalid_Looseness);
+}
+
+TEST (Collision_Manager, Loose_Octree_Depths)
+{
+    auto shapes = random_triangles (3000, 100.0, 6.0, 15);
+
+    Octree<double> octree{shapes.begin(), shapes.end()};
+    Loose_Octree<double> loose_octree{shapes.begin(), shapes.end()};
+
+    auto histogram = octree.depth_histogram();
+    auto loose_histogram = loose_octree.depth_histogram();
+
+    EXPECT_EQ (std::accumulate (histogram.begin(), histogram.end(), std::size_t{0}), shapes.size());
+    EXPECT_EQ (std::accumulate (loose_histogram.begin(), loose_histogram.end(), std::size_t{0}),
+               shapes.size());
+    EXPECT_LT (10 * loose_histogram.front(), histogram.front());
+}
+
+TEST (Collision_Manager, Adaptive_Octree)
+{
+    auto shapes = random_triangles (3000, 100.0, 6.0, 16);
+    auto expected = brute_force (shapes);
+    auto expected_pairs = brute_force_pairs (shapes);
+
+    for (std::size_t max_shapes_per_node : {1, 4, 8, 64})
+    {
+        Adaptive_Octree<double> engine{shapes.begin(), shapes.end(), max_shapes_per_node};
+
+        std::vector<index_pair> pairs;
+        auto collect = [&pairs](const shape_type &shape_1, const shape_type &shape_2)
+        {
+            if (are_intersecting (shape_1, shape_2))
+                pairs.push_back (ordered (std::pair{shape_1.index(), shape_2.index()}));
+        };
+        engine.for_each_candidate (collect);
+
+        std::sort (pairs.begin(), pairs.end());
+        EXPECT_EQ (pairs, expected_pairs);
+    }
+
+    manager_type<Adaptive_Octree<double>> manager{shapes.begin(), shapes.end()};
+    manager.intersect_all (4);
+
+    EXPECT_EQ (manager.intersecting().indexes(), expected);
+}
+
+TEST (Collision_Manager, Adaptive_Octree_Sparse)
+{
+    // Two distant clusters: the space between them mustn't be subdivided
+    auto shapes = random_triangles (1000, 10.0, 0.5, 17);
+    auto far_shapes = random_triangles (1000, 10.0, 0.5, 18);
+
+    for (auto &shape : far_shapes)
+    {
+        auto vertex = [](const point_type &P)
+        {
+            return point_type{P.x() + 1e3, P.y() + 1e3, P.z() + 1e3};
+        };
+        auto &triangle = std::get<triangle_type>(shape.primitive());
+
+        shapes.emplace_back (triangle_type{vertex (triangle.P()), vertex (triangle.Q()),
+                                           vertex (triangle.R())}, shapes.size());
+    }
+
+    Adaptive_Octree<double> engine{shapes.begin(), shapes.end()};
+
+    EXPECT_GT (engine.height(), Octree<double>::max_height());
+    EXPECT_LT (engine.size(), 2 * shapes.size());
+    EXPECT_EQ (engine.find (1), 0);
+    EXPECT_EQ (engine.find (0b1'011), engine.size());
+
+    auto histogram = engine.depth_histogram();
+    EXPECT_EQ (std::accumulate (histogram.begin(), histogram.end(), std::size_t{0}), shapes.size());
+
+    manager_type<Adaptive_Octree<double>> manager{shapes.begin(), shapes.end()};
+    manager.intersect_all ();
+
+    EXPECT_EQ (manager.intersecting().indexes(), brute_force (shapes));
+}
+
+TEST (Collision_Manager, Linear_Octree)
+{
+    auto shapes = random_triangles (3000, 100.0, 6.0, 19);
+    auto expected = brute_force (shapes);
+    auto expected_pairs = brute_force_pairs (shapes);
+
+    for (std::size_t height : {1, 3, 6, 12})
+    {
+        Linear_Octree<double> engine{shapes.begin(), shapes.end(), height};
+
+        std::vector<index_pair> candidates;
+        auto collect = [&candidates](const shape_type &shape_1, const shape_type &shape_2)
+        {
+            candidates.push_back (ordered (std::pair{shape_1.index(), shape_2.index()}));
+        };
+        engine.for_each_candidate (collect);
+
+        std::sort (candidates.begin(), candidates.end());
+        EXPECT_EQ (std::adjacent_find (candidates.begin(), candidates.end()), candidates.end());
+        EXPECT_TRUE (std::includes (candidates.begin(), candidates.end(),
+                                    expected_pairs.begin(), expected_pairs.end()));
+
+        for (std::size_t node_i = 0; node_i != engine.size(); ++node_i)
+            EXPECT_EQ (engine.find (engine.nodes()[node_i].code), node_i);
+    }
+
+    manager_type<Linear_Octree<double>> manager{shapes.begin(), shapes.end()};
+    manager.intersect_all (4);
+
+    EXPECT_EQ (manager.intersecting().indexes(), expected);
+}
+
+TEST (Collision_Manager, Linear_Octree_Bulk)
+{
+    auto n_shapes = 3 * Linear_Octree<double>::min_shapes_per_thread();
+    auto shapes = random_triangles (n_shapes, 1000.0, 6.0, 20);
+
+    Linear_Octree<double> serial{shapes.begin(), shapes.end(), 8, 1};
+
+    for (std::size_t n_threads : {2, 3, 8})
+    {
+        Linear_Octree<double> parallel{shapes.begin(), shapes.end(), 8, n_threads};
+
+        ASSERT_EQ (parallel.size(), serial.size());
+        for (std::size_t node_i = 0; node_i != serial.size(); ++node_i)
+        {
+            auto &node_1 = serial.nodes()[node_i];
+            auto &node_2 = parallel.nodes()[node_i];
+
+            EXPECT_EQ (node_1.code, node_2.code);
+            EXPECT_EQ (node_1.children, node_2.children);
+            EXPECT_EQ (node_1.first_child, node_2.first_child);
+            EXPECT_EQ (node_1.first_shape, node_2.first_shape);
+            EXPECT_EQ (node_1.n_shapes, node_2.n_shapes);
+        }
+
+        for (std::size_t shape_i = 0; shape_i != n_shapes; ++shape_i)
+            EXPECT_EQ (serial.shapes()[shape_i].index(), parallel.shapes()[shape_i].index());
+    }
+
+    // Shapes of a node are in the order of input, nodes are sorted by codes
+    for (auto &node : serial.nodes())
+    {
+        auto first = serial.shapes().begin() + node.first_shape;
+        EXPECT_TRUE (std::is_sorted (first, first + node.n_shapes, [](auto &lhs, auto &rhs)
+        {
+            return lhs.index() < rhs.index();
+        }));
+    }
+
+    EXPECT_TRUE (std::is_sorted (serial.nodes().begin(), serial.nodes().end(),
+                                 [](auto &lhs, auto &rhs) { return lhs.code < rhs.code; }));
+}
+
+TEST (Collision_Manager, Shape_Record)
+{
+    using record_type = Shape_Record<double>;
+
+    static_assert (std::is_trivially_copyable_v<record_type>);
+    static_assert (std::is_trivially_copyable_v<shape_type>);
+    static_assert (sizeof (record_type) < sizeof (shape_type));
+
+    auto shapes = random_triangles (1000, 50.0, 6.0, 14);
+    auto expected = brute_force (shapes);
+
+    std::vector<record_type> records;
+    for (auto &shape : shapes)
+        records.emplace_back (shape);
+
+    for (std::size_t i = 0; i != shapes.size(); ++i)
+    {
+        EXPECT_EQ (records[i].index(), shapes[i].index());
+        EXPECT_EQ (records[i].kind(), record_type::Kind::triangle);
+
+        // AABB picks extreme vertices with the tolerance of cmp; records keep exact bounds
+        for (auto axis = 0u; axis != 3; ++axis)
+        {
+            EXPECT_NEAR (records[i].left_bound (axis), shapes[i].left_bound (axis), 1e-4);
+            EXPECT_NEAR (records[i].right_bound (axis), shapes[i].right_bound (axis), 1e-4);
+        }
+    }
+
+    auto check = [&]<typename Broad_Phase>(std::type_identity<Broad_Phase>)
+    {
+        Collision_Manager<double, record_type, Broad_Phase> manager{records.begin(), records.end()};
+        manager.intersect_all ();
+
+        EXPECT_EQ (manager.intersecting().indexes(), expected);
+    };
+
+    check (std::type_identity<Octree<double, record_type>>{});
+    check (std::type_identity<Loose_Octree<double, record_type>>{});
+    check (std::type_identity<Adaptive_Octree<double, record_type>>{});
+    check (std::type_identity<Linear_Octree<double, record_type>>{});
+    check (std::type_identity<Sweep_And_Prune<double, record_type>>{});
+    check (std::type_identity<BVH<double, record_type>>{});
+    check (std::type_identity<Uniform_Grid<double, record_type>>{});
+}
+
+TEST (Collision_Manager, Cross_Set)
+{
+    auto piping = random_triangles (800, 50.0, 6.0, 15);
+    auto structure = random_triangles (600, 40.0, 8.0, 16);
+
+    std::vector<index_pair> expected;
+    std::set<std::size_t> expected_piping;
+
+    for (auto &shape_1 : piping)
+        for (auto &shape_2 : structure)
+            if (are_intersecting (shape_1, shape_2))
+            {
+                expected.emplace_back (shape_1.index(), shape_2.index());
+                expected_piping.insert (shape_1.index());
+            }
+
+    std::sort (expected.begin(), expected.end());
+    ASSERT_FALSE (expected.empty());
+
+    auto check = [&]<typename Broad_Phase>(std::type_identity<Broad_Phase>)
+    {
+        manager_type<Broad_Phase> piping_manager{piping.begin(), piping.end()};
+        manager_type<Broad_Phase> structure_manager{structure.begin(), structure.end()};
+
+        std::vector<index_pair> pairs;
+        piping_manager.for_each_intersecting_pair (structure_manager, [&pairs](const auto &pair)
+        {
+            pairs.emplace_back (pair.first, pair.second);
+        });
+        std::sort (pairs.begin(), pairs.end());
+
+        EXPECT_EQ (pairs, expected);
+
+        piping_manager.intersect_with (structure_manager);
+        EXPECT_EQ (piping_manager.intersecting().indexes(),
+                   std::vector<std::size_t>(expected_piping.begin(), expected_piping.end()));
+    };
+
+    check (std::type_identity<Octree<double>>{});
+    check (std::type_identity<BVH<double>>{});
+}
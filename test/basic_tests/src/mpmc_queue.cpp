@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <cstddef>
+
+#include "mpmc_queue.hpp"
+
+using yLab::MPMC_Queue;
+
+TEST (MPMC_Queue, Capacity)
+{
+    MPMC_Queue<int> queue{5};
+    EXPECT_EQ (queue.capacity(), 8);
+
+    for (auto i = 0; i != 8; ++i)
+        EXPECT_TRUE (queue.try_push (i));
+    EXPECT_FALSE (queue.try_push (8));
+
+    int value;
+    for (auto i = 0; i != 8; ++i)
+    {
+        EXPECT_TRUE (queue.try_pop (value));
+        EXPECT_EQ (value, i);
+    }
+    EXPECT_FALSE (queue.try_pop (value));
+}
+
+TEST (MPMC_Queue, Concurrent)
+{
+    constexpr std::size_t n_threads = 4;
+    constexpr std::size_t n_values = 20000;
+
+    MPMC_Queue<std::size_t> queue{64};
+    std::atomic<std::size_t> sum{0};
+    std::atomic<std::size_t> n_popped{0};
+
+    std::vector<std::thread> threads;
+
+    for (std::size_t i = 0; i != n_threads; ++i)
+        threads.emplace_back ([&queue]
+        {
+            for (std::size_t value = 1; value <= n_values; ++value)
+                while (!queue.try_push (value))
+                    std::this_thread::yield();
+        });
+
+    for (std::size_t i = 0; i != n_threads; ++i)
+        threads.emplace_back ([&]
+        {
+            std::size_t value;
+            while (n_popped.load() != n_threads * n_values)
+            {
+                if (queue.try_pop (value))
+                {
+                    sum += value;
+                    ++n_popped;
+                }
+                else
+                    std::this_thread::yield();
+            }
+        });
+
+    for (auto &thread : threads)
+        thread.join();
+
+    EXPECT_EQ (sum.load(), n_threads * n_values * (n_values + 1) / 2);
+}
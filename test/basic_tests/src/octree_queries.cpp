@@ -0,0 +1,374 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <array>
+#include <type_traits>
+#include <stdexcept>
+#include <iterator>
+#include <cstddef>
+
+#include "octree.hpp"
+
+using namespace yLab::geometry;
+
+namespace
+{
+
+using shape_type = Indexed_Shape<double>;
+using point_type = Primitive_Traits<double>::point_type;
+using triangle_type = Primitive_Traits<double>::triangle_type;
+
+std::vector<shape_type> random_triangles (std::size_t n_shapes, double world_size,
+                                          double max_shape_size, unsigned seed)
+{
+    std::mt19937_64 gen{seed};
+    std::uniform_real_distribution<double> coordinate (-world_size, world_size);
+    std::uniform_real_distribution<double> offset (-max_shape_size, max_shape_size);
+
+    std::vector<shape_type> shapes;
+    shapes.reserve (n_shapes);
+
+    for (std::size_t i = 0; i != n_shapes; ++i)
+    {
+        point_type center{coordinate (gen), coordinate (gen), coordinate (gen)};
+
+        auto vertex = [&]
+        {
+            return point_type{center.x() + offset (gen), center.y() + offset (gen),
+                              center.z() + offset (gen)};
+        };
+
+        shapes.emplace_back (triangle_type{vertex(), vertex(), vertex()}, i);
+    }
+
+    return shapes;
+}
+
+} // unnamed namespace
+
+TEST (Octree, Ray_Cast)
+{
+    using ray_type = Ray<double>;
+    using hit_type = Ray_Hit<double>;
+
+    auto shapes = random_triangles (2000, 50.0, 4.0, 17);
+    Octree<double> octree{shapes.begin(), shapes.end()};
+
+    auto brute_force_hits = [&shapes](const ray_type &ray)
+    {
+        std::vector<hit_type> hits;
+
+        for (auto &shape : shapes)
+        {
+            std::array<double, 3> min{shape.left_bound (0), shape.left_bound (1),
+                                      shape.left_bound (2)};
+            std::array<double, 3> max{shape.right_bound (0), shape.right_bound (1),
+                                      shape.right_bound (2)};
+
+            auto [t_enter, t_exit] = ray.clip (min, max);
+            double t;
+            if (t_enter <= t_exit && detail::hit_shape (ray, shape, t_enter, t_exit, t))
+                hits.push_back (hit_type{shape.index(), t});
+        }
+
+        return hits;
+    };
+
+    std::mt19937_64 gen{18};
+    std::uniform_real_distribution<double> coordinate (-60.0, 60.0);
+    auto random_point = [&]
+    {
+        return point_type{coordinate (gen), coordinate (gen), coordinate (gen)};
+    };
+
+    std::size_t n_hit = 0;
+
+    for (auto i = 0; i != 200; ++i)
+    {
+        auto P = random_point();
+        auto Q = random_point();
+
+        auto ray = (i % 2) ? ray_type{Primitive_Traits<double>::segment_type{P, Q}}
+                           : ray_type{P, Vector<double>{P, Q}};
+
+        auto expected = brute_force_hits (ray);
+
+        std::vector<std::size_t> expected_indexes;
+        for (auto &hit : expected)
+            expected_indexes.push_back (hit.index);
+        std::sort (expected_indexes.begin(), expected_indexes.end());
+
+        std::vector<std::size_t> indexes;
+        octree.for_each_hit (ray, [&indexes](const hit_type &hit)
+        {
+            indexes.push_back (hit.index);
+        });
+        std::sort (indexes.begin(), indexes.end());
+
+        EXPECT_EQ (indexes, expected_indexes);
+
+        auto nearest = octree.cast (ray);
+        ASSERT_EQ (nearest.has_value(), !expected.empty());
+
+        if (nearest)
+        {
+            auto expected_nearest = std::min_element (expected.begin(), expected.end(),
+                                                      [](auto &lhs, auto &rhs)
+            {
+                return lhs.t < rhs.t;
+            });
+            EXPECT_NEAR (nearest->t, expected_nearest->t, 1e-6);
+            EXPECT_GE (nearest->t, 0.0);
+            ++n_hit;
+        }
+    }
+
+    EXPECT_GT (n_hit, 0);
+
+    EXPECT_THROW ((ray_type{point_type{}, Vector<double>{}}), Degenerate_Ray);
+}
+
+TEST (Octree, Ray_Packet)
+{
+    using ray_type = Ray<double>;
+    using segment_type = Primitive_Traits<double>::segment_type;
+    using triangle_type = Primitive_Traits<double>::triangle_type;
+
+    auto shapes = random_triangles (2000, 50.0, 4.0, 19);
+
+    // A ray in the plane of a triangle and a ray through its vertex go to the scalar test
+    shapes.emplace_back (triangle_type{point_type{60, 60, 0}, point_type{70, 60, 0},
+                                       point_type{60, 70, 0}}, shapes.size());
+    Octree<double> octree{shapes.begin(), shapes.end()};
+
+    std::mt19937_64 gen{20};
+    std::uniform_real_distribution<double> coordinate (-60.0, 60.0);
+    std::uniform_real_distribution<double> spread (-5.0, 5.0);
+
+    auto check = [&octree]<std::size_t N>(const std::vector<ray_type> &rays,
+                                          std::integral_constant<std::size_t, N>)
+    {
+        Ray_Packet<double, N> packet{rays.begin(), rays.end()};
+        auto hits = octree.cast (packet);
+
+        for (std::size_t lane = 0; lane != N; ++lane)
+        {
+            if (lane >= rays.size())
+            {
+                EXPECT_FALSE (hits[lane].has_value());
+                continue;
+            }
+
+            auto expected = octree.cast (rays[lane]);
+            ASSERT_EQ (hits[lane].has_value(), expected.has_value());
+
+            if (expected)
+            {
+                EXPECT_EQ (hits[lane]->index, expected->index);
+                EXPECT_NEAR (hits[lane]->t, expected->t, 1e-6);
+            }
+        }
+    };
+
+    // Coherent rays: every packet fans out of one origin towards one region
+    for (auto i = 0; i != 100; ++i)
+    {
+        point_type origin{coordinate (gen), coordinate (gen), coordinate (gen)};
+        point_type target{coordinate (gen), coordinate (gen), coordinate (gen)};
+
+        std::vector<ray_type> rays;
+        for (auto lane = 0; lane != 16; ++lane)
+        {
+            point_type end{target.x() + spread (gen), target.y() + spread (gen),
+                           target.z() + spread (gen)};
+            rays.emplace_back (segment_type{origin, end});
+        }
+
+        check (rays, std::integral_constant<std::size_t, 16>{});
+
+        rays.erase (rays.begin() + 5 + i % 4, rays.end());
+        check (rays, std::integral_constant<std::size_t, 8>{});
+    }
+
+    std::vector<ray_type> special{ray_type{point_type{55, 62, 0}, Vector<double>{1, 0, 0}},
+                                  ray_type{point_type{70, 60, 5}, Vector<double>{0, 0, -1}},
+                                  ray_type{point_type{62, 62, 5}, Vector<double>{0, 0, -1}}};
+    check (special, std::integral_constant<std::size_t, 8>{});
+
+    Ray_Packet<double, 8> packet{special.begin(), special.end()};
+    auto hits = octree.cast (packet);
+    for (auto lane : {0, 2})
+    {
+        ASSERT_TRUE (hits[lane].has_value());
+        EXPECT_EQ (hits[lane]->index, shapes.size() - 1);
+    }
+    EXPECT_NEAR (hits[0]->t, 5.0, 1e-6);
+    EXPECT_NEAR (hits[2]->t, 5.0, 1e-6);
+
+    std::vector<ray_type> too_many (9, special.front());
+    EXPECT_THROW ((Ray_Packet<double, 8>{too_many.begin(), too_many.end()}),
+                  std::invalid_argument);
+}
+
+TEST (Octree, Nearest)
+{
+    using neighbour_type = Neighbour<double>;
+
+    auto shapes = random_triangles (2000, 50.0, 4.0, 21);
+    Octree<double> octree{shapes.begin(), shapes.end()};
+
+    auto brute_force_nearest = [&shapes](const point_type &point, std::size_t k)
+    {
+        std::vector<neighbour_type> neighbours;
+
+        for (auto &shape : shapes)
+        {
+            auto nearest_point = detail::closest_point_of_shape (point, shape);
+            neighbours.push_back (neighbour_type{shape.index(), distance (point, nearest_point),
+                                                 nearest_point});
+        }
+
+        std::sort (neighbours.begin(), neighbours.end(), [](auto &lhs, auto &rhs)
+        {
+            return lhs.distance < rhs.distance;
+        });
+        neighbours.resize (std::min (k, neighbours.size()));
+
+        return neighbours;
+    };
+
+    std::mt19937_64 gen{22};
+    std::uniform_real_distribution<double> coordinate (-70.0, 70.0);
+
+    std::vector<point_type> points;
+    for (auto i = 0; i != 200; ++i)
+        points.emplace_back (coordinate (gen), coordinate (gen), coordinate (gen));
+
+    for (auto &point : points)
+    {
+        auto expected = brute_force_nearest (point, 5);
+        auto neighbours = octree.nearest (point, 5);
+
+        ASSERT_EQ (neighbours.size(), expected.size());
+        for (auto i = 0u; i != expected.size(); ++i)
+        {
+            EXPECT_EQ (neighbours[i].index, expected[i].index);
+            EXPECT_NEAR (neighbours[i].distance, expected[i].distance, 1e-9);
+            EXPECT_EQ (neighbours[i].point, expected[i].point);
+        }
+    }
+
+    auto batch = octree.closest (points.begin(), points.end(), 4);
+    ASSERT_EQ (batch.size(), points.size());
+
+    for (auto i = 0u; i != points.size(); ++i)
+    {
+        ASSERT_TRUE (batch[i].has_value());
+        EXPECT_EQ (batch[i]->index, brute_force_nearest (points[i], 1).front().index);
+    }
+
+    EXPECT_TRUE (octree.nearest (points.front(), 0).empty());
+    EXPECT_EQ (octree.nearest (points.front(), 3000).size(), shapes.size());
+
+    // A point on a triangle is at zero distance from it
+    auto &triangle = std::get<triangle_type> (shapes[7].primitive());
+    auto on_triangle = octree.closest (triangle.P());
+    ASSERT_TRUE (on_triangle.has_value());
+    EXPECT_NEAR (on_triangle->distance, 0.0, 1e-12);
+}
+
+TEST (Octree, Range_Query)
+{
+    using box_type = AABB<double>;
+    using segment_type = Primitive_Traits<double>::segment_type;
+
+    auto shapes = random_triangles (3000, 50.0, 4.0, 23);
+    shapes.emplace_back (point_type{1.0, 1.0, 1.0}, shapes.size());
+    shapes.emplace_back (segment_type{point_type{-1.0, 0.5, 0.5}, point_type{3.0, 0.5, 0.5}},
+                         shapes.size());
+    Octree<double> octree{shapes.begin(), shapes.end()};
+
+    auto brute_force = [&shapes](const box_type &box, Primitive_Kinds kinds)
+    {
+        detail::Query_Box<double> query_box{box};
+        std::vector<std::size_t> indexes;
+
+        for (auto &shape : shapes)
+            if (detail::is_shape_in_box (shape, query_box, kinds))
+                indexes.push_back (shape.index());
+
+        return indexes;
+    };
+
+    std::mt19937_64 gen{24};
+    std::uniform_real_distribution<double> coordinate (-55.0, 55.0);
+    std::uniform_real_distribution<double> halfwidth (0.5, 15.0);
+
+    std::vector<box_type> boxes;
+    for (auto i = 0; i != 100; ++i)
+        boxes.emplace_back (point_type{coordinate (gen), coordinate (gen), coordinate (gen)},
+                            halfwidth (gen), halfwidth (gen), halfwidth (gen));
+
+    std::size_t n_found = 0;
+
+    for (auto &box : boxes)
+    {
+        std::vector<std::size_t> indexes (shapes.size());
+        auto end = octree.query (box, indexes.begin());
+        indexes.erase (end, indexes.end());
+        std::sort (indexes.begin(), indexes.end());
+
+        EXPECT_EQ (indexes, brute_force (box, Primitive_Kinds::all));
+        n_found += indexes.size();
+    }
+
+    EXPECT_GT (n_found, 0);
+
+    auto batch = octree.query (boxes.begin(), boxes.end(), 3);
+    ASSERT_EQ (batch.size(), boxes.size());
+
+    for (auto i = 0u; i != boxes.size(); ++i)
+    {
+        std::sort (batch[i].begin(), batch[i].end());
+        EXPECT_EQ (batch[i], brute_force (boxes[i], Primitive_Kinds::all));
+    }
+
+    // Filters by the kind of primitives
+    box_type unit_box{point_type{0.5, 0.5, 0.5}, 0.5, 0.5, 0.5};
+    std::vector<std::size_t> found;
+
+    octree.query (unit_box, std::back_inserter (found),
+                  Primitive_Kinds::points | Primitive_Kinds::segments);
+    std::sort (found.begin(), found.end());
+    EXPECT_EQ (found, (std::vector<std::size_t>{shapes.size() - 2, shapes.size() - 1}));
+
+    found.clear();
+    octree.query (unit_box, std::back_inserter (found), Primitive_Kinds::none);
+    EXPECT_TRUE (found.empty());
+}
+
+TEST (Octree, Triangle_In_Box)
+{
+    detail::Query_Box<double> box{AABB<double>{point_type{0.0, 0.0, 0.0}, 1.0, 1.0, 1.0}};
+
+    // No vertex lies in the box but the triangle crosses it
+    triangle_type crossing{point_type{-5.0, -5.0, 0.0}, point_type{5.0, -5.0, 0.0},
+                           point_type{0.0, 5.0, 0.0}};
+    EXPECT_TRUE (detail::is_in_box (crossing, box));
+
+    // The bounding box of the triangle overlaps the box but the triangle passes by a corner
+    triangle_type by_corner{point_type{3.5, 0.0, 0.0}, point_type{0.0, 3.5, 0.0},
+                            point_type{0.0, 0.0, 3.5}};
+    EXPECT_FALSE (detail::is_in_box (by_corner, box));
+
+    // The triangle touches a face of the box
+    triangle_type touching{point_type{1.0, -3.0, -3.0}, point_type{1.0, 3.0, -3.0},
+                           point_type{1.0, 0.0, 3.0}};
+    EXPECT_TRUE (detail::is_in_box (touching, box));
+
+    triangle_type far{point_type{1.5, -3.0, -3.0}, point_type{1.5, 3.0, -3.0},
+                      point_type{1.5, 0.0, 3.0}};
+    EXPECT_FALSE (detail::is_in_box (far, box));
+}
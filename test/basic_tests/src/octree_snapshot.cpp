@@ -0,0 +1,239 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+#include <random>
+#include <string>
+#include <fstream>
+#include <filesystem>
+#include <cstdint>
+#include <cstddef>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "collision_manager.hpp"
+#include "octree_snapshot.hpp"
+
+using namespace yLab::geometry;
+
+namespace
+{
+
+using shape_type = Indexed_Shape<double>;
+using point_type = Primitive_Traits<double>::point_type;
+using segment_type = Primitive_Traits<double>::segment_type;
+using triangle_type = Primitive_Traits<double>::triangle_type;
+using snapshot_type = Octree_Snapshot<double>;
+
+std::vector<shape_type> random_shapes (std::size_t n_shapes, unsigned seed)
+{
+    std::mt19937_64 gen{seed};
+    std::uniform_real_distribution<double> coordinate (-50.0, 50.0);
+    std::uniform_real_distribution<double> offset (-5.0, 5.0);
+
+    std::vector<shape_type> shapes;
+    shapes.reserve (n_shapes);
+
+    for (std::size_t i = 0; i != n_shapes; ++i)
+    {
+        point_type P{coordinate (gen), coordinate (gen), coordinate (gen)};
+        auto vertex = [&]
+        {
+            return point_type{P.x() + offset (gen), P.y() + offset (gen), P.z() + offset (gen)};
+        };
+
+        if (i % 10 == 0)
+            shapes.emplace_back (P, i);
+        else if (i % 10 == 1)
+            shapes.emplace_back (segment_type{P, vertex()}, i);
+        else
+            shapes.emplace_back (triangle_type{P, vertex(), vertex()}, i);
+    }
+
+    return shapes;
+}
+
+struct Temporary_File final
+{
+    std::string path;
+
+    explicit Temporary_File (const std::string &name)
+                            : path{(std::filesystem::temp_directory_path() / name).string()} {}
+    ~Temporary_File () { std::filesystem::remove (path); }
+};
+
+constexpr Scene_Stamp scene{12345, 67890};
+
+} // unnamed namespace
+
+TEST (Octree_Snapshot, Round_Trip)
+{
+    auto shapes = random_shapes (2000, 1);
+    Linear_Octree<double> tree{shapes.begin(), shapes.end()};
+
+    Temporary_File file{"round_trip.snapshot"};
+    snapshot_type::write (file.path, tree, shapes.size(), scene);
+
+    snapshot_type snapshot{file.path, scene};
+    EXPECT_NO_THROW (snapshot.verify());
+    EXPECT_EQ (snapshot.n_indexes(), shapes.size());
+    ASSERT_EQ (snapshot.nodes().size(), tree.size());
+
+    for (std::size_t node_i = 0; node_i != tree.size(); ++node_i)
+    {
+        EXPECT_EQ (snapshot.nodes()[node_i].code, tree.nodes()[node_i].code);
+        EXPECT_EQ (snapshot.nodes()[node_i].first_shape, tree.nodes()[node_i].first_shape);
+    }
+
+    auto view = snapshot.view();
+    ASSERT_EQ (view.shapes().size(), tree.shapes().size());
+    for (std::size_t shape_i = 0; shape_i != shapes.size(); ++shape_i)
+    {
+        auto &record = view.shapes()[shape_i];
+        snapshot_type::record_type expected{tree.shapes()[shape_i]};
+
+        EXPECT_EQ (record.index(), expected.index());
+        EXPECT_EQ (record.kind(), expected.kind());
+        for (auto i = 0u; i != 3; ++i)
+        {
+            EXPECT_EQ (record.left_bound (i), expected.left_bound (i));
+            EXPECT_EQ (record.right_bound (i), expected.right_bound (i));
+        }
+    }
+
+    // The records are traversed in place
+    EXPECT_EQ (static_cast<const void *>(view.shapes().data()),
+               static_cast<const void *>(snapshot.records().data()));
+
+    using record_type = snapshot_type::record_type;
+
+    Collision_Manager<double, shape_type, Linear_Octree<double>> built{shapes.begin(),
+                                                                       shapes.end()};
+    Collision_Manager<double, record_type, snapshot_type::view_type> cached{snapshot.view(),
+                                                                            snapshot.n_indexes()};
+    built.intersect_all ();
+    cached.intersect_all ();
+
+    EXPECT_EQ (cached.intersecting().indexes(), built.intersecting().indexes());
+}
+
+TEST (Octree_Snapshot, Validation)
+{
+    auto shapes = random_shapes (500, 2);
+    Linear_Octree<double> tree{shapes.begin(), shapes.end()};
+
+    Temporary_File file{"validation.snapshot"};
+    snapshot_type::write (file.path, tree, shapes.size(), scene);
+
+    // Stale scene
+    EXPECT_THROW ((snapshot_type{file.path, Scene_Stamp{12345, 67891}}), Invalid_Snapshot);
+
+    // Another distance type
+    EXPECT_THROW ((Octree_Snapshot<float>{file.path, scene}), Invalid_Snapshot);
+
+    // Truncated file
+    std::filesystem::resize_file (file.path, std::filesystem::file_size (file.path) - 1);
+    EXPECT_THROW ((snapshot_type{file.path, scene}), Invalid_Snapshot);
+
+    // Wrong magic number
+    snapshot_type::write (file.path, tree, shapes.size(), scene);
+    {
+        std::fstream stream{file.path, std::ios::in | std::ios::out | std::ios::binary};
+        stream.write ("XX", 2);
+    }
+    EXPECT_THROW ((snapshot_type{file.path, scene}), Invalid_Snapshot);
+
+    EXPECT_THROW ((snapshot_type{file.path + ".missing", scene}), Invalid_Snapshot);
+}
+
+// Nodes are checked against the arrays while loading and records by verify ()
+TEST (Octree_Snapshot, Corrupted_Arrays)
+{
+    using header_type = snapshot_type::header_type;
+    using node_type = snapshot_type::node_type;
+    using record_type = snapshot_type::record_type;
+
+    auto shapes = random_shapes (3000, 3);
+    Linear_Octree<double> tree{shapes.begin(), shapes.end()};
+    ASSERT_GT (tree.size(), 1);
+
+    Temporary_File file{"corrupted.snapshot"};
+
+    // Writes a fresh snapshot and overwrites the given bytes of it
+    auto corrupt = [&](std::uint64_t offset, const void *bytes, std::size_t n_bytes)
+    {
+        snapshot_type::write (file.path, tree, shapes.size(), scene);
+
+        std::fstream stream{file.path, std::ios::in | std::ios::out | std::ios::binary};
+        stream.seekp (static_cast<std::streamoff>(offset));
+        stream.write (static_cast<const char *>(bytes), static_cast<std::streamsize>(n_bytes));
+    };
+
+    header_type header;
+    snapshot_type::write (file.path, tree, shapes.size(), scene);
+    {
+        std::ifstream stream{file.path, std::ios::binary};
+        stream.read (reinterpret_cast<char *>(&header), sizeof (header_type));
+    }
+
+    auto node_offset = [&](std::size_t node_i, std::size_t field_offset)
+    {
+        return header.nodes_offset + node_i * sizeof (node_type) + field_offset;
+    };
+
+    // Shapes of a node outside the records
+    std::uint32_t n_shapes = static_cast<std::uint32_t>(shapes.size() + 1);
+    corrupt (node_offset (0, offsetof (node_type, n_shapes)), &n_shapes, sizeof (n_shapes));
+    EXPECT_THROW ((snapshot_type{file.path, scene}), Invalid_Snapshot);
+
+    // Children of the root outside the nodes
+    std::uint32_t first_child = static_cast<std::uint32_t>(tree.size());
+    corrupt (node_offset (0, offsetof (node_type, first_child)), &first_child,
+             sizeof (first_child));
+    EXPECT_THROW ((snapshot_type{file.path, scene}), Invalid_Snapshot);
+
+    // A child with a wrong code
+    std::uint64_t code = 2;
+    corrupt (node_offset (1, offsetof (node_type, code)), &code, sizeof (code));
+    EXPECT_THROW ((snapshot_type{file.path, scene}), Invalid_Snapshot);
+
+    // An array that doesn't fit in the file, with a count that overflows the size check
+    std::uint64_t n_nodes = std::uint64_t{1} << 60;
+    corrupt (offsetof (header_type, n_nodes), &n_nodes, sizeof (n_nodes));
+    EXPECT_THROW ((snapshot_type{file.path, scene}), Invalid_Snapshot);
+
+    // Records are only checked by verify (). A record of garbage: all bytes set make NaN bounds
+    std::vector<unsigned char> garbage (sizeof (record_type), 0xff);
+    corrupt (header.records_offset, garbage.data(), garbage.size());
+    {
+        snapshot_type snapshot{file.path, scene};
+        EXPECT_THROW (snapshot.verify(), Invalid_Snapshot);
+    }
+
+    // Records with indexes out of range
+    snapshot_type::write (file.path, tree, shapes.size() / 2, scene);
+    {
+        snapshot_type snapshot{file.path, scene};
+        EXPECT_THROW (snapshot.verify(), Invalid_Snapshot);
+    }
+}
+
+TEST (Octree_Snapshot, Scene_Stamp)
+{
+    Temporary_File file{"scene.txt"};
+    std::ofstream{file.path} << "1\n0 0 0 1 0 0 0 1 0\n";
+
+    auto fd = open (file.path.c_str(), O_RDONLY);
+    ASSERT_GE (fd, 0);
+
+    auto stamp = Scene_Stamp::of (fd);
+    close (fd);
+
+    EXPECT_EQ (stamp.size, std::filesystem::file_size (file.path));
+
+    int pipe_fds[2];
+    ASSERT_EQ (pipe (pipe_fds), 0);
+    EXPECT_THROW (Scene_Stamp::of (pipe_fds[0]), Invalid_Snapshot);
+    close (pipe_fds[0]);
+    close (pipe_fds[1]);
+}
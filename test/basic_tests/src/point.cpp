@@ -68,3 +68,20 @@ TEST (Points, Validity)
 
     EXPECT_TRUE (Point_3D{0.0}.is_valid());
 }
+
+TEST (Points, Comparison_Policy)
+{
+    Point_3D pt_1 {1.0, 2.0, 3.0};
+    Point_3D pt_2 {1.0, 2.0, 3.0000001};
+
+    EXPECT_TRUE (are_equal (pt_1, pt_2));
+    EXPECT_TRUE (are_equal<yLab::cmp::Tolerant> (pt_1, pt_2));
+    EXPECT_FALSE (are_equal<yLab::cmp::Raw> (pt_1, pt_2));
+    EXPECT_TRUE (are_equal<yLab::cmp::Raw> (pt_1, pt_1));
+
+    Point_2D pt_3 {1.0, 2.0};
+    Point_2D pt_4 {1.0000001, 2.0};
+
+    EXPECT_TRUE (are_equal (pt_3, pt_4));
+    EXPECT_FALSE (are_equal<yLab::cmp::Raw> (pt_3, pt_4));
+}
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <vector>
+#include <cstddef>
+
+#include "result_sink.hpp"
+
+using namespace yLab;
+
+using indexes_type = std::vector<std::size_t>;
+
+TEST (Result_Sink, Bitset)
+{
+    Bitset_Sink sink{200};
+
+    for (auto index : {130, 0, 64, 63, 130, 199, 0})
+        sink.insert (index);
+
+    EXPECT_EQ (sink.size(), 5);
+    EXPECT_TRUE (sink.contains (63));
+    EXPECT_FALSE (sink.contains (62));
+    EXPECT_EQ (sink.indexes(), (indexes_type{0, 63, 64, 130, 199}));
+}
+
+TEST (Result_Sink, Set)
+{
+    Set_Sink sink{0};
+
+    for (auto index : {130, 0, 64, 63, 130, 199, 0})
+        sink.insert (index);
+
+    EXPECT_EQ (sink.size(), 5);
+    EXPECT_TRUE (sink.contains (63));
+    EXPECT_FALSE (sink.contains (62));
+    EXPECT_EQ (sink.indexes(), (indexes_type{0, 63, 64, 130, 199}));
+}
+
+TEST (Result_Sink, Buffer)
+{
+    Bitset_Sink sink{5000};
+
+    {
+        Sink_Buffer buffer{sink};
+        for (std::size_t index = 0; index != 5000; index += 2)
+            buffer.insert (index);
+    }
+
+    EXPECT_EQ (sink.size(), 2500);
+    EXPECT_TRUE (sink.contains (4998));
+}
+
+TEST (Result_Sink, Dump)
+{
+    Bitset_Sink sink{100000};
+    std::ostringstream expected;
+
+    for (std::size_t index = 3; index < 100000; index += 7)
+    {
+        sink.insert (index);
+        expected << index << " ";
+    }
+    expected << std::endl;
+
+    std::ostringstream os;
+    sink.dump (os);
+
+    EXPECT_EQ (os.str(), expected.str());
+
+    std::ostringstream empty;
+    Bitset_Sink{10}.dump (empty);
+
+    EXPECT_EQ (empty.str(), "\n");
+}
+
+TEST (Result_Sink, Dump_Full_Chunk)
+{
+    // An index of 16 bytes and 3120 indexes of 21 bytes fill a chunk of 65536 bytes exactly,
+    // which leaves no room for the final new line
+    Set_Sink sink{0};
+    std::ostringstream expected;
+
+    std::size_t first = 100'000'000'000'000;
+    sink.insert (first);
+    expected << first << " ";
+
+    for (std::size_t index = 10'000'000'000'000'000'000u; index != 10'000'000'000'000'003'120u;
+         ++index)
+    {
+        sink.insert (index);
+        expected << index << " ";
+    }
+    expected << std::endl;
+
+    std::ostringstream os;
+    sink.dump (os);
+
+    EXPECT_EQ (os.str(), expected.str());
+}
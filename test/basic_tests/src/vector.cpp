@@ -198,3 +198,25 @@ TEST (Vectors, Ctor_From_Points)
     Vector null{0.0};
     EXPECT_TRUE (vec == null);
 }
+
+TEST (Vectors, Raw_Comparison)
+{
+    using raw_vector = Vector<double, yLab::cmp::Raw>;
+
+    // The same edge cases keep the results of floating-point arithmetic
+    Point_3D remote_pt_1{100000001.0};
+    Point_3D remote_pt_2{100000000.0};
+    raw_vector vec{remote_pt_1, remote_pt_2};
+    EXPECT_FALSE (vec == raw_vector{0.0});
+    EXPECT_TRUE ((vec == raw_vector{-1.0}));
+    EXPECT_TRUE (vec + raw_vector{1.0} == raw_vector{0.0});
+    EXPECT_FALSE (vec + raw_vector{1.0 + 1e-10} == raw_vector{0.0});
+
+    raw_vector e_1{1.0, 0.0, 0.0};
+    raw_vector e_2{0.0, 1.0, 0.0};
+    EXPECT_TRUE ((vector_product (e_1, e_2) == raw_vector{0.0, 0.0, 1.0}));
+    EXPECT_TRUE (are_orthogonal (e_1, e_2));
+    EXPECT_FALSE (are_orthogonal (e_1, raw_vector{1e-10, 1.0, 0.0}));
+    EXPECT_FALSE (are_collinear (e_1, raw_vector{1.0, 1e-10, 0.0}));
+    EXPECT_TRUE (are_collinear (e_1, e_1 * 3.0));
+}
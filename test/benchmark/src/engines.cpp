@@ -0,0 +1,424 @@
+#include <benchmark/benchmark.h>
+
+#include "collision_manager.hpp"
+#include "sweep_and_prune.hpp"
+#include "bounding_volume_hierarchy.hpp"
+#include "uniform_grid.hpp"
+#include "loose_octree.hpp"
+#include "adaptive_octree.hpp"
+#include "linear_octree.hpp"
+#include "shape_record.hpp"
+#include "ray.hpp"
+
+#include "scenes.hpp"
+
+using namespace yLab::geometry;
+
+namespace
+{
+
+using scenes::distance_type;
+using scenes::shape_type;
+
+template<typename Broad_Phase>
+using collision_manager = Collision_Manager<distance_type, shape_type, Broad_Phase>;
+
+using octree          = Octree<distance_type>;
+using sweep_and_prune = Sweep_And_Prune<distance_type>;
+using bvh             = BVH<distance_type>;
+using uniform_grid    = Uniform_Grid<distance_type>;
+using loose_octree    = Loose_Octree<distance_type>;
+using adaptive_octree = Adaptive_Octree<distance_type>;
+using linear_octree   = Linear_Octree<distance_type>;
+
+template<typename Broad_Phase, auto scene>
+void construction (benchmark::State &state)
+{
+    auto shapes = scene (state.range (0));
+
+    for (auto _ : state)
+    {
+        Broad_Phase engine{shapes.begin(), shapes.end()};
+        benchmark::DoNotOptimize (engine);
+    }
+
+    state.SetItemsProcessed (state.iterations() * state.range (0));
+}
+
+template<typename Broad_Phase, auto scene>
+void intersection (benchmark::State &state)
+{
+    auto shapes = scene (state.range (0));
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        collision_manager<Broad_Phase> manager{shapes.begin(), shapes.end()};
+        state.ResumeTiming();
+
+        manager.intersect_all();
+        benchmark::DoNotOptimize (manager.intersecting());
+    }
+
+    state.SetItemsProcessed (state.iterations() * state.range (0));
+}
+
+// Bulk construction of the linear octree on range (1) threads
+template<auto scene>
+void bulk_construction (benchmark::State &state)
+{
+    auto shapes = scene (state.range (0));
+    auto n_threads = static_cast<std::size_t>(state.range (1));
+    auto height = linear_octree::default_height (shapes.size());
+
+    for (auto _ : state)
+    {
+        linear_octree engine{shapes.begin(), shapes.end(), height, n_threads};
+        benchmark::DoNotOptimize (engine);
+    }
+
+    state.SetItemsProcessed (state.iterations() * state.range (0));
+}
+
+// Intersection in any-hit mode; the counter shows the share of candidates which reach
+// the narrow phase
+template<typename Broad_Phase, auto scene>
+void any_hit (benchmark::State &state)
+{
+    auto shapes = scene (state.range (0));
+    std::size_t n_tests = 0;
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        collision_manager<Broad_Phase> manager{shapes.begin(), shapes.end()};
+        state.ResumeTiming();
+
+        n_tests = manager.intersect_any();
+        benchmark::DoNotOptimize (manager.intersecting());
+    }
+
+    std::size_t n_candidates = 0;
+    auto count = [&n_candidates](const shape_type &, const shape_type &) { ++n_candidates; };
+    Broad_Phase{shapes.begin(), shapes.end()}.for_each_candidate (count);
+
+    state.counters["narrow_phase_share"] = static_cast<double>(n_tests) / n_candidates;
+    state.SetItemsProcessed (state.iterations() * state.range (0));
+}
+
+// Intersection with the octree over shapes of the given type; the counters show the size
+// of a shape and the bytes the octree keeps for it
+template<typename Shape, auto scene>
+void shape_footprint (benchmark::State &state)
+{
+    auto scene_shapes = scene (state.range (0));
+    std::vector<Shape> shapes (scene_shapes.begin(), scene_shapes.end());
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        Collision_Manager<distance_type, Shape, Octree<distance_type, Shape>> manager{
+            shapes.begin(), shapes.end()};
+        state.ResumeTiming();
+
+        manager.intersect_all();
+        benchmark::DoNotOptimize (manager.intersecting());
+    }
+
+    using store_type = typename Octree<distance_type, Shape>::store_type;
+
+    state.counters["bytes_per_shape"] = sizeof (Shape);
+    state.counters["stored_bytes_per_shape"] = store_type::shape_size() +
+                                               sizeof (typename store_type::slot_type);
+    state.SetItemsProcessed (state.iterations() * state.range (0));
+}
+
+// Clash detection between two halves of a scene: dual traversal of two engines
+template<typename Broad_Phase, auto scene>
+void cross_set (benchmark::State &state)
+{
+    auto shapes = scene (2 * state.range (0));
+    auto middle = shapes.begin() + state.range (0);
+
+    collision_manager<Broad_Phase> first{shapes.begin(), middle};
+    collision_manager<Broad_Phase> second{middle, shapes.end()};
+
+    for (auto _ : state)
+    {
+        std::size_t n_pairs = 0;
+        first.for_each_intersecting_pair (second, [&n_pairs](const auto &) { ++n_pairs; });
+        benchmark::DoNotOptimize (n_pairs);
+    }
+
+    state.SetItemsProcessed (state.iterations() * 2 * state.range (0));
+}
+
+// The same pairs found by one engine built over both halves
+template<typename Broad_Phase, auto scene>
+void concatenated_set (benchmark::State &state)
+{
+    auto shapes = scene (2 * state.range (0));
+    auto n_first = static_cast<std::size_t>(state.range (0));
+
+    collision_manager<Broad_Phase> manager{shapes.begin(), shapes.end()};
+
+    for (auto _ : state)
+    {
+        std::size_t n_pairs = 0;
+        manager.for_each_intersecting_pair ([&n_pairs, n_first](const auto &pair)
+        {
+            n_pairs += ((pair.first < n_first) != (pair.second < n_first));
+        });
+        benchmark::DoNotOptimize (n_pairs);
+    }
+
+    state.SetItemsProcessed (state.iterations() * 2 * state.range (0));
+}
+
+// Random segments with ends inside the bounding box of the shapes
+std::vector<Ray<distance_type>> random_segments (const std::vector<shape_type> &shapes,
+                                                 std::size_t n_segments)
+{
+    using segment_type = Primitive_Traits<distance_type>::segment_type;
+    using point_type = Primitive_Traits<distance_type>::point_type;
+
+    std::array<std::uniform_real_distribution<distance_type>, 3> coordinate;
+    for (auto i = 0u; i != 3; ++i)
+    {
+        auto [min, max] = std::minmax_element (shapes.begin(), shapes.end(),
+                                               [i](auto &lhs, auto &rhs)
+        {
+            return lhs.left_bound (i) < rhs.left_bound (i);
+        });
+
+        coordinate[i] = std::uniform_real_distribution<distance_type>{min->left_bound (i),
+                                                                      max->right_bound (i)};
+    }
+
+    std::mt19937_64 gen{42};
+    auto random_point = [&]
+    {
+        return point_type{coordinate[0] (gen), coordinate[1] (gen), coordinate[2] (gen)};
+    };
+
+    std::vector<Ray<distance_type>> segments;
+    segments.reserve (n_segments);
+
+    while (segments.size() != n_segments)
+    {
+        auto P = random_point();
+        auto Q = random_point();
+
+        if (!(P == Q))
+            segments.emplace_back (segment_type{P, Q});
+    }
+
+    return segments;
+}
+
+// Line-of-sight queries: the nearest hit of random segments through the octree
+template<auto scene>
+void ray_cast (benchmark::State &state)
+{
+    auto shapes = scene (state.range (0));
+    auto segments = random_segments (shapes, 1 << 12);
+    octree engine{shapes.begin(), shapes.end()};
+
+    for (auto _ : state)
+        for (auto &segment : segments)
+            benchmark::DoNotOptimize (engine.cast (segment));
+
+    state.SetItemsProcessed (state.iterations() * segments.size());
+}
+
+// Coherent segments: every 16 consecutive segments leave one origin for nearby ends, as rays
+// of one sensor do
+std::vector<Ray<distance_type>> coherent_segments (const std::vector<shape_type> &shapes,
+                                                   std::size_t n_segments)
+{
+    using segment_type = Primitive_Traits<distance_type>::segment_type;
+    using point_type = Primitive_Traits<distance_type>::point_type;
+
+    auto targets = random_segments (shapes, n_segments / 16);
+
+    std::mt19937_64 gen{43};
+    std::uniform_real_distribution<distance_type> spread{-0.02, 0.02};
+
+    std::vector<Ray<distance_type>> segments;
+    segments.reserve (n_segments);
+
+    for (auto &target : targets)
+        for (auto i = 0; i != 16; ++i)
+        {
+            auto end = target.point_at (1);
+            auto length = target.direction().module();
+            point_type Q{end.x() + length * spread (gen), end.y() + length * spread (gen),
+                         end.z() + length * spread (gen)};
+
+            segments.emplace_back (segment_type{target.origin(), Q});
+        }
+
+    return segments;
+}
+
+// The same segments cast one by one
+template<auto scene>
+void coherent_cast (benchmark::State &state)
+{
+    auto shapes = scene (state.range (0));
+    auto segments = coherent_segments (shapes, 1 << 12);
+    octree engine{shapes.begin(), shapes.end()};
+
+    for (auto _ : state)
+        for (auto &segment : segments)
+            benchmark::DoNotOptimize (engine.cast (segment));
+
+    state.SetItemsProcessed (state.iterations() * segments.size());
+}
+
+// The same segments cast by packets of N
+template<auto scene, std::size_t N>
+void packet_cast (benchmark::State &state)
+{
+    auto shapes = scene (state.range (0));
+    auto segments = coherent_segments (shapes, 1 << 12);
+    octree engine{shapes.begin(), shapes.end()};
+
+    std::vector<Ray_Packet<distance_type, N>> packets;
+    for (auto first = segments.begin(); first != segments.end(); first += N)
+        packets.emplace_back (first, first + N);
+
+    for (auto _ : state)
+        for (auto &packet : packets)
+            benchmark::DoNotOptimize (engine.cast (packet));
+
+    state.SetItemsProcessed (state.iterations() * segments.size());
+}
+
+// Snapping of random points to the nearest shapes on range (1) threads
+template<auto scene>
+void closest_shapes (benchmark::State &state)
+{
+    auto shapes = scene (state.range (0));
+    auto segments = random_segments (shapes, 1 << 14);
+    auto n_threads = static_cast<std::size_t>(state.range (1));
+    octree engine{shapes.begin(), shapes.end()};
+
+    std::vector<Primitive_Traits<distance_type>::point_type> points;
+    for (auto &segment : segments)
+        points.push_back (segment.origin());
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize (engine.closest (points.begin(), points.end(), n_threads));
+
+    state.SetItemsProcessed (state.iterations() * points.size());
+}
+
+// Region queries by random boxes each expected to hold about 1000 shapes
+template<auto scene>
+void range_query (benchmark::State &state)
+{
+    auto shapes = scene (state.range (0));
+    auto centers = random_segments (shapes, 1 << 10);
+    octree engine{shapes.begin(), shapes.end()};
+
+    std::array<distance_type, 3> halfwidth;
+    for (auto i = 0u; i != 3; ++i)
+    {
+        auto [min, max] = std::minmax_element (shapes.begin(), shapes.end(),
+                                               [i](auto &lhs, auto &rhs)
+        {
+            return lhs.left_bound (i) < rhs.left_bound (i);
+        });
+
+        halfwidth[i] = (max->right_bound (i) - min->left_bound (i)) / 2 *
+                       std::cbrt (std::min (1000.0 / shapes.size(), 1.0));
+    }
+
+    std::vector<std::size_t> indexes (shapes.size());
+    std::size_t n_found = 0;
+
+    for (auto _ : state)
+        for (auto &center : centers)
+        {
+            auto end = engine.query (AABB<distance_type>{center.origin(), halfwidth[0],
+                                                         halfwidth[1], halfwidth[2]},
+                                     indexes.begin());
+            n_found += end - indexes.begin();
+        }
+
+    state.counters["shapes_per_query"] = static_cast<double>(n_found) /
+                                         (state.iterations() * centers.size());
+    state.SetItemsProcessed (state.iterations() * centers.size());
+}
+
+} // unnamed namespace
+
+#define ENGINE_BENCHMARKS(engine)                                                                  \
+BENCHMARK (construction<engine, scenes::uniform>)->RangeMultiplier (10)->Range (1000, 100000)      \
+                                                 ->Unit (benchmark::kMillisecond);                 \
+BENCHMARK (construction<engine, scenes::slabs>)->RangeMultiplier (10)->Range (1000, 100000)        \
+                                               ->Unit (benchmark::kMillisecond);                   \
+BENCHMARK (intersection<engine, scenes::uniform>)->RangeMultiplier (10)->Range (1000, 30000)       \
+                                                 ->Unit (benchmark::kMillisecond);                 \
+BENCHMARK (intersection<engine, scenes::slabs>)->RangeMultiplier (10)->Range (1000, 30000)         \
+                                               ->Unit (benchmark::kMillisecond);                   \
+BENCHMARK (intersection<engine, scenes::clusters>)->RangeMultiplier (10)->Range (1000, 10000)      \
+                                                  ->Unit (benchmark::kMillisecond);                \
+BENCHMARK (intersection<engine, scenes::mesh>)->RangeMultiplier (10)->Range (1000, 30000)          \
+                                              ->Unit (benchmark::kMillisecond);                    \
+BENCHMARK (any_hit<engine, scenes::clusters>)->RangeMultiplier (10)->Range (1000, 10000)           \
+                                             ->Unit (benchmark::kMillisecond)
+
+ENGINE_BENCHMARKS (octree);
+ENGINE_BENCHMARKS (loose_octree);
+ENGINE_BENCHMARKS (adaptive_octree);
+ENGINE_BENCHMARKS (linear_octree);
+ENGINE_BENCHMARKS (sweep_and_prune);
+ENGINE_BENCHMARKS (bvh);
+ENGINE_BENCHMARKS (uniform_grid);
+
+BENCHMARK (bulk_construction<scenes::uniform>)->ArgsProduct ({{100000, 1000000}, {1, 2, 4, 8}})
+                                              ->Unit (benchmark::kMillisecond)->UseRealTime();
+
+BENCHMARK (shape_footprint<shape_type, scenes::uniform>)->RangeMultiplier (10)->Range (1000, 30000)
+                                                       ->Unit (benchmark::kMillisecond);
+BENCHMARK (shape_footprint<Shape_Record<distance_type>, scenes::uniform>)
+    ->RangeMultiplier (10)->Range (1000, 30000)->Unit (benchmark::kMillisecond);
+
+BENCHMARK (cross_set<octree, scenes::uniform>)->RangeMultiplier (10)->Range (1000, 10000)
+                                              ->Unit (benchmark::kMillisecond);
+BENCHMARK (concatenated_set<octree, scenes::uniform>)->RangeMultiplier (10)->Range (1000, 10000)
+                                                     ->Unit (benchmark::kMillisecond);
+BENCHMARK (cross_set<bvh, scenes::uniform>)->RangeMultiplier (10)->Range (1000, 10000)
+                                           ->Unit (benchmark::kMillisecond);
+BENCHMARK (concatenated_set<bvh, scenes::uniform>)->RangeMultiplier (10)->Range (1000, 10000)
+                                                  ->Unit (benchmark::kMillisecond);
+
+BENCHMARK (ray_cast<scenes::uniform>)->RangeMultiplier (10)->Range (1000, 100000)
+                                     ->Unit (benchmark::kMillisecond);
+BENCHMARK (ray_cast<scenes::mesh>)->RangeMultiplier (10)->Range (1000, 100000)
+                                  ->Unit (benchmark::kMillisecond);
+
+BENCHMARK (coherent_cast<scenes::mesh>)->RangeMultiplier (10)->Range (1000, 100000)
+                                       ->Unit (benchmark::kMillisecond);
+BENCHMARK (packet_cast<scenes::mesh, 8>)->RangeMultiplier (10)->Range (1000, 100000)
+                                        ->Unit (benchmark::kMillisecond);
+BENCHMARK (packet_cast<scenes::mesh, 16>)->RangeMultiplier (10)->Range (1000, 100000)
+                                         ->Unit (benchmark::kMillisecond);
+BENCHMARK (coherent_cast<scenes::uniform>)->RangeMultiplier (10)->Range (1000, 100000)
+                                          ->Unit (benchmark::kMillisecond);
+BENCHMARK (packet_cast<scenes::uniform, 8>)->RangeMultiplier (10)->Range (1000, 100000)
+                                           ->Unit (benchmark::kMillisecond);
+BENCHMARK (packet_cast<scenes::uniform, 16>)->RangeMultiplier (10)->Range (1000, 100000)
+                                            ->Unit (benchmark::kMillisecond);
+
+BENCHMARK (closest_shapes<scenes::mesh>)->ArgsProduct ({{1000, 100000}, {1, 4}})
+                                        ->Unit (benchmark::kMillisecond)->UseRealTime();
+BENCHMARK (closest_shapes<scenes::uniform>)->ArgsProduct ({{1000, 100000}, {1, 4}})
+                                           ->Unit (benchmark::kMillisecond)->UseRealTime();
+
+BENCHMARK (range_query<scenes::uniform>)->RangeMultiplier (10)->Range (10000, 1000000)
+                                        ->Unit (benchmark::kMillisecond);
+BENCHMARK (range_query<scenes::mesh>)->RangeMultiplier (10)->Range (10000, 1000000)
+                                     ->Unit (benchmark::kMillisecond);
@@ -0,0 +1,84 @@
+#include <benchmark/benchmark.h>
+
+#include "kernels.hpp"
+
+using namespace yLab::geometry;
+
+namespace
+{
+
+auto keep = [](const auto &result) { benchmark::DoNotOptimize (result); };
+
+template<typename C>
+void vector_products (benchmark::State &state)
+{
+    auto vectors = kernels::random_vectors<C> (kernels::n_samples + 1);
+
+    for (auto _ : state)
+        kernels::vector_products<C> (vectors, keep);
+
+    state.SetItemsProcessed (state.iterations() * kernels::n_samples);
+}
+
+template<typename C>
+void triple_products (benchmark::State &state)
+{
+    auto vectors = kernels::random_vectors<C> (kernels::n_samples + 2);
+
+    for (auto _ : state)
+        kernels::triple_products<C> (vectors, keep);
+
+    state.SetItemsProcessed (state.iterations() * kernels::n_samples);
+}
+
+template<typename Policy>
+void segment_segment_tests (benchmark::State &state)
+{
+    auto pairs = kernels::close_triangles ();
+
+    for (auto _ : state)
+        kernels::segment_segment_tests<Policy> (pairs, keep);
+
+    state.SetItemsProcessed (state.iterations() * kernels::n_samples);
+}
+
+template<typename Policy>
+void triangle_triangle_tests (benchmark::State &state)
+{
+    auto pairs = kernels::close_triangles ();
+
+    for (auto _ : state)
+        kernels::triangle_triangle_tests<Policy> (pairs, keep);
+
+    state.SetItemsProcessed (state.iterations() * kernels::n_samples);
+}
+
+template<std::size_t N>
+void plane_rejection_tests (benchmark::State &state)
+{
+    auto blocks = kernels::close_blocks<N> (kernels::close_triangles ());
+
+    for (auto _ : state)
+        kernels::plane_rejection_tests<N> (blocks, keep);
+
+    state.SetItemsProcessed (state.iterations() * kernels::n_samples);
+}
+
+} // unnamed namespace
+
+BENCHMARK (vector_products<yLab::cmp::Tolerant>);
+BENCHMARK (vector_products<yLab::cmp::Raw>);
+
+BENCHMARK (triple_products<yLab::cmp::Tolerant>);
+BENCHMARK (triple_products<yLab::cmp::Raw>);
+
+BENCHMARK (segment_segment_tests<Tolerant_Predicates>);
+BENCHMARK (segment_segment_tests<Raw_Predicates>);
+BENCHMARK (segment_segment_tests<Exact_Predicates>);
+
+BENCHMARK (triangle_triangle_tests<Tolerant_Predicates>);
+BENCHMARK (triangle_triangle_tests<Raw_Predicates>);
+BENCHMARK (triangle_triangle_tests<Exact_Predicates>);
+
+BENCHMARK (plane_rejection_tests<1>);
+BENCHMARK (plane_rejection_tests<8>);
@@ -0,0 +1,133 @@
+#ifndef TEST_BENCHMARK_KERNELS_HPP
+#define TEST_BENCHMARK_KERNELS_HPP
+
+#include <vector>
+#include <random>
+#include <utility>
+#include <cstddef>
+
+#include "double_comparison.hpp"
+#include "vector.hpp"
+#include "magic_product.hpp"
+#include "segment_segment.hpp"
+#include "triangle_triangle.hpp"
+#include "triangle_block.hpp"
+
+#include "scenes.hpp"
+
+/*
+ * Workloads of the geometric kernels under every comparison and orientation policy. They are
+ * timed by the benchmarks target and by kernel_timings, which doesn't need Google Benchmark.
+ * Every pass calls keep (result) for each of n_samples results, so that they aren't optimised
+ * away.
+ */
+namespace kernels
+{
+
+using scenes::distance_type;
+using scenes::point_type;
+using scenes::triangle_type;
+
+using segment_type = yLab::geometry::Segment<point_type>;
+
+template<typename C>
+using vector_type = yLab::geometry::Vector<distance_type, C>;
+
+using triangle_pair = std::pair<triangle_type, triangle_type>;
+
+constexpr std::size_t n_samples = 4096;
+
+template<typename C>
+std::vector<vector_type<C>> random_vectors (std::size_t n_vectors)
+{
+    std::mt19937_64 gen{42};
+    std::uniform_real_distribution<distance_type> coordinate{-100.0f, 100.0f};
+
+    std::vector<vector_type<C>> vectors;
+    vectors.reserve (n_vectors);
+
+    for (std::size_t i = 0; i != n_vectors; ++i)
+        vectors.emplace_back (coordinate (gen), coordinate (gen), coordinate (gen));
+
+    return vectors;
+}
+
+// Pairs of random triangles in a small world: most of them pass the plane tests
+inline std::vector<triangle_pair> close_triangles ()
+{
+    auto shapes = scenes::random_triangles (2 * n_samples, {5.0f, 5.0f, 5.0f}, {5.0f, 5.0f, 5.0f});
+
+    std::vector<triangle_pair> pairs;
+    pairs.reserve (n_samples);
+
+    for (std::size_t i = 0; i != n_samples; ++i)
+        pairs.emplace_back (std::get<triangle_type>(shapes[2 * i].primitive()),
+                            std::get<triangle_type>(shapes[2 * i + 1].primitive()));
+
+    return pairs;
+}
+
+// One triangle against a block of N triangles; Triangle_Block<T, 1> takes the scalar path
+template<std::size_t N>
+using block_pair = std::pair<triangle_type, yLab::geometry::Triangle_Block<distance_type, N>>;
+
+// The second triangles of N consecutive pairs are tested against the first one of them
+template<std::size_t N>
+std::vector<block_pair<N>> close_blocks (const std::vector<triangle_pair> &pairs)
+{
+    std::vector<block_pair<N>> blocks;
+    blocks.reserve (n_samples / N);
+
+    for (std::size_t i = 0; i != n_samples; i += N)
+    {
+        yLab::geometry::Triangle_Block<distance_type, N> block;
+        for (std::size_t lane = 0; lane != N; ++lane)
+            block.push_back (pairs[i + lane].second);
+
+        blocks.emplace_back (pairs[i].first, block);
+    }
+
+    return blocks;
+}
+
+// vectors has n_samples + 1 elements
+template<typename C, typename K>
+void vector_products (const std::vector<vector_type<C>> &vectors, K keep)
+{
+    for (std::size_t i = 0; i != n_samples; ++i)
+        keep (vector_product (vectors[i], vectors[i + 1]));
+}
+
+// vectors has n_samples + 2 elements
+template<typename C, typename K>
+void triple_products (const std::vector<vector_type<C>> &vectors, K keep)
+{
+    for (std::size_t i = 0; i != n_samples; ++i)
+        keep (triple_product (vectors[i], vectors[i + 1], vectors[i + 2]));
+}
+
+template<typename Policy, typename K>
+void segment_segment_tests (const std::vector<triangle_pair> &pairs, K keep)
+{
+    for (auto &[tr_1, tr_2] : pairs)
+        keep (yLab::geometry::are_intersecting<Policy> (segment_type{tr_1.P(), tr_1.Q()},
+                                                        segment_type{tr_2.P(), tr_2.Q()}));
+}
+
+template<typename Policy, typename K>
+void triangle_triangle_tests (const std::vector<triangle_pair> &pairs, K keep)
+{
+    for (auto &[tr_1, tr_2] : pairs)
+        keep (yLab::geometry::are_intersecting<Policy> (tr_1, tr_2));
+}
+
+template<std::size_t N, typename K>
+void plane_rejection_tests (const std::vector<block_pair<N>> &blocks, K keep)
+{
+    for (auto &[tr, block] : blocks)
+        keep (yLab::geometry::detail::separated_by_planes (tr, block));
+}
+
+} // namespace kernels
+
+#endif // TEST_BENCHMARK_KERNELS_HPP
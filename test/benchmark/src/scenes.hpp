@@ -0,0 +1,125 @@
+#ifndef TEST_BENCHMARK_SCENES_HPP
+#define TEST_BENCHMARK_SCENES_HPP
+
+#include <vector>
+#include <random>
+#include <array>
+#include <cstddef>
+#include <cmath>
+
+#include "primitive_traits.hpp"
+#include "shape.hpp"
+
+namespace scenes
+{
+
+using distance_type = float;
+
+using point_type    = yLab::geometry::Primitive_Traits<distance_type>::point_type;
+using triangle_type = yLab::geometry::Primitive_Traits<distance_type>::triangle_type;
+using shape_type    = yLab::geometry::Indexed_Shape<distance_type>;
+
+/*
+ * Random non-degenerate triangles which bounding boxes are centred in the box
+ * [-world[i]; world[i]] and have halfwidths not greater than max_halfwidth[i]
+ */
+inline std::vector<shape_type> random_triangles (std::size_t n_shapes,
+                                                 const std::array<distance_type, 3> &world,
+                                                 const std::array<distance_type, 3> &max_halfwidth,
+                                                 unsigned seed = 42)
+{
+    using distribution = std::uniform_real_distribution<distance_type>;
+
+    std::mt19937_64 gen{seed};
+    std::array<distribution, 3> center;
+    std::array<distribution, 3> offset;
+
+    for (auto i = 0; i != 3; ++i)
+    {
+        center[i] = distribution{-world[i], world[i]};
+        offset[i] = distribution{-max_halfwidth[i], max_halfwidth[i]};
+    }
+
+    std::vector<shape_type> shapes;
+    shapes.reserve (n_shapes);
+
+    while (shapes.size() != n_shapes)
+    {
+        point_type c{center[0](gen), center[1](gen), center[2](gen)};
+
+        auto vertex = [&]
+        {
+            return point_type{c.x() + offset[0](gen), c.y() + offset[1](gen),
+                              c.z() + offset[2](gen)};
+        };
+
+        try
+        {
+            shapes.emplace_back (triangle_type{vertex(), vertex(), vertex()}, shapes.size());
+        }
+        catch (yLab::geometry::Degenerate_Triangle &)
+        {
+            continue;
+        }
+    }
+
+    return shapes;
+}
+
+// Shapes of similar size spread uniformly through a cubic world (as the generator does)
+inline std::vector<shape_type> uniform (std::size_t n_shapes)
+{
+    return random_triangles (n_shapes, {500.0f, 500.0f, 500.0f}, {5.0f, 5.0f, 5.0f});
+}
+
+// Long thin shapes in a flat world: sheet-metal-like layers
+inline std::vector<shape_type> slabs (std::size_t n_shapes)
+{
+    return random_triangles (n_shapes, {2000.0f, 2000.0f, 10.0f}, {40.0f, 2.0f, 0.5f});
+}
+
+// A few dense clusters of overlapping shapes
+inline std::vector<shape_type> clusters (std::size_t n_shapes)
+{
+    return random_triangles (n_shapes, {50.0f, 50.0f, 50.0f}, {5.0f, 5.0f, 5.0f});
+}
+
+// Triangulated height field: adjacent triangles share edges as in a surface mesh
+inline std::vector<shape_type> mesh (std::size_t n_shapes)
+{
+    constexpr distance_type step = 2.0f;
+
+    auto height = [](distance_type x, distance_type y)
+    {
+        return 20.0f * std::sin (x / 30.0f) * std::cos (y / 30.0f);
+    };
+
+    auto side = static_cast<std::size_t>(std::sqrt (n_shapes / 2.0)) + 1;
+
+    std::vector<shape_type> shapes;
+    shapes.reserve (n_shapes);
+
+    for (std::size_t i = 0; i != side && shapes.size() != n_shapes; ++i)
+    {
+        for (std::size_t j = 0; j != side && shapes.size() != n_shapes; ++j)
+        {
+            auto x = i * step;
+            auto y = j * step;
+
+            point_type P{x,        y,        height (x, y)};
+            point_type Q{x + step, y,        height (x + step, y)};
+            point_type R{x,        y + step, height (x, y + step)};
+            point_type S{x + step, y + step, height (x + step, y + step)};
+
+            shapes.emplace_back (triangle_type{P, Q, R}, shapes.size());
+            if (shapes.size() != n_shapes)
+                shapes.emplace_back (triangle_type{Q, S, R}, shapes.size());
+        }
+    }
+
+    return shapes;
+}
+
+} // namespace scenes
+
+#endif // TEST_BENCHMARK_SCENES_HPP
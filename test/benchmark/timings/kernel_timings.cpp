@@ -0,0 +1,88 @@
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <iomanip>
+#include <string_view>
+
+#include "kernels.hpp"
+
+/*
+ * Times the workloads of kernels.hpp with std::chrono only, for builds without Google Benchmark.
+ * Each kernel runs for about min_time and reports the number of items it processes per second.
+ */
+namespace
+{
+
+using namespace yLab::geometry;
+
+constexpr std::chrono::milliseconds min_time{200};
+
+auto keep = [](const auto &result) { asm volatile ("" : : "g"(&result) : "memory"); };
+
+template<typename Pass>
+void time_kernel (std::string_view name, Pass pass)
+{
+    using clock = std::chrono::steady_clock;
+
+    pass (); // warm-up
+
+    std::size_t n_passes = 0;
+    auto start = clock::now();
+    auto elapsed = clock::duration::zero();
+
+    do
+    {
+        pass ();
+        ++n_passes;
+        elapsed = clock::now() - start;
+    } while (elapsed < min_time);
+
+    auto seconds = std::chrono::duration<double>{elapsed}.count();
+    auto items_per_second = n_passes * kernels::n_samples / seconds;
+
+    std::cout << std::left << std::setw (48) << name << std::right << std::fixed
+              << std::setprecision (1) << std::setw (10) << items_per_second / 1e6 << " M/s\n";
+}
+
+template<typename C>
+void time_products (std::string_view vector_name, std::string_view triple_name)
+{
+    auto vectors = kernels::random_vectors<C> (kernels::n_samples + 2);
+
+    time_kernel (vector_name, [&]{ kernels::vector_products<C> (vectors, keep); });
+    time_kernel (triple_name, [&]{ kernels::triple_products<C> (vectors, keep); });
+}
+
+} // unnamed namespace
+
+int main ()
+{
+    time_products<yLab::cmp::Tolerant> ("vector_products<Tolerant>", "triple_products<Tolerant>");
+    time_products<yLab::cmp::Raw> ("vector_products<Raw>", "triple_products<Raw>");
+
+    auto pairs = kernels::close_triangles ();
+
+    time_kernel ("segment_segment_tests<Tolerant_Predicates>",
+                 [&]{ kernels::segment_segment_tests<Tolerant_Predicates> (pairs, keep); });
+    time_kernel ("segment_segment_tests<Raw_Predicates>",
+                 [&]{ kernels::segment_segment_tests<Raw_Predicates> (pairs, keep); });
+    time_kernel ("segment_segment_tests<Exact_Predicates>",
+                 [&]{ kernels::segment_segment_tests<Exact_Predicates> (pairs, keep); });
+
+    time_kernel ("triangle_triangle_tests<Tolerant_Predicates>",
+                 [&]{ kernels::triangle_triangle_tests<Tolerant_Predicates> (pairs, keep); });
+    time_kernel ("triangle_triangle_tests<Raw_Predicates>",
+                 [&]{ kernels::triangle_triangle_tests<Raw_Predicates> (pairs, keep); });
+    time_kernel ("triangle_triangle_tests<Exact_Predicates>",
+                 [&]{ kernels::triangle_triangle_tests<Exact_Predicates> (pairs, keep); });
+
+    auto scalar_blocks = kernels::close_blocks<1> (pairs);
+    auto blocks = kernels::close_blocks<8> (pairs);
+
+    time_kernel ("plane_rejection_tests<1>",
+                 [&]{ kernels::plane_rejection_tests<1> (scalar_blocks, keep); });
+    time_kernel ("plane_rejection_tests<8>",
+                 [&]{ kernels::plane_rejection_tests<8> (blocks, keep); });
+
+    return 0;
+}
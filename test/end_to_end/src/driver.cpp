@@ -3,8 +3,23 @@
 #include <vector>
 #include <chrono>
 #include <fstream>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include <unistd.h>
 
 #include "collision_manager.hpp"
+#include "sweep_and_prune.hpp"
+#include "bounding_volume_hierarchy.hpp"
+#include "uniform_grid.hpp"
+#include "loose_octree.hpp"
+#include "adaptive_octree.hpp"
+#include "linear_octree.hpp"
+#include "octree_snapshot.hpp"
 
 using distance_type = float;
 
@@ -15,11 +30,95 @@ using segment_type  = yLab::geometry::Primitive_Traits<distance_type>::segment_t
 using triangle_type = yLab::geometry::Primitive_Traits<distance_type>::triangle_type;
 using shape_type    = yLab::geometry::Indexed_Shape<distance_type>;
 
-using collision_manager = yLab::geometry::Collision_Manager<distance_type>;
+using octree          = yLab::geometry::Octree<distance_type>;
+using sweep_and_prune = yLab::geometry::Sweep_And_Prune<distance_type>;
+using bvh             = yLab::geometry::BVH<distance_type>;
+using uniform_grid    = yLab::geometry::Uniform_Grid<distance_type>;
+using loose_octree    = yLab::geometry::Loose_Octree<distance_type>;
+using adaptive_octree = yLab::geometry::Adaptive_Octree<distance_type>;
+using linear_octree   = yLab::geometry::Linear_Octree<distance_type>;
+using snapshot        = yLab::geometry::Octree_Snapshot<distance_type>;
+using snapshot_view   = snapshot::view_type;
+
+template<typename Broad_Phase>
+using collision_manager = yLab::geometry::Collision_Manager<distance_type, shape_type, Broad_Phase>;
+
+using hr_clock = std::chrono::high_resolution_clock;
+using std::chrono::milliseconds;
+using std::chrono::duration_cast;
 
 namespace
 {
 
+struct Options final
+{
+    std::string engine = "octree";
+    bool has_engine = false;
+    std::size_t n_threads = 1;
+    std::size_t n_producers = 0; // 0 means that broad and narrow phases are not pipelined
+    std::size_t n_consumers = 0;
+    bool any_hit = false;
+    std::string snapshot;
+};
+
+std::size_t parse_count (const char *arg, const char *what)
+{
+    auto count = std::atoi (arg);
+    if (count < 0)
+        throw std::runtime_error{std::string{"The number of "} + what +
+                                 " has to be a non-negative integer"};
+
+    return (count == 0) ? std::thread::hardware_concurrency() : static_cast<std::size_t>(count);
+}
+
+/*
+ * --threads N:     the number of threads intersecting shapes; 0 stands for the number of cores
+ * --pipeline P C:  run broad phase on P threads and narrow phase on C threads
+ * --engine E:      broad phase engine: octree (default), loose (loose octree),
+ *                  adaptive (adaptive octree), linear (linear octree),
+ *                  sap (sweep and prune), bvh or grid
+ * --any-hit:       skip exact tests of pairs both shapes of which are known to intersect others
+ * --snapshot F:    use the linear octree saved to file F if it was built for the same scene,
+ *                  otherwise build it and save it to F; stdin has to be redirected from a file.
+ *                  The snapshot always holds a linear octree, so --engine can't be given
+ */
+Options cmd_line_args (int argc, char *argv[])
+{
+    Options options;
+
+    for (auto i = 1; i != argc; ++i)
+    {
+        if (std::strcmp (argv[i], "--threads") == 0 && i + 1 < argc)
+            options.n_threads = parse_count (argv[++i], "threads");
+        else if (std::strcmp (argv[i], "--pipeline") == 0 && i + 2 < argc)
+        {
+            options.n_producers = parse_count (argv[++i], "producers");
+            options.n_consumers = parse_count (argv[++i], "consumers");
+        }
+        else if (std::strcmp (argv[i], "--engine") == 0 && i + 1 < argc)
+        {
+            options.engine = argv[++i];
+            options.has_engine = true;
+            if (options.engine != "octree" && options.engine != "loose" &&
+                options.engine != "adaptive" && options.engine != "linear" &&
+                options.engine != "sap" && options.engine != "bvh" && options.engine != "grid")
+                throw std::runtime_error{"Unknown broad phase engine: " + options.engine};
+        }
+        else if (std::strcmp (argv[i], "--any-hit") == 0)
+            options.any_hit = true;
+        else if (std::strcmp (argv[i], "--snapshot") == 0 && i + 1 < argc)
+            options.snapshot = argv[++i];
+        else
+            throw std::runtime_error{std::string{"Unknown option: "} + argv[i]};
+    }
+
+    if (!options.snapshot.empty() && options.has_engine)
+        throw std::runtime_error{"--snapshot always uses the linear octree and can't be combined "
+                                 "with --engine"};
+
+    return options;
+}
+
 std::vector<point_type> construct_points ()
 {
     auto cin_iter = std::istream_iterator<float>{std::cin};
@@ -89,40 +188,162 @@ std::vector<shape_type> construct_shapes (it first, it last)
     return triangles;
 }
 
+template<typename Manager>
+void intersect_shapes (Manager &collider, const Options &options, std::ostream &time_info)
+{
+    auto intersection_start = hr_clock::now();
+
+    if (options.any_hit)
+        collider.intersect_any (options.n_threads);
+    else if (options.n_producers)
+        collider.intersect_all (options.n_producers, options.n_consumers);
+    else
+        collider.intersect_all (options.n_threads);
+    auto intersection_finish = hr_clock::now();
+
+    collider.show_intersecting();
+    auto output_finish = hr_clock::now();
+
+    time_info << "Intersection                      "
+              << duration_cast<milliseconds>(intersection_finish - intersection_start).count()
+              << " ms" << std::endl
+              << "Output                            "
+              << duration_cast<milliseconds>(output_finish - intersection_finish).count()
+              << " ms" << std::endl;
+
+    if constexpr (requires { collider.broad_phase().depth_histogram(); })
+    {
+        auto histogram = collider.broad_phase().depth_histogram();
+        for (std::size_t depth = 0; depth != histogram.size(); ++depth)
+            time_info << "Shapes at depth " << depth << ": " << histogram[depth] << std::endl;
+    }
+}
+
+template<typename Broad_Phase>
+void intersect_shapes (const std::vector<shape_type> &shapes, const Options &options,
+                       std::ostream &time_info)
+{
+    auto manager_start = hr_clock::now();
+    collision_manager<Broad_Phase> collider {shapes.begin(), shapes.end()};
+    auto manager_finish = hr_clock::now();
+
+    time_info << "Construction of collision manager "
+              << duration_cast<milliseconds>(manager_finish - manager_start).count()
+              << " ms" << std::endl;
+
+    intersect_shapes (collider, options, time_info);
+}
+
+// Returns false if there is no valid snapshot of the scene
+bool intersect_cached_shapes (const Options &options, const yLab::geometry::Scene_Stamp &scene,
+                              std::ostream &time_info)
+{
+    auto loading_start = hr_clock::now();
+
+    try
+    {
+        snapshot cached {options.snapshot, scene};
+        yLab::geometry::Collision_Manager<distance_type, snapshot::record_type, snapshot_view>
+            collider {cached.view(), cached.n_indexes()};
+        auto loading_finish = hr_clock::now();
+
+        // Intersection reads every record anyway, so they are checked before it
+        cached.verify();
+        auto verification_finish = hr_clock::now();
+
+        time_info << "Loading of snapshot               "
+                  << duration_cast<milliseconds>(loading_finish - loading_start).count()
+                  << " ms" << std::endl
+                  << "Verification of records           "
+                  << duration_cast<milliseconds>(verification_finish - loading_finish).count()
+                  << " ms" << std::endl;
+
+        intersect_shapes (collider, options, time_info);
+    }
+    catch (yLab::geometry::Invalid_Snapshot &expt)
+    {
+        time_info << expt.what() << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+void intersect_and_save_shapes (const std::vector<shape_type> &shapes, const Options &options,
+                                const yLab::geometry::Scene_Stamp &scene, std::ostream &time_info)
+{
+    auto manager_start = hr_clock::now();
+    linear_octree tree {shapes.begin(), shapes.end()};
+
+    // A snapshot that can't be saved only costs the next run a rebuild
+    try
+    {
+        snapshot::write (options.snapshot, tree, shapes.size(), scene);
+    }
+    catch (yLab::geometry::Invalid_Snapshot &expt)
+    {
+        time_info << expt.what() << std::endl;
+    }
+
+    collision_manager<linear_octree> collider {std::move (tree), shapes.size()};
+    auto manager_finish = hr_clock::now();
+
+    time_info << "Construction and saving of octree "
+              << duration_cast<milliseconds>(manager_finish - manager_start).count()
+              << " ms" << std::endl;
+
+    intersect_shapes (collider, options, time_info);
+}
+
 } // unnamed namespace
 
-int main ()
+int main (int argc, char *argv[])
 {
-    using std::chrono::milliseconds;
+    Options options;
+    yLab::geometry::Scene_Stamp scene;
+
+    try
+    {
+        options = cmd_line_args (argc, argv);
+        if (!options.snapshot.empty())
+            scene = yLab::geometry::Scene_Stamp::of (STDIN_FILENO);
+    }
+    catch (std::runtime_error &expt)
+    {
+        std::cerr << expt.what() << std::endl;
+        return EXIT_FAILURE;
+    }
 
     std::ofstream time_info{"time.info"};
 
-    auto primitives_start = std::chrono::high_resolution_clock::now();
+    if (!options.snapshot.empty() && intersect_cached_shapes (options, scene, time_info))
+        return 0;
+
+    auto primitives_start = hr_clock::now();
     std::vector<point_type> points = construct_points ();
     std::vector<shape_type> shapes = construct_shapes (points.begin(), points.end());
-    auto primitives_finish = std::chrono::high_resolution_clock::now();
-
-    collision_manager collider {shapes.begin(), shapes.end()};
-    auto manager_finish = std::chrono::high_resolution_clock::now();
-
-    collider.intersect_all();
-    auto intersection_finish = std::chrono::high_resolution_clock::now();
-
-    collider.show_intersecting();
-    auto output_finish = std::chrono::high_resolution_clock::now();
+    auto primitives_finish = hr_clock::now();
 
     time_info << "Building of primitives            "
               << duration_cast<milliseconds>(primitives_finish - primitives_start).count()
-              << " ms" << std::endl
-              << "Construction of collision manager "
-              << duration_cast<milliseconds>(manager_finish - primitives_finish).count()
-              << " ms" << std::endl
-              << "Intersection                      "
-              << duration_cast<milliseconds>(intersection_finish - manager_finish).count()
-              << " ms" << std::endl
-              << "Output                            "
-              << duration_cast<milliseconds>(output_finish - intersection_finish).count()
               << " ms" << std::endl;
 
+    if (!options.snapshot.empty())
+        intersect_and_save_shapes (shapes, options, scene, time_info);
+    else if (options.engine == "sap")
+        intersect_shapes<sweep_and_prune> (shapes, options, time_info);
+    else if (options.engine == "bvh")
+        intersect_shapes<bvh> (shapes, options, time_info);
+    else if (options.engine == "grid")
+        intersect_shapes<uniform_grid> (shapes, options, time_info);
+    else if (options.engine == "loose")
+        intersect_shapes<loose_octree> (shapes, options, time_info);
+    else if (options.engine == "adaptive")
+        intersect_shapes<adaptive_octree> (shapes, options, time_info);
+    else if (options.engine == "linear")
+        intersect_shapes<linear_octree> (shapes, options, time_info);
+    else
+        intersect_shapes<octree> (shapes, options, time_info);
+
     return 0;
 }